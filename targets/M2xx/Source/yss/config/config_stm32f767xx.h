@@ -64,6 +64,9 @@
 // Depth of Touch Event Memory ( 32 ~ 256 )
 #define TOUCH_EVENT_MEMORY_DEPTH		128
 
+// Minimum interval of Touch Drag Event delivery (ms)
+#define TOUCH_EVENT_DRAG_INTERVAL		16
+
 // Frame Buffer of GUI Object (Rgb565, Rgb888, Argb1555)
 #define YSS_GUI_FRAME_BUFFER			Rgb888
 
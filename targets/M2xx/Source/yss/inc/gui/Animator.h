@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_ANIMATOR__H_
+#define YSS_GUI_ANIMATOR__H_
+
+#include "Object.h"
+#include "Color.h"
+
+class Frame;
+
+// 애니메이션의 진행률을 변환하는 곡선들이다.
+// 진행률과 반환 값은 Q15 고정 소수점(0 ~ ONE)이며 32비트 정수 연산만 사용한다.
+namespace ease
+{
+	enum
+	{
+		ONE = 0x8000
+	};
+
+	typedef uint32_t (*curve_t)(uint32_t t);
+
+	uint32_t linear(uint32_t t);
+
+	uint32_t inQuad(uint32_t t);
+
+	uint32_t outQuad(uint32_t t);
+
+	uint32_t inOutQuad(uint32_t t);
+
+	uint32_t inCubic(uint32_t t);
+
+	uint32_t outCubic(uint32_t t);
+
+	uint32_t inOutCubic(uint32_t t);
+}
+
+// GUI 객체의 위치, 크기, 색상을 시간에 따라 바꾸는 애니메이션 스케줄러이다.
+// process()가 runtime의 시간을 기준으로 설정된 FPS마다 모든 애니메이션을 한 번에 진행하며,
+// 그 동안 Frame의 갱신을 모아두었다가 바뀐 영역 전체를 한 번만 그려서 출력한다.
+class Animator
+{
+public :
+	// 색상 애니메이션에서 계산된 색상을 객체에 설정하는 함수이다.
+	// 객체의 색상을 설정하고 다시 그리는 것은 이 함수에서 처리해야 한다.
+	typedef void (*colorHandler_t)(Object &obj, Color color);
+
+	// uint16_t maxTween
+	//		동시에 진행할 수 있는 애니메이션의 최대 수를 설정한다.
+	Animator(uint16_t maxTween = 8);
+
+	~Animator(void);
+
+	// 애니메이션 할 객체들이 속한 Frame을 설정한다.
+	// 설정하면 한 프레임 동안의 갱신이 모아져 한 번에 출력된다.
+	void setFrame(Frame &frame);
+
+	// 초당 진행할 프레임의 수를 설정한다. (기본값 : 30)
+	void setFps(uint8_t fps);
+
+	// 객체를 현재 위치에서 목표 위치로 이동한다.
+	// 같은 객체의 같은 속성에 진행 중인 애니메이션이 있으면 현재 값에서 새로 시작한다.
+	//
+	// Object &obj
+	//		애니메이션 할 객체를 설정한다.
+	// Position_t to
+	//		목표 위치를 설정한다.
+	// uint16_t duration
+	//		애니메이션 시간(ms)을 설정한다.
+	// ease::curve_t curve
+	//		진행률 곡선을 설정한다.
+	//
+	// 반환
+	//		동시에 진행할 수 있는 애니메이션의 수를 넘으면 false를 반환한다.
+	bool moveTo(Object &obj, Position_t to, uint16_t duration, ease::curve_t curve = ease::outQuad);
+
+	// 객체를 현재 크기에서 목표 크기로 바꾼다.
+	bool resizeTo(Object &obj, Size_t to, uint16_t duration, ease::curve_t curve = ease::outQuad);
+
+	// from 색상에서 to 색상까지 바뀌는 색상을 프레임마다 handler로 설정한다.
+	//
+	// colorHandler_t handler
+	//		계산된 색상을 객체에 설정할 함수를 설정한다.
+	bool fadeColor(Object &obj, Color from, Color to, uint16_t duration, colorHandler_t handler, ease::curve_t curve = ease::linear);
+
+	// 객체의 모든 애니메이션을 현재 상태에서 멈춘다.
+	void stop(Object &obj);
+
+	// 진행 중인 애니메이션이 있는지 확인한다.
+	bool isRunning(void);
+
+	// 다음 프레임의 시간이 되었으면 모든 애니메이션을 한 프레임 진행한다.
+	// 사용자 쓰레드의 반복문에서 주기적으로 호출한다.
+	//
+	// 반환
+	//		진행 중인 애니메이션이 남아 있으면 true를 반환한다.
+	bool process(void);
+
+	// 모든 애니메이션이 끝날 때까지 프레임 주기마다 process()를 호출한다.
+	void run(void);
+
+private :
+	enum
+	{
+		PROPERTY_POSITION = 0,
+		PROPERTY_SIZE,
+		PROPERTY_COLOR
+	};
+
+	struct tween_t
+	{
+		Object *obj;
+		ease::curve_t curve;
+		colorHandler_t handler;
+		uint64_t start;
+		uint16_t duration;
+		uint8_t property;
+		int16_t from[4], to[4];
+	};
+
+	tween_t *mTween;
+	Frame *mFrame;
+	uint64_t mNextFrame;
+	uint16_t mNumOfTween, mMaxTween, mInterval;
+
+	tween_t* allocate(Object &obj, uint8_t property, uint16_t duration, ease::curve_t curve);
+
+	void apply(tween_t &tween, uint32_t progress);
+};
+
+#endif
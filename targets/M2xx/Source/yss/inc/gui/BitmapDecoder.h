@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_BITMAP_DECODER__H_
+#define YSS_GUI_BITMAP_DECODER__H_
+
+#include <stdint.h>
+
+// 압축된 비트맵(Bitmap_t, BitmapFile_t)의 데이터를 앞에서부터 차례로 풀어내는 디코더이다.
+// 풀어낸 점은 압축하기 전의 RGB565 비트맵(type 0)과 같은 바이트 값이 되므로 그대로 LCD로 보내거나
+// blit::convertLine()으로 프레임 버퍼 형식에 맞게 변환할 수 있다.
+// 전체 이미지를 위한 버퍼 없이 한 줄 또는 일정 점의 수 단위로 풀어서 사용한다.
+//
+// TYPE_RLE565 : RGB565 점을 아래의 토큰으로 압축, 줄의 경계와 관계없이 이어짐
+//		1nnnnnnn, 2바이트 점 : 같은 점이 n+1개 반복
+//		0nnnnnnn, 2바이트 점 n+1개 : 압축되지 않은 점 n+1개
+// TYPE_INDEX8 : 팔레트 크기-1 (1바이트), RGB565 팔레트, 점당 1바이트의 팔레트 번호
+// TYPE_INDEX4 : 팔레트 크기-1 (1바이트), RGB565 팔레트(최대 16개), 점당 4비트의 팔레트 번호
+//		한 바이트에 두 점 (하위 니블 먼저), 한 줄은 바이트 단위로 정렬
+// TYPE_INDEX2 : TYPE_INDEX4와 같으며 팔레트는 최대 4개, 한 바이트에 네 점 (하위 비트 먼저)
+// TYPE_INDEX1 : TYPE_INDEX4와 같으며 팔레트는 최대 2개, 한 바이트에 여덟 점 (하위 비트 먼저)
+// 팔레트 방식의 프레임 버퍼(IndexBuffer)는 이 형식으로 저장되므로 그대로 LCD로 보낼 수 있다.
+class BitmapDecoder
+{
+public :
+	enum
+	{
+		TYPE_RGB565 = 0,
+		TYPE_RGB888,
+		TYPE_ARGB1555,
+		TYPE_RLE565,
+		TYPE_INDEX8,
+		TYPE_INDEX4,
+		TYPE_INDEX2,
+		TYPE_INDEX1,
+	};
+
+	// 디코더가 처리하는 압축된 형식인지 확인한다.
+	//
+	// 반환
+	//		압축된 형식이면 true를 반환한다.
+	static bool isCompressed(uint8_t type);
+
+	// 디코딩을 시작한다.
+	//
+	// uint16_t width
+	//		비트맵의 폭을 설정한다.
+	// uint8_t type
+	//		비트맵의 형식을 설정한다. (TYPE_RLE565, TYPE_INDEX8, TYPE_INDEX4, TYPE_INDEX2, TYPE_INDEX1)
+	// const uint8_t *data
+	//		비트맵의 데이터 주소를 설정한다.
+	void begin(uint16_t width, uint8_t type, const uint8_t *data);
+
+	// 다음 점들을 RGB565로 풀어낸다.
+	//
+	// void *des
+	//		풀어낸 점을 저장할 주소를 설정한다. count * 2 바이트가 필요하다.
+	// uint32_t count
+	//		풀어낼 점의 수를 설정한다.
+	void read(void *des, uint32_t count);
+
+	// 팔레트 형식(TYPE_INDEXn)의 다음 점들을 색상으로 풀지 않고 팔레트 번호로 읽는다.
+	//
+	// uint8_t *des
+	//		팔레트 번호를 저장할 주소를 설정한다. count 바이트가 필요하다.
+	// uint32_t count
+	//		읽을 점의 수를 설정한다.
+	void readIndex(uint8_t *des, uint32_t count);
+
+	// 다음 점들을 풀지 않고 건너뛴다.
+	//
+	// uint32_t count
+	//		건너뛸 점의 수를 설정한다.
+	void skip(uint32_t count);
+
+private :
+	const uint8_t *mData, *mPalette;
+	uint16_t mWidth, mX;
+	uint8_t mType, mRemain, mDot[2], mBit, mMask;
+	bool mRunFlag;
+
+	void fetchToken(void);
+};
+
+#endif
+
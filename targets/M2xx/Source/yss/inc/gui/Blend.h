@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_BLEND__H_
+#define YSS_GUI_BLEND__H_
+
+#include <stdint.h>
+
+// Dma2d가 없는 MCU에서 프레임 버퍼의 한 줄에 알파 합성을 하기 위한 소프트웨어 함수들이다.
+// RGB565와 ARGB1555는 32비트 워드 하나에 두 점을 읽어 색상 성분 사이에 여유 비트를 두는 방식(SWAR)으로 합성한다.
+// 색상 코드와 대상의 형식은 Brush가 사용하는 형식(Color::getRgb565Code() 등)과 같다.
+// R과 B의 위치는 구분하지 않으며, 상위와 하위 바이트가 바뀐 형식이면 swap을 true로 설정한다.
+// 알파 값은 0(투명) ~ 255(불투명), A4 마스크는 점당 4비트(0 ~ 15, 하위 니블 먼저)이다.
+namespace blend
+{
+	// 한 줄의 점들에 고정 색상을 고정 알파 값으로 합성한다.
+	//
+	// uint16_t *des
+	//		합성될 대상의 주소를 설정한다. 2바이트 정렬이 되어 있어야 한다.
+	// uint16_t color
+	//		합성할 색상 코드를 설정한다.
+	// uint8_t alpha
+	//		합성할 알파 값을 설정한다.
+	// uint32_t count
+	//		합성할 점의 수를 설정한다.
+	// bool swap
+	//		색상 코드의 상위와 하위 바이트가 바뀌어 있으면 true를 설정한다.
+	void blendColorRgb565(uint16_t *des, uint16_t color, uint8_t alpha, uint32_t count, bool swap = false);
+
+	// 한 줄의 점들에 원본 줄의 점들을 점마다 다른 알파 값으로 합성한다.
+	//
+	// const uint16_t *src
+	//		합성할 원본의 주소를 설정한다.
+	// const uint8_t *alpha
+	//		점마다 하나씩 있는 알파 값 배열의 주소를 설정한다.
+	void blendLineRgb565(uint16_t *des, const uint16_t *src, const uint8_t *alpha, uint32_t count, bool swap = false);
+
+	// 한 줄의 점들에 고정 색상을 A4 마스크의 농도로 합성한다. 안티 앨리어싱 문자를 그릴 때 사용한다.
+	//
+	// const uint8_t *mask
+	//		한 바이트에 두 점의 농도가 들어있는 마스크의 주소를 설정한다.
+	void blendMaskRgb565(uint16_t *des, uint16_t color, const uint8_t *mask, uint32_t count, bool swap = false);
+
+	// ARGB1555 형식이다. 합성된 점의 알파 비트는 1이 된다.
+	void blendColorArgb1555(uint16_t *des, uint16_t color, uint8_t alpha, uint32_t count, bool swap = false);
+
+	void blendLineArgb1555(uint16_t *des, const uint16_t *src, const uint8_t *alpha, uint32_t count, bool swap = false);
+
+	void blendMaskArgb1555(uint16_t *des, uint16_t color, const uint8_t *mask, uint32_t count, bool swap = false);
+
+	// RGB888 형식이다. 대상과 원본은 점당 3바이트이며 색상 코드는 Color::getRgb888Code()의 형식이다.
+	void blendColorRgb888(uint8_t *des, uint32_t color, uint8_t alpha, uint32_t count);
+
+	void blendLineRgb888(uint8_t *des, const uint8_t *src, const uint8_t *alpha, uint32_t count);
+
+	void blendMaskRgb888(uint8_t *des, uint32_t color, const uint8_t *mask, uint32_t count);
+}
+
+#endif
+
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_BLIT__H_
+#define YSS_GUI_BLIT__H_
+
+#include <stdint.h>
+
+// Dma2d가 없는 MCU에서 비트맵을 그리기 위한 한 줄 단위의 소프트웨어 복사 함수들이다.
+// RGB565, ARGB1555 점은 원본과 대상 모두 Color::getRgb565Code(), getArgb1555Code()와 같은 형식이다.
+// Color::setReverseRgbOrder(), setLittleEndian()의 설정에 따라 R과 B의 위치와 바이트 순서가 정해진다.
+// 16비트 비트맵은 bmpc의 -r, -s 옵션으로 같은 형식으로 만들어 두어야 한다.
+// RGB888 : 메모리에 B, G, R 순서로 3바이트
+// 팔레트 방식(COLOR_MODE_INDEXn)의 대상은 지원하지 않는다. Brush는 점 단위로 가장 가까운 팔레트 번호를 찾아 그린다.
+namespace blit
+{
+	// 한 줄을 복사한다. 주소 정렬이 맞으면 4바이트 단위로 복사한다.
+	//
+	// void *des
+	//		복사될 대상의 주소를 설정한다.
+	// const void *src
+	//		복사할 원본의 주소를 설정한다.
+	// uint32_t size
+	//		복사할 크기(바이트)를 설정한다.
+	void copyLine(void *des, const void *src, uint32_t size);
+
+	// 비트맵 한 줄을 대상 프레임 버퍼의 형식으로 변환하며 복사한다.
+	// ARGB1555 원본의 알파 비트가 0인 점은 그리지 않는다.
+	//
+	// void *des
+	//		복사될 대상의 주소를 설정한다.
+	// uint8_t desColorMode
+	//		대상의 형식을 설정한다. (FrameBuffer::COLOR_MODE_RGB888, RGB565, ARGB1555)
+	// const void *src
+	//		복사할 원본의 주소를 설정한다.
+	// uint8_t srcType
+	//		원본의 형식을 설정한다. (Bitmap_t::type, 0 : RGB565, 1 : RGB888, 2 : ARGB1555)
+	// uint16_t count
+	//		복사할 점의 수를 설정한다.
+	//
+	// 반환
+	//		지원하지 않는 원본 또는 대상의 형식일 경우 아무것도 하지 않고 false를 반환한다.
+	bool convertLine(void *des, uint8_t desColorMode, const void *src, uint8_t srcType, uint16_t count);
+
+	// convertLine()과 동일하지만 원본의 값이 colorKey와 같은 점은 그리지 않는다.
+	//
+	// uint32_t colorKey
+	//		투명하게 처리할 원본 형식의 색상 코드를 설정한다.
+	bool convertLineWithColorKey(void *des, uint8_t desColorMode, const void *src, uint8_t srcType, uint16_t count, uint32_t colorKey);
+
+	// 원본 형식의 점 하나를 대상 형식의 색상 코드로 변환한다.
+	//
+	// 반환
+	//		대상 형식의 색상 코드를 반환한다. 지원하지 않는 형식일 경우 0을 반환한다.
+	uint32_t convertDot(uint8_t desColorMode, const void *src, uint8_t srcType);
+
+	// 원본 형식의 점 하나의 크기(바이트)를 얻는다. 지원하지 않는 형식일 경우 0을 반환한다.
+	uint8_t getSourceDotSize(uint8_t srcType);
+}
+
+#endif
+
@@ -11,6 +11,8 @@
 #include "Color.h"
 #include "Font.h"
 #include "FrameBuffer.h"
+#include "GlyphCache.h"
+#include "TextLayout.h"
 #include <config.h>
 
 #if USE_GUI && YSS_L_HEAP_USE
@@ -117,8 +119,64 @@ public:
 
 	virtual uint8_t drawChar(Position_t pos, uint32_t utf8);
 
+	// drawChar()에서 사용할 문자 이미지 캐시를 설정한다.
+	// 프레임 버퍼 메모리가 있는 브러쉬에서만 사용되며, 0을 설정하면 캐시를 사용하지 않는다.
+	// 같은 캐시를 여러 브러쉬가 공유할 수 있다.
+	//
+	// GlyphCache *cache
+	//		사용할 캐시를 설정한다.
+	void setGlyphCache(GlyphCache *cache);
+
+	// drawString()과 calculateStringSize()에서 사용할 문자열 배치 캐시를 설정한다.
+	// 같은 문자열은 UTF-8 해석과 문자 폭 계산을 다시 하지 않는다. 0을 설정하면 캐시를 사용하지 않는다.
+	//
+	// TextLayout *layout
+	//		사용할 캐시를 설정한다.
+	void setTextLayout(TextLayout *layout);
+
+	// drawChar()에서 문자를 배경색 대신 프레임 버퍼에 이미 그려진 내용 위에 알파 합성하도록 설정한다.
+	// 프레임 버퍼 메모리가 있는 브러쉬와 팔레트 방식의 브러쉬에서 사용되며, 합성 중에는 문자 이미지 캐시를 사용하지 않는다.
+	// 팔레트 방식은 그려진 점의 색상과 합성한 색상에서 가장 가까운 팔레트 번호로 그린다.
+	//
+	// bool en
+	//		알파 합성을 사용하려면 true, 배경색으로 그리려면 false를 설정한다.
+	void enableFontBlending(bool en = true);
+
+	// 직사각형 영역에 반투명한 색상을 합성한다.
+	// 프레임 버퍼 메모리가 없는 브러쉬와 팔레트 방식의 브러쉬는 배경색과 합성한 색상으로 채운다.
+	//
+	// Position_t pos
+	//		사각형의 시작 좌표를 설정한다.
+	// Size_t size
+	//		사각형의 크기를 설정한다.
+	// Color color
+	//		합성할 색상을 설정한다.
+	// uint8_t alpha
+	//		합성할 알파 값(0 ~ 255)을 설정한다.
+	void blendRect(Position_t pos, Size_t size, Color color, uint8_t alpha);
+
 	virtual void drawBitmapBase(Position_t pos, const Bitmap_t &bitmap);
 
+	// 비트맵을 그릴 때 사용할 컬러키를 설정한다.
+	// 비트맵의 점 중에 컬러키와 같은 값을 갖는 점은 그리지 않는다.
+	//
+	// uint32_t code
+	//		비트맵 형식(RGB565, RGB888, ARGB1555)의 색상 코드를 설정한다.
+	void setColorKey(uint32_t code);
+
+	// 비트맵을 그릴 때 컬러키의 사용 여부를 설정한다.
+	//
+	// bool en
+	//		컬러키를 사용하려면 true, 사용하지 않으려면 false를 설정한다.
+	void enableColorKey(bool en = true);
+
+	// RGB888 비트맵을 RGB565 프레임 버퍼에 그릴 때 4x4 순차 디더링의 사용 여부를 설정한다.
+	// 컬러키를 사용하지 않고 프레임 버퍼 메모리가 있는 브러쉬에서만 적용된다.
+	//
+	// bool en
+	//		디더링을 사용하려면 true, 하위 비트를 버리려면 false를 설정한다.
+	void enableDithering(bool en = true);
+
 	void drawBitmap(Position_t pos, const Bitmap_t &bitmap);
 
 	void drawBitmap(Position_t pos, const Bitmap_t *bitmap);
@@ -165,10 +223,40 @@ public:
 #endif
 
 protected:
+	enum
+	{
+		COMPRESSED_BITMAP_BAND = 64,	// 압축된 비트맵을 한 번에 풀어내는 점의 수
+	};
+
 	Font *mFont;
 	Color mFontColor, mBgColor;
 	uint32_t mBgColorCode, mBrushColorCode;
 	uint32_t mFontColorCodeTable[16];
+	GlyphCache *mGlyphCache;
+	TextLayout *mTextLayout;
+	uint32_t mColorKey;
+	bool mColorKeyFlag, mFontBlendFlag, mDitherFlag;
+
+	void drawBitmapData(Position_t pos, uint16_t width, uint16_t height, uint8_t type, const uint8_t *data);
+
+	void drawCompressedBitmapData(Position_t pos, uint16_t width, uint16_t height, uint8_t type, const uint8_t *data);
+
+	// 팔레트 방식에서 색상표의 가장 가까운 색상 번호를 얻는다. 색상표가 없으면 0을 반환한다.
+	uint32_t findPaletteIndex(Color color);
+
+	// 팔레트 방식에서 그려진 점의 팔레트 번호를 얻는다. 문자를 그려진 내용 위에 합성할 때 사용한다.
+	// 한 줄이 바이트 단위로 정렬된 프레임 버퍼 메모리에서 읽으며 메모리가 없으면 배경색의 번호를 반환한다.
+	// 자체 메모리에 팔레트 번호를 저장하는 브러쉬는 재정의해야 한다.
+	virtual uint8_t getIndexedDot(int16_t x, int16_t y);
+
+	// 비트맵 형식의 점 하나를 브러쉬의 색상 코드로 변환한다.
+	uint32_t convertDot(const uint8_t *src, uint8_t type);
+
+	GlyphCache::glyph_t* cacheChar(uint32_t utf8);
+
+	void drawCachedChar(Position_t pos, GlyphCache::glyph_t *glyph);
+
+	uint8_t drawBlendedChar(Position_t pos, uint32_t utf8);
 
 	void translateFromPositionToSize(Position_t &desPos, Size_t &desSize, Position_t &srcPos1, Position_t &srcPos2);
 };
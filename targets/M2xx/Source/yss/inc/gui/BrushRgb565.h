@@ -8,25 +8,16 @@
 #ifndef YSS_GUI_BRUSH_RGB565__H_
 #define YSS_GUI_BRUSH_RGB565__H_
 
-#include "Brush.h"
+#include "BrushT.h"
 #include "Color.h"
 #include "Font.h"
 
-class BrushRgb565 : public Brush
+class BrushRgb565 : public BrushT<pixel::Rgb565>
 {
 public:
 	BrushRgb565(void);
 
 	~BrushRgb565(void);
-
-	// Brush
-	virtual void drawDot(int16_t x, int16_t y);
-	
-	virtual void drawDot(int16_t x, int16_t y, Color color);
-
-	virtual void drawDot(int16_t x, int16_t y, uint32_t color);
-
-	virtual void fillRectBase(Position_t pos, Size_t size, uint32_t color);
 };
 
 #endif
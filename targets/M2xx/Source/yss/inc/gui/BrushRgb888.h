@@ -8,25 +8,16 @@
 #ifndef YSS_GUI_BRUSH_RGB888__H_
 #define YSS_GUI_BRUSH_RGB888__H_
 
-#include "Brush.h"
+#include "BrushT.h"
 #include "Color.h"
 #include "Font.h"
 
-class BrushRgb888 : public Brush
+class BrushRgb888 : public BrushT<pixel::Rgb888>
 {
 public:
 	BrushRgb888(void);
 
 	~BrushRgb888(void);
-
-	// Brush
-	virtual void drawDot(int16_t x, int16_t y);
-	
-	virtual void drawDot(int16_t x, int16_t y, Color color);
-
-	virtual void drawDot(int16_t x, int16_t y, uint32_t color);
-
-	virtual void fillRectBase(Position_t pos, Size_t size, uint32_t color);
 };
 
 #endif
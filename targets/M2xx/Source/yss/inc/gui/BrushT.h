@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_BRUSH_T__H_
+#define YSS_GUI_BRUSH_T__H_
+
+#include "Brush.h"
+#include "Fill.h"
+
+// BrushT에서 사용하는 픽셀 형식들이다.
+// 색상 코드의 변환, 점의 크기, 점을 쓰는 방법이 모두 컴파일 시간에 결정되므로 그리기 루프 안에서 인라인 된다.
+// 채우기는 Fill.h의 함수들로 처리한다.
+namespace pixel
+{
+	struct Rgb565
+	{
+		enum
+		{
+			COLOR_MODE = FrameBuffer::COLOR_MODE_RGB565,
+			DOT_SIZE = 2,
+		};
+
+		static inline uint32_t getCode(Color color)
+		{
+			return color.getRgb565Code();
+		}
+
+		static inline void setDot(uint8_t *des, uint32_t color)
+		{
+			*(uint16_t*)des = color;
+		}
+
+		static inline void fill(uint8_t *des, uint32_t color, uint32_t count)
+		{
+			fill::dot16(des, color, count);
+		}
+
+		static inline void fillRect(uint8_t *des, uint32_t stride, uint16_t width, uint16_t height, uint32_t color)
+		{
+			fill::rect16(des, stride, width, height, color);
+		}
+	};
+
+	struct Argb1555
+	{
+		enum
+		{
+			COLOR_MODE = FrameBuffer::COLOR_MODE_ARGB1555,
+			DOT_SIZE = 2,
+		};
+
+		static inline uint32_t getCode(Color color)
+		{
+			return color.getArgb1555Code();
+		}
+
+		static inline void setDot(uint8_t *des, uint32_t color)
+		{
+			*(uint16_t*)des = color;
+		}
+
+		static inline void fill(uint8_t *des, uint32_t color, uint32_t count)
+		{
+			fill::dot16(des, color, count);
+		}
+
+		static inline void fillRect(uint8_t *des, uint32_t stride, uint16_t width, uint16_t height, uint32_t color)
+		{
+			fill::rect16(des, stride, width, height, color);
+		}
+	};
+
+	struct Rgb888
+	{
+		enum
+		{
+			COLOR_MODE = FrameBuffer::COLOR_MODE_RGB888,
+			DOT_SIZE = 3,
+		};
+
+		static inline uint32_t getCode(Color color)
+		{
+			return color.getRgb888Code();
+		}
+
+		static inline void setDot(uint8_t *des, uint32_t color)
+		{
+			des[0] = color;
+			des[1] = color >> 8;
+			des[2] = color >> 16;
+		}
+
+		static inline void fill(uint8_t *des, uint32_t color, uint32_t count)
+		{
+			fill::dot24(des, color, count);
+		}
+
+		static inline void fillRect(uint8_t *des, uint32_t stride, uint16_t width, uint16_t height, uint32_t color)
+		{
+			fill::rect24(des, stride, width, height, color);
+		}
+	};
+}
+
+// 프레임 버퍼 메모리에 직접 그리는 브러쉬의 템플릿이다.
+// Format에는 pixel 이름 공간의 픽셀 형식을 설정한다.
+// 점 찍기, 사각형 채우기, 문자 그리기를 가상 함수 호출 없이 형식에 맞는 코드로 처리하며
+// Brush의 가상 함수들도 구현하므로 기존의 Brush를 사용하는 코드에서 그대로 사용할 수 있다.
+template <class Format>
+class BrushT : public Brush
+{
+public :
+	BrushT(void)
+	{
+		enableMemoryAlloc(false);
+		setColorMode(Format::COLOR_MODE);
+	}
+
+	// 점을 찍는다. 좌표의 범위를 확인하지 않는다.
+	//
+	// int16_t x, int16_t y
+	//		점의 좌표를 설정한다.
+	// uint32_t color
+	//		Format 형식의 색상 코드를 설정한다.
+	inline void setDot(int16_t x, int16_t y, uint32_t color)
+	{
+		Format::setDot(&mFrameBuffer[(y * mSize.width + x) * Format::DOT_SIZE], color);
+	}
+
+	// Brush
+	virtual void drawDot(int16_t x, int16_t y)
+	{
+		setDot(x, y, mBrushColorCode);
+	}
+
+	virtual void drawDot(int16_t x, int16_t y, Color color)
+	{
+		setDot(x, y, Format::getCode(color));
+	}
+
+	virtual void drawDot(int16_t x, int16_t y, uint32_t color)
+	{
+		setDot(x, y, color);
+	}
+
+	virtual void fillRectBase(Position_t pos, Size_t size, uint32_t color)
+	{
+		int32_t sx = pos.x, ex = pos.x + size.width, sy = pos.y, ey = pos.y + size.height;
+		uint8_t *des;
+
+		if (sx < 0)
+			sx = 0;
+		if (sy < 0)
+			sy = 0;
+		if (ex > mSize.width)
+			ex = mSize.width;
+		if (ey > mSize.height)
+			ey = mSize.height;
+		if (sx >= ex || sy >= ey)
+			return;
+
+		des = &mFrameBuffer[(sy * mSize.width + sx) * Format::DOT_SIZE];
+
+		// 폭 전체를 채우면 fillRect()에서 한 번에 채움
+		Format::fillRect(des, mSize.width * Format::DOT_SIZE, ex - sx, ey - sy, color);
+	}
+
+	virtual uint8_t drawChar(Position_t pos, uint32_t utf8)
+	{
+		if (mFont == 0)
+			return 0;
+
+		// 합성과 캐시, 그리고 drawDot()으로 LCD에 직접 그리는 하위 클래스는 Brush에서 처리
+		if (mFontBlendFlag || mGlyphCache || mFrameBuffer == 0)
+			return Brush::drawChar(pos, utf8);
+
+		Font::fontInfo_t *fontInfo = mFont->getFontInfo(utf8);
+		Font::Decoder decoder;
+		int32_t xoffset, xs, ys, stride, left = 0, right, top = 0, bottom;
+		uint8_t *des;
+
+		if (fontInfo == 0)
+			return 0;
+
+		xoffset = (int8_t)fontInfo->xpos;
+		if (xoffset == 0) // 문자의 앞 여백이 없을 경우
+			xoffset = 1; // 문자의 앞 여백 하나를 추가해줌
+
+		xs = pos.x + xoffset;
+		ys = pos.y + (int8_t)fontInfo->ypos;
+		stride = mFont->getDataStride(fontInfo->width);
+		right = stride;
+		bottom = fontInfo->height;
+
+		// 프레임 버퍼 밖의 부분은 데이터만 건너뜀
+		if (xs < 0)
+			left = -xs;
+		if (ys < 0)
+			top = -ys;
+		if (xs + right > mSize.width)
+			right = mSize.width - xs;
+		if (ys + bottom > mSize.height)
+			bottom = mSize.height - ys;
+		if (left >= right || top >= bottom)
+			return fontInfo->width + xoffset;
+
+		decoder.begin(fontInfo->data, mFont->getDataFormat());
+		if (top)
+			decoder.skip(top * stride);
+
+		des = &mFrameBuffer[((ys + top) * mSize.width + xs + left) * Format::DOT_SIZE];
+
+		for (int32_t y = top; y < bottom; y++)
+		{
+			uint8_t *dot = des;
+
+			if (left)
+				decoder.skip(left);
+
+			for (int32_t x = left; x < right; x++)
+			{
+				Format::setDot(dot, mFontColorCodeTable[decoder.getLevel()]);
+				dot += Format::DOT_SIZE;
+			}
+
+			if (right < stride)
+				decoder.skip(stride - right);
+
+			des += mSize.width * Format::DOT_SIZE;
+		}
+
+		return fontInfo->width + xoffset;
+	}
+};
+
+#endif
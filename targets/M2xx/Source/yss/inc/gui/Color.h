@@ -41,6 +41,18 @@ public :
 
 	void setLittleEndian(bool reverse);
 
+	// 16비트 색상 코드에서 R이 상위 비트에 있는지 확인한다.
+	//
+	// 반환
+	//		R이 상위 비트에 있으면 true, B가 상위 비트에 있으면 false를 반환한다.
+	static bool getReverseRgbOrder(void);
+
+	// 16비트 색상 코드가 CPU와 같은 바이트 순서(리틀 엔디안)로 만들어지는지 확인한다.
+	//
+	// 반환
+	//		리틀 엔디안이면 true, 상위와 하위 바이트가 바뀐 형식이면 false를 반환한다.
+	static bool getLittleEndian(void);
+
 	Color calculateFontColorLevel(Color &bgColor, uint8_t level);
 
 	uint16_t getRgb565Code(void);
@@ -39,10 +39,61 @@ class Container : public Object
 
 	Object *handlerUp(void);
 
+	// 자식 객체의 위치나 크기가 바뀌었을 때 공간 인덱스를 갱신한다.
+	// Object::setPosition()과 Object::setSize()에서 호출된다.
+	//
+	// Object &obj
+	//		위치나 크기가 바뀐 자식 객체를 설정한다.
+	// Position_t beforePos
+	//		바뀌기 전의 위치를 설정한다.
+	// Size_t beforeSize
+	//		바뀌기 전의 크기를 설정한다.
+	void relocate(Object &obj, Position_t beforePos, Size_t beforeSize);
+
   protected:
+	// 자식 객체의 검색을 위해 Container의 영역을 INDEX_GRID x INDEX_GRID개의 칸으로 나누고
+	// 칸마다 그 칸에 걸친 객체의 번호를 mObjArr의 순서(아래에서 위)대로 저장한다.
+	enum
+	{
+		INDEX_GRID = 8,
+		INDEX_GROW = 8,
+	};
+
+	struct Cell
+	{
+		uint16_t *index;
+		uint16_t num, max;
+	};
+
 	uint16_t mNumOfObj, mMaxObj;
 	Object **mObjArr, *mLastEventObj;
+	uint16_t *mQueryBuf;
+	Cell mCell[INDEX_GRID * INDEX_GRID];
+	Size_t mCellSize;
 	bool mValidFlag;
+
+	void eventSizeChanged(Size_t size);
+
+	// 영역을 배경색으로 지우고 영역에 걸친 자식 객체들을 그린다.
+	// 불투명한 객체에 완전히 가려진 객체는 그리지 않는다.
+	void drawArea(Position_t pos, Size_t size);
+
+	// 공간 인덱스를 현재 크기에 맞춰 다시 만든다.
+	void resetIndex(void);
+
+	bool getCellRange(Position_t pos, Size_t size, uint8_t *range);
+
+	void addIndex(uint16_t index, Position_t pos, Size_t size);
+
+	void removeIndex(uint16_t index, Position_t pos, Size_t size);
+
+	// 영역에 걸친 객체들의 번호를 아래에서 위의 순서로 mQueryBuf에 얻는다.
+	//
+	// 반환
+	//		얻은 객체의 수를 반환한다.
+	uint16_t query(Position_t pos, Size_t size);
+
+	Object *findObject(Position_t pos);
 };
 
 #endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_CONVERT__H_
+#define YSS_GUI_CONVERT__H_
+
+#include <stdint.h>
+
+// 한 줄의 점들을 다른 점의 형식으로 변환하는 함수들이다.
+// 점의 형식은 Blit.h와 같으며, 주소 정렬이 맞으면 32비트 워드 하나에 두 점(RGB888은 세 워드에 네 점)씩 처리한다.
+// 원본과 대상의 크기가 같은 변환은 원본과 대상을 같은 주소로 설정하여 그 자리에서 변환할 수 있다.
+namespace convert
+{
+	// RGB888 원본을 RGB565로 변환한다. 각 성분의 하위 비트는 버린다.
+	//
+	// uint16_t *des
+	//		변환된 점들을 저장할 주소를 설정한다. 2바이트 정렬이 되어 있어야 한다.
+	// const uint8_t *src
+	//		변환할 원본의 주소를 설정한다.
+	// uint32_t count
+	//		변환할 점의 수를 설정한다.
+	void rgb888ToRgb565(uint16_t *des, const uint8_t *src, uint32_t count);
+
+	// rgb888ToRgb565()와 같지만 4x4 순차 디더링(Bayer)을 적용하여 그라데이션의 계단 현상을 줄인다.
+	//
+	// uint16_t x, uint16_t y
+	//		첫 점의 화면상 좌표를 설정한다. 디더링 패턴이 화면에 고정되도록 하기 위해 사용한다.
+	void rgb888ToRgb565Dither(uint16_t *des, const uint8_t *src, uint32_t count, uint16_t x, uint16_t y);
+
+	// RGB565 원본을 RGB888로 변환한다. 각 성분의 상위 비트를 하위 비트에 반복해서 채운다.
+	void rgb565ToRgb888(uint8_t *des, const uint16_t *src, uint32_t count);
+
+	// RGB565 원본을 ARGB1555로 변환한다. 알파 비트는 1이 된다.
+	void rgb565ToArgb1555(uint16_t *des, const uint16_t *src, uint32_t count);
+
+	// ARGB1555 원본을 RGB565로 변환한다. 알파 비트는 무시한다.
+	void argb1555ToRgb565(uint16_t *des, const uint16_t *src, uint32_t count);
+
+	// RGB565 점들의 R과 B의 위치 또는 상위와 하위 바이트를 바꾼다.
+	// TftLcdDriver::getReverseRgbOrder(), getReverseEndian()의 값을 그대로 설정하여 LCD의 형식으로 맞출 때 사용한다.
+	//
+	// bool reverseRgb
+	//		R과 B의 위치를 바꾸려면 true를 설정한다.
+	// bool reverseEndian
+	//		상위와 하위 바이트를 바꾸려면 true를 설정한다.
+	void reorderRgb565(uint16_t *des, const uint16_t *src, uint32_t count, bool reverseRgb, bool reverseEndian);
+
+	// RGB888 점들의 R과 B의 위치를 바꾼다.
+	void reorderRgb888(uint8_t *des, const uint8_t *src, uint32_t count);
+}
+
+#endif
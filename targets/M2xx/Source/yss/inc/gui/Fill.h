@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_FILL__H_
+#define YSS_GUI_FILL__H_
+
+#include <stdint.h>
+
+// 프레임 버퍼 메모리를 한 색상 또는 반복 패턴으로 채우는 함수들이다.
+// 주소를 4바이트로 정렬한 후 copyWordPattern(), copyRgb888DotPattern()으로 stmia 한 번에 여러 점씩 저장한다.
+// 채울 워드의 수가 FILL_DMA_THRESHOLD 이상인 한 색상 채우기는 DMA로 처리하며 전송 중에 다른 쓰레드가 실행된다.
+// 점의 형식은 Blit.h와 같다.
+namespace fill
+{
+	// RGB565 또는 ARGB1555 점들을 한 색상으로 채운다.
+	//
+	// void *des
+	//		채울 주소를 설정한다. 2바이트 정렬이 되어 있어야 한다.
+	// uint16_t color
+	//		채울 색상 코드를 설정한다.
+	// uint32_t count
+	//		채울 점의 수를 설정한다.
+	void dot16(void *des, uint16_t color, uint32_t count);
+
+	// RGB888 점들을 한 색상으로 채운다.
+	//
+	// uint32_t color
+	//		채울 색상 코드를 설정한다. 하위 24비트를 사용한다.
+	void dot24(void *des, uint32_t color, uint32_t count);
+
+	// RGB565 또는 ARGB1555 점들을 네 점의 패턴으로 반복해서 채운다.
+	// 두 점의 패턴은 {a, b, a, b}로 설정한다.
+	//
+	// const uint16_t *pattern
+	//		네 점의 패턴을 설정한다. des의 첫 점은 pattern[0]이 된다.
+	void pattern16(void *des, const uint16_t *pattern, uint32_t count);
+
+	// RGB565 또는 ARGB1555 사각형 영역을 한 색상으로 채운다.
+	// 줄 간격이 폭과 같으면 한 번에 채운다.
+	//
+	// void *des
+	//		사각형의 왼쪽 위 점의 주소를 설정한다.
+	// uint32_t stride
+	//		한 줄의 바이트 수를 설정한다.
+	// uint16_t width, uint16_t height
+	//		사각형의 크기를 설정한다.
+	void rect16(void *des, uint32_t stride, uint16_t width, uint16_t height, uint16_t color);
+
+	// RGB888 사각형 영역을 한 색상으로 채운다.
+	void rect24(void *des, uint32_t stride, uint16_t width, uint16_t height, uint32_t color);
+
+	// RGB565 또는 ARGB1555 사각형 영역을 4x4 패턴으로 채운다.
+	// 망점(stipple), 체크 무늬 등 비활성화 표시에 사용한다.
+	//
+	// const uint16_t *pattern
+	//		네 줄의 네 점씩 16개 점의 패턴을 설정한다. 사각형의 왼쪽 위 점은 pattern[0]이 된다.
+	void patternRect16(void *des, uint32_t stride, uint16_t width, uint16_t height, const uint16_t *pattern);
+}
+
+#endif
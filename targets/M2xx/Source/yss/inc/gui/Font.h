@@ -27,6 +27,105 @@ public:
 		uint8_t *data;
 	} __attribute__((packed));
 
+	// fontInfo_t::data에 저장된 글꼴 데이터의 형식이다.
+	// DATA_FORMAT_A4 : 한 점당 4비트, 한 바이트에 두 점 (하위 니블 먼저), 한 줄은 2점 단위로 정렬
+	// DATA_FORMAT_A2 : 한 점당 2비트, 한 바이트에 네 점 (하위 비트 먼저), 한 줄은 4점 단위로 정렬
+	// DATA_FORMAT_A1 : 한 점당 1비트, 한 바이트에 여덟 점 (하위 비트 먼저), 한 줄은 8점 단위로 정렬
+	// DATA_FORMAT_RLE : 한 줄은 2점 단위로 정렬, 아래의 토큰으로 구성
+	//		0b00nnnnnn : 농도 0인 점 n + 1개 (1 ~ 64)
+	//		0b01nnnnnn : 농도 15인 점 n + 1개 (1 ~ 64)
+	//		0b1nnnnnnn : 이어지는 n + 1개 (1 ~ 128) 점의 농도가 한 바이트에 두 점씩(하위 니블 먼저) 저장됨
+	enum
+	{
+		DATA_FORMAT_A4 = 0,
+		DATA_FORMAT_A2,
+		DATA_FORMAT_A1,
+		DATA_FORMAT_RLE,
+	};
+
+	// 글꼴 데이터를 앞에서부터 순서대로 한 점씩 풀어내는 디코더이다.
+	// 모든 형식의 데이터를 0 ~ 15 단계의 농도로 변환해서 돌려준다.
+	class Decoder
+	{
+	public :
+		// 디코딩을 시작할 데이터와 데이터의 형식을 설정한다.
+		//
+		// const uint8_t *data
+		//		fontInfo_t::data의 주소를 설정한다.
+		// uint8_t format
+		//		DATA_FORMAT_A4, DATA_FORMAT_A2, DATA_FORMAT_A1, DATA_FORMAT_RLE 중 하나를 설정한다.
+		void begin(const uint8_t *data, uint8_t format);
+
+		// 다음 한 점의 농도(0 ~ 15)를 얻는다.
+		inline uint8_t getLevel(void)
+		{
+			uint8_t level;
+
+			if(mFormat == DATA_FORMAT_RLE)
+			{
+				if(mRemain == 0)
+					fetchToken();
+				mRemain--;
+
+				if(mLevel != LITERAL)
+					return mLevel;
+
+				if(mOddFlag)
+				{
+					mOddFlag = false;
+					return mBuffer >> 4;
+				}
+
+				mBuffer = *mData++;
+				mOddFlag = true;
+				return mBuffer & 0x0F;
+			}
+
+			if(mRemain == 0)
+			{
+				mBuffer = *mData++;
+				mRemain = 8;
+			}
+			level = mBuffer & mMask;
+			mBuffer >>= mBits;
+			mRemain -= mBits;
+			return level * mScale;
+		}
+
+		// 지정된 점의 수 만큼 데이터를 건너뛴다.
+		//
+		// uint32_t count
+		//		건너뛸 점의 수를 설정한다.
+		void skip(uint32_t count);
+
+	private :
+		enum
+		{
+			LITERAL = 0xFF,
+		};
+
+		const uint8_t *mData;
+		uint8_t mFormat, mBits, mMask, mScale, mBuffer, mRemain, mLevel;
+		bool mOddFlag;
+
+		inline void fetchToken(void)
+		{
+			uint8_t token = *mData++;
+
+			if(token & 0x80)
+			{
+				mRemain = (token & 0x7F) + 1;
+				mLevel = LITERAL;
+				mOddFlag = false;
+			}
+			else
+			{
+				mRemain = (token & 0x3F) + 1;
+				mLevel = (token & 0x40) ? 15 : 0;
+			}
+		}
+	};
+
 	Font(void);
 
 	virtual fontInfo_t* getFontInfo(uint32_t ch) = 0;
@@ -45,8 +144,18 @@ public:
 
 	uint32_t getUtf8(const char **src);
 
+	// 글꼴 데이터의 형식을 얻는다.
+	uint8_t getDataFormat(void);
+
+	// 글꼴 데이터에서 한 줄이 차지하는 점의 수를 얻는다.
+	// 데이터 형식에 따라 문자의 폭을 2, 4, 8점 단위로 올림한 값이다.
+	//
+	// uint8_t width
+	//		fontInfo_t::width를 설정한다.
+	uint16_t getDataStride(uint8_t width);
+
 protected:
-	uint8_t mSpaceWidth, mCharWidth, mSize;
+	uint8_t mSpaceWidth, mCharWidth, mSize, mDataFormat;
 };
 
 #endif
@@ -35,6 +35,13 @@ public :
 
 	void update(void);
 
+	// endUpdate()가 호출될 때까지 갱신 요청을 그리지 않고 갱신할 영역만 모은다.
+	// 여러 객체를 한 번에 바꿀 때 사용하며, 모인 영역은 하나의 사각형으로 합쳐진다.
+	void beginUpdate(void);
+
+	// beginUpdate() 이후에 모인 영역을 한 번에 그리고 출력한다.
+	void endUpdate(void);
+
 	Object *handlerPush(Position_t pos);
 
 	Object *handlerDrag(Position_t pos);
@@ -43,6 +50,11 @@ public :
 
 private :
 	OutputFrameBuffer *mOutputFrameBuffer;
+	Position_t mDirtyPos;
+	Size_t mDirtySize;
+	bool mHoldFlag, mDirtyFlag;
+
+	void addDirtyArea(Position_t pos, Size_t size);
 };
 
 #endif
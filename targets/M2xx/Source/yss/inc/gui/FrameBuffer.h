@@ -11,6 +11,8 @@
 #include "util.h"
 #include <yss/error.h>
 
+class Palette;
+
 class FrameBuffer
 {
 public :
@@ -20,6 +22,10 @@ public :
 		COLOR_MODE_RGB888,
 		COLOR_MODE_RGB565,
 		COLOR_MODE_ARGB1555,
+		COLOR_MODE_INDEX8,	// 팔레트 번호 8비트, 한 바이트에 한 점
+		COLOR_MODE_INDEX4,	// 팔레트 번호 4비트, 한 바이트에 두 점 (하위 비트 먼저)
+		COLOR_MODE_INDEX2,	// 팔레트 번호 2비트, 한 바이트에 네 점 (하위 비트 먼저)
+		COLOR_MODE_INDEX1,	// 팔레트 번호 1비트, 한 바이트에 여덟 점 (하위 비트 먼저)
 	};
 
 	FrameBuffer(void);
@@ -38,6 +44,24 @@ public :
 
 	uint8_t getDotSize(void);
 
+	// 점 하나의 비트 수를 얻는다.
+	uint8_t getDotBit(void);
+
+	// 한 줄의 바이트 수를 얻는다. 팔레트 방식에서 한 줄은 바이트 단위로 정렬된다.
+	uint32_t getLineSize(void);
+
+	// 팔레트 방식(COLOR_MODE_INDEXn)에서 사용할 색상표를 설정한다.
+	// 브러쉬의 색상은 색상표에서 가장 가까운 색상의 번호로 변환된다.
+	//
+	// Palette *palette
+	//		색상표를 설정한다.
+	void setPalette(Palette *palette);
+
+	Palette* getPalette(void);
+
+	// 팔레트 방식의 색상 모드인지 확인한다.
+	bool isIndexedColorMode(void);
+
 	virtual error_t setSize(uint16_t width, uint16_t height);
 
 	virtual error_t setSize(Size_t size);
@@ -45,7 +69,8 @@ public :
 	Size_t getSize(void);
 
 protected :
-	uint8_t mColorMode, mDotSize;
+	uint8_t mColorMode, mDotSize, mDotBit;
+	Palette *mPalette;
 	uint8_t *mFrameBuffer;
 	Size_t mSize;
 	bool mMemAllocFlag;
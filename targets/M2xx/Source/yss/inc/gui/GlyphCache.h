@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_GLYPH_CACHE__H_
+#define YSS_GUI_GLYPH_CACHE__H_
+
+#include <stdint.h>
+
+class Font;
+
+// 글꼴 색상과 배경 색상이 미리 합성된 문자 이미지를 대상 픽셀 형식으로 보관하는 LRU 캐시이다.
+// (글꼴, 문자, 글꼴 색상, 배경 색상, 픽셀 형식)이 같은 문자는 다시 래스터화 하지 않고 복사만 한다.
+// 사용자가 지정한 메모리(arena)의 앞부분에 항목 테이블을, 나머지에 문자 이미지를 저장한다.
+class GlyphCache
+{
+public :
+	struct glyph_t
+	{
+		Font *font;
+		uint32_t utf8;
+		uint32_t fgColor;	// 대상 픽셀 형식의 글꼴 색상 코드
+		uint32_t bgColor;	// 대상 픽셀 형식의 배경 색상 코드
+		uint8_t colorMode;
+		uint8_t width;		// 저장된 이미지의 폭 (정렬된 폭)
+		uint8_t height;
+		uint8_t advance;	// drawChar()가 반환할 값
+		int8_t xoffset;
+		int8_t yoffset;
+		uint16_t prev, next;
+		uint32_t offset;	// 이미지 영역 내에서 이미지의 위치
+		uint32_t size;		// 이미지의 크기 (바이트)
+	};
+
+	// 캐시가 사용할 메모리를 직접 지정한다.
+	//
+	// void *arena
+	//		캐시가 사용할 메모리의 주소를 설정한다. 4바이트 정렬이 되어 있어야 한다.
+	// uint32_t size
+	//		캐시가 사용할 메모리의 크기를 설정한다.
+	// uint16_t maxGlyph
+	//		저장 가능한 최대 문자의 수를 설정한다.
+	GlyphCache(void *arena, uint32_t size, uint16_t maxGlyph = 64);
+
+	// 캐시가 사용할 메모리를 내부에서 할당 받는다.
+	//
+	// uint32_t size
+	//		캐시가 사용할 메모리의 크기를 설정한다.
+	// uint16_t maxGlyph
+	//		저장 가능한 최대 문자의 수를 설정한다.
+	GlyphCache(uint32_t size, uint16_t maxGlyph = 64);
+
+	~GlyphCache(void);
+
+	// 캐시된 문자를 찾는다. 찾은 문자는 가장 최근에 사용한 항목이 된다.
+	//
+	// 반환
+	//		찾은 문자의 정보를 반환한다. 없을 경우 0을 반환한다.
+	glyph_t* find(Font *font, uint32_t utf8, uint32_t fgColor, uint32_t bgColor, uint8_t colorMode);
+
+	// 새로운 문자를 저장할 공간을 할당 받는다. 공간이 부족하면 가장 오래 사용하지 않은 문자부터 제거한다.
+	// 반환된 glyph_t의 width, height, advance, xoffset, yoffset은 호출한 쪽에서 채운다.
+	//
+	// uint32_t size
+	//		저장할 이미지의 크기(바이트)를 설정한다.
+	//
+	// 반환
+	//		할당된 문자의 정보를 반환한다. 캐시 전체보다 큰 이미지일 경우 0을 반환한다.
+	glyph_t* allocate(Font *font, uint32_t utf8, uint32_t fgColor, uint32_t bgColor, uint8_t colorMode, uint32_t size);
+
+	// 문자 이미지가 저장된 주소를 얻는다.
+	uint8_t* getData(glyph_t *glyph);
+
+	// 캐시된 모든 문자를 제거한다.
+	void clear(void);
+
+	uint32_t getHitCount(void);
+
+	uint32_t getMissCount(void);
+
+private :
+	enum
+	{
+		NONE = 0xFFFF,
+	};
+
+	glyph_t *mGlyph;
+	uint8_t *mArena, *mData;
+	uint32_t mDataSize, mTop, mUsedSize, mHitCount, mMissCount;
+	uint16_t mMaxGlyph, mHead, mTail, mNumOfGlyph;
+	bool mMemAllocFlag;
+
+	void initialize(void *arena, uint32_t size, uint16_t maxGlyph);
+
+	void unlink(uint16_t index);
+
+	void linkToHead(uint16_t index);
+
+	void evict(void);
+
+	void compact(void);
+};
+
+#endif
+
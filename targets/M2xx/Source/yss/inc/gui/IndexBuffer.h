@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_INDEX_BUFFER__H_
+#define YSS_GUI_INDEX_BUFFER__H_
+
+#include "Brush.h"
+#include "Palette.h"
+
+// 팔레트 번호로 그리는 팔레트 방식(COLOR_MODE_INDEX8/4/2/1)의 버퍼 브러쉬이다.
+// 점당 8/4/2/1비트를 사용하므로 RGB565 버퍼(Bmp565Buffer)보다 메모리를 2 ~ 16배 적게 사용한다.
+// 브러쉬, 글자, 배경의 색상은 색상표에서 가장 가까운 색상의 번호로 그려진다.
+//
+// 메모리는 BitmapDecoder의 TYPE_INDEXn 형식(색상표 + 팔레트 번호)으로 저장되므로
+// getBitmap()으로 얻은 비트맵을 LCD 드라이버의 drawBitmap()으로 보내면 작은 버퍼 단위로 LCD의 RGB565 형식으로 풀면서 전송된다.
+// 프레임 버퍼 메모리를 직접 접근하는 Brush의 처리 대신 drawDot()과 fillRectBase()로 그리도록 getFrameBuffer()는 0을 반환한다.
+//
+// 색상표를 바꾼 후에는 setBrushColor(), setFontColor(), setBackgroundColor()를 다시 호출해야 바뀐 색상표가 적용된다.
+class IndexBuffer : public Brush
+{
+public :
+	// uint32_t pointSize
+	//		버퍼의 점의 수를 설정한다. 한 줄은 바이트 단위로 정렬되므로 폭이 바이트의 경계와 맞지 않으면 여유가 필요하다.
+	// uint8_t colorMode
+	//		COLOR_MODE_INDEX8, COLOR_MODE_INDEX4, COLOR_MODE_INDEX2, COLOR_MODE_INDEX1 중 하나를 설정한다.
+	// uint16_t paletteSize
+	//		색상표의 색상의 수를 설정한다. 0이면 색상 모드에서 사용 가능한 최대 수(256, 16, 4, 2)가 된다.
+	IndexBuffer(uint32_t pointSize, uint8_t colorMode = COLOR_MODE_INDEX8, uint16_t paletteSize = 0);
+
+	~IndexBuffer(void);
+
+	virtual error_t setSize(uint16_t width, uint16_t height);
+
+	virtual error_t setSize(Size_t size);
+
+	// BitmapDecoder의 TYPE_INDEXn 형식의 비트맵을 얻는다.
+	Bitmap_t *getBitmap(void);
+
+	uint32_t getBufferSize(void);
+
+	// 팔레트 번호가 저장된 메모리의 주소를 얻는다.
+	uint8_t* getIndexBuffer(void);
+
+	// 점의 팔레트 번호를 얻는다. 좌표의 범위를 확인하지 않는다.
+	uint8_t getDot(int16_t x, int16_t y);
+
+	// Brush
+	virtual void drawDot(int16_t x, int16_t y);
+
+	virtual void drawDot(int16_t x, int16_t y, Color color);
+
+	virtual void drawDot(int16_t x, int16_t y, uint32_t color);
+
+	virtual void fillRectBase(Position_t pos, Size_t size, uint32_t color);
+
+protected :
+	virtual uint8_t getIndexedDot(int16_t x, int16_t y);
+
+	uint8_t *mData, *mIndex;
+	uint32_t mBufferSize, mLineSize;
+	Palette *mIndexPalette;
+	Bitmap_t mBitmap;
+
+	inline void setDot(int16_t x, int16_t y, uint8_t color)
+	{
+		if(mDotBit == 8)
+		{
+			mIndex[y * mLineSize + x] = color;
+			return;
+		}
+
+		uint32_t bit = x * mDotBit;
+		uint8_t *des = &mIndex[y * mLineSize + (bit >> 3)];
+		uint8_t shift = bit & 0x07, mask = ((1 << mDotBit) - 1) << shift;
+
+		*des = (*des & ~mask) | ((color << shift) & mask);
+	}
+};
+
+#endif
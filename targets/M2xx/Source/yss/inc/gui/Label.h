@@ -12,6 +12,7 @@
 
 class Color;
 class Font;
+class TextLayout;
 
 class Label : public Object
 {
@@ -28,6 +29,12 @@ public:
 
 	void setFont(Font &font);
 
+	// 문자열 배치 캐시를 설정한다. 여러 라벨이 하나의 캐시를 공유할 수 있다.
+	//
+	// TextLayout &layout
+	//		사용할 캐시를 설정한다.
+	void setTextLayout(TextLayout &layout);
+
 	// 브러쉬의 배경색을 설정한다.
 	//
 	// Color color
@@ -24,10 +24,10 @@ class MonoBrush
 	MonoBrush(void);
 
 	void setFont(Font &font);
-	uint8_t drawChar(Position_t pos, uint32_t utf8, bool data = true);
+	virtual uint8_t drawChar(Position_t pos, uint32_t utf8, bool data = true);
 	uint8_t drawString(Position_t pos, const char *str, bool data = true);
-	void clear(void);
-	void fill(void);
+	virtual void clear(void);
+	virtual void fill(void);
 	void drawLine(int16_t sx, int16_t sy, int16_t ex, int16_t ey, bool data = true);
 	void drawLine(Position_t start, Position_t end, bool data = true);
 	void drawRect(Position_t p1, Position_t p2, bool data = true);
@@ -36,6 +36,17 @@ class MonoBrush
 	void fillRect(Position_t p1, Position_t p2, bool data = true);
 	void fillRect(Position_t pos, Size_t size, bool data = true);
 
+	// 직사각형 영역을 채운다. fillRect(), clear(), fill()이 사용하며 화면 밖의 영역은 잘라낸다.
+	// 프레임 버퍼의 형식을 알고 있는 하위 클래스에서 바이트 단위로 채우도록 재정의한다.
+	//
+	// Position_t pos
+	//		사각형의 시작 좌표를 설정한다.
+	// Size_t size
+	//		사각형의 크기를 설정한다.
+	// bool data
+	//		점을 켜려면 true, 끄려면 false를 설정한다.
+	virtual void fillRectBase(Position_t pos, Size_t size, bool data);
+
 	virtual void drawDot(uint16_t x, uint16_t y, bool data = true) = 0;
 };
 
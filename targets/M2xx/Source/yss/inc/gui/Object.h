@@ -48,11 +48,21 @@ public:
 
 	void setParent(Container *parent);
 
+	// 객체의 영역이 불투명한 색으로 모두 채워지는지 설정한다.
+	// 불투명한 객체에 완전히 가려진 아래의 객체는 Container가 영역을 갱신할 때 그리지 않는다.
+	//
+	// bool en
+	//		영역을 불투명하게 모두 채우는 객체이면 true를 설정한다.
+	void setOpaque(bool en = true);
+
+	bool isOpaque(void);
+
 	Brush* getFrameBuffer(void);
 
 protected:
 	bool mVisibleFlag;
 	bool mResizeAble;
+	bool mOpaqueFlag;
 	Position_t mPos;
 	Container *mParent;
 	Brush *mFrameBuffer;
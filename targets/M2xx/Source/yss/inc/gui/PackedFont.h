@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_PACKED_FONT__H_
+#define YSS_GUI_PACKED_FONT__H_
+
+#include <stdint.h>
+#include "Font.h"
+
+// tools/fontc 글꼴 컴파일러가 생성하는 글꼴 데이터를 사용하는 클래스이다.
+// 문자 정보는 utf8Code 순으로 정렬되어 있고, 유니코드 값을 (1 << indexShift) 단위로 나눈
+// 구간별 시작 위치가 index에 미리 계산되어 있어 구간 내에서만 이진 탐색을 한다.
+class PackedFont : public Font
+{
+public :
+	struct packedFontInfo_t
+	{
+		uint8_t size;
+		uint8_t dataFormat;			// Font::DATA_FORMAT_A4, A2, A1, RLE
+		uint8_t indexShift;
+		uint8_t reserved;
+		uint32_t numOfChar;
+		uint32_t firstCode;			// 첫 문자의 유니코드 값
+		uint32_t numOfIndex;		// index 배열은 numOfIndex + 1개의 항목을 갖는다.
+		const uint16_t *index;
+		const Font::fontInfo_t *fontInfo;
+	} __attribute__((packed));
+	
+	PackedFont(const packedFontInfo_t *info);
+
+	virtual fontInfo_t* getFontInfo(uint32_t ch);	// pure
+
+private :
+	const packedFontInfo_t *mInfo;
+};
+
+#endif
+
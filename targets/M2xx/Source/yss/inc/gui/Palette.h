@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_PALETTE__H_
+#define YSS_GUI_PALETTE__H_
+
+#include "Color.h"
+
+// 팔레트 방식(COLOR_MODE_INDEX8/4/2/1) 프레임 버퍼의 색상표이다.
+// 색상표는 BitmapDecoder의 TYPE_INDEXn 형식(팔레트 크기-1 (1바이트), RGB565 팔레트)으로 저장되므로
+// 바로 뒤에 팔레트 번호들을 두면 그대로 비트맵이 되어 LCD로 보낼 때 점 단위로 RGB565로 풀린다.
+// RGB565 팔레트는 Color::getRgb565Code()의 값을 저장하므로 RGB565 프레임 버퍼와 같은 바이트 순서가 된다.
+class Palette
+{
+public :
+	// 색상표를 위한 메모리를 할당 받는다.
+	//
+	// uint16_t size
+	//		색상의 수를 설정한다. (1 ~ 256)
+	Palette(uint16_t size);
+
+	// 이미 할당된 메모리를 색상표로 사용한다.
+	//
+	// uint8_t *data
+	//		색상표를 저장할 주소를 설정한다. 1 + size * 2 바이트가 필요하다.
+	// uint16_t size
+	//		색상의 수를 설정한다. (1 ~ 256)
+	Palette(uint8_t *data, uint16_t size);
+
+	~Palette(void);
+
+	// 색상을 설정한다.
+	//
+	// uint8_t index
+	//		설정할 팔레트 번호를 설정한다.
+	// Color color
+	//		설정할 색상을 설정한다.
+	void setColor(uint8_t index, Color color);
+
+	void setColor(uint8_t index, uint8_t red, uint8_t green, uint8_t blue);
+
+	Color getColor(uint8_t index);
+
+	uint16_t getSize(void);
+
+	// 색상과 가장 가까운 팔레트 번호를 찾는다.
+	// 마지막으로 찾은 색상은 다시 찾지 않는다.
+	//
+	// 반환
+	//		RGB 성분의 차이의 제곱 합이 가장 작은 팔레트 번호를 반환한다.
+	uint8_t findIndex(Color color);
+
+	// BitmapDecoder의 TYPE_INDEXn 형식의 색상표 주소를 얻는다.
+	const uint8_t* getData(void);
+
+private :
+	uint8_t *mData;
+	Color *mColor, mLastColor;
+	uint16_t mSize;
+	uint8_t mLastIndex;
+	bool mAllocFlag, mLastFlag;
+
+	void initialize(uint16_t size);
+};
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_GUI_TEXT_LAYOUT__H_
+#define YSS_GUI_TEXT_LAYOUT__H_
+
+#include "Font.h"
+#include "util.h"
+
+// 문자열의 배치 결과(문자별 글꼴 정보와 위치, 전체 크기)를 보관하는 LRU 캐시이다.
+// (글꼴, 문자열)이 같으면 UTF-8 해석과 글꼴 검색을 다시 하지 않으므로
+// 같은 문자열을 반복해서 측정하고 그리는 라벨이나 숫자 표시에 사용한다.
+// 항목마다 maxLength 바이트까지의 문자열을 저장하며, 더 긴 문자열은 캐시하지 않는다.
+class TextLayout
+{
+public :
+	struct glyph_t
+	{
+		Font::fontInfo_t *fontInfo;	// 글꼴에 없는 문자는 0
+		uint32_t utf8;
+		int16_t x;					// 문자열의 시작에서 문자를 그릴 위치
+	};
+
+	struct run_t
+	{
+		Font *font;
+		uint32_t hash;
+		uint32_t lastUse;
+		uint16_t length;			// 문자열의 바이트 수
+		uint16_t numOfGlyph;		// 공백을 제외한 문자의 수
+		uint16_t advance;			// Brush::drawString()이 진행하는 폭
+		uint8_t spaceWidth;
+		uint8_t charWidth;
+		Size_t size;				// Brush::calculateStringSize()가 반환하는 크기
+		glyph_t *glyph;
+		char *text;
+	};
+
+	// 캐시가 사용할 메모리를 내부에서 할당 받는다.
+	//
+	// uint16_t numOfRun
+	//		저장 가능한 최대 문자열의 수를 설정한다.
+	// uint16_t maxLength
+	//		저장 가능한 문자열의 최대 바이트 수를 설정한다.
+	TextLayout(uint16_t numOfRun = 8, uint16_t maxLength = 32);
+
+	~TextLayout(void);
+
+	// 문자열의 배치 결과를 찾는다. 없으면 새로 배치해서 가장 오래 사용하지 않은 항목과 교체한다.
+	//
+	// Font *font
+	//		배치에 사용할 글꼴을 설정한다.
+	// const char *str
+	//		배치할 문자열을 설정한다.
+	//
+	// 반환
+	//		배치 결과를 반환한다. 글꼴이 없거나 maxLength보다 긴 문자열이면 0을 반환한다.
+	run_t* find(Font *font, const char *str);
+
+	// 캐시된 모든 문자열을 제거한다.
+	void clear(void);
+
+	uint32_t getHitCount(void);
+
+	uint32_t getMissCount(void);
+
+private :
+	run_t *mRun;
+	glyph_t *mGlyph;
+	char *mText;
+	uint32_t mUseCount, mHitCount, mMissCount;
+	uint16_t mNumOfRun, mMaxLength;
+
+	void layout(run_t *run, Font *font, const char *str);
+};
+
+#endif
+
@@ -24,7 +24,7 @@ typedef struct
 {
 	uint16_t width;
 	uint16_t height;
-	uint8_t type; // 0 : RGB565, 1 : RGB888, 2 : ARGB1555
+	uint8_t type; // 0 : RGB565, 1 : RGB888, 2 : ARGB1555, 3 : RLE565, 4 : INDEX8, 5 : INDEX4, 6 : INDEX2, 7 : INDEX1 (BitmapDecoder.h 참고)
 	uint8_t *data;
 }Bitmap_t;
 
@@ -32,7 +32,7 @@ typedef struct __attribute__((packed))
 {
 	uint16_t width;
 	uint16_t height;
-	uint8_t type; // 0 : RGB565, 1 : RGB888, 2 : ARGB1555
+	uint8_t type; // 0 : RGB565, 1 : RGB888, 2 : ARGB1555, 3 : RLE565, 4 : INDEX8, 5 : INDEX4, 6 : INDEX2, 7 : INDEX1 (BitmapDecoder.h 참고)
 	uint8_t reserved[3];
 	uint8_t data;
 }BitmapFile_t;
@@ -40,6 +40,9 @@ typedef struct __attribute__((packed))
 extern "C"
 {
 	void copyRgb888DotPattern(void *des, uint32_t pattern, uint32_t count);
+
+	// pattern0, pattern1을 번갈아 count 워드만큼 채운다. des는 4바이트 정렬이 되어 있어야 한다.
+	void copyWordPattern(void *des, uint32_t pattern0, uint32_t pattern1, uint32_t count);
 }
 
 #endif
@@ -36,10 +36,9 @@ class TM0027 : public sac::MonoLcd
   public:
 	TM0027(void);
 	bool initialize(Spi &spi, pin_t &cs, pin_t &A0, pin_t &rst);
-	void clear(void);
+
+	// 마지막 refresh() 이후 바뀐 열의 범위만 전송한다.
 	void refresh(void);
-	void fill(void);
-	void drawDot(uint16_t x, uint16_t y, bool data = true);
 };
 }
 }
@@ -34,10 +34,9 @@ class UG_2832HSWEG04 : public sac::MonoLcd
   public:
 	UG_2832HSWEG04(void);
 	bool initialize(Spi &spi, pin_t &cs, pin_t &dc, pin_t &rst);
-	void clear(void);
+
+	// 마지막 refresh() 이후 바뀐 열의 범위만 전송한다.
 	void refresh(void);
-	void fill(void);
-	void drawDot(uint16_t x, uint16_t y, bool data = true);
 };
 }
 }
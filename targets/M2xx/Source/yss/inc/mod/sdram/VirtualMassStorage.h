@@ -15,22 +15,83 @@ namespace mod
 {
 namespace sdram
 {
+	// 메모리에 있는 파일들을 FAT32 드라이브로 보여주는 가상 저장 장치
+	// 부트 섹터, FAT, 루트 디렉토리와 파일의 데이터는 저장하지 않고 읽을 때마다 파일의 목록으로부터 만든다.
+	// 호스트가 쓴 블록만 RAM에 따로 저장하여 원래의 이미지 위에 덮어 보여주므로 쓴 블록의 수만큼만 RAM을 사용한다.
 	class VirtualMassStorage : public MassStorage
 	{
-		bool writeBlock(uint32_t block, void *src);
-		bool readBlock(uint32_t block, void *des);
-		uint32_t mBlockSize, mNumOfBlock;
-		bool mInitFlag;
-		int8_t *mMemroy;
-
 	public:
+		// 루트 디렉토리에 보일 파일
+		// 목록과 파일의 데이터는 initialize() 이후에도 계속 유지되어야 한다.
+		struct Entry
+		{
+			// 8.3 형식의 이름을 설정한다. (예: "README.TXT")
+			const char *name;
+
+			const void *data;
+
+			uint32_t size;
+		};
+
+		struct Config
+		{
+			const Entry *entry;
+			uint16_t numOfEntry;
+
+			// 드라이브의 블록 수를 설정한다.
+			// 호스트가 FAT32로 인식하려면 클러스터가 65525개 이상이 되어야 하며 부족하면 initialize()가 error_t::WRONG_SIZE를 반환한다.
+			uint32_t numOfBlock;
+
+			// 클러스터당 섹터의 수를 설정한다. 루트 디렉토리에는 16 * sectorPerCluster개의 파일까지 들어간다.
+			uint8_t sectorPerCluster;
+
+			// 호스트가 쓸 수 있는 블록의 최대 수를 설정한다.
+			uint16_t maxOverlay;
+		};
+
 		VirtualMassStorage(void);
+
+		~VirtualMassStorage(void);
+
+		error_t initialize(const Config &config);
+
+		// 호스트가 써서 RAM에 저장된 블록의 수를 얻는다.
+		uint16_t getOverlayCount(void);
+
+		// 호스트가 쓴 블록을 모두 버리고 처음의 이미지로 되돌린다.
+		void discard(void);
+
 		uint32_t getBlockSize(void);
+
 		uint32_t getNumOfBlock(void);
-		bool initialize(uint32_t blockSize, uint32_t numOfBlock);
+
+		// 원래의 이미지와 같은 내용을 쓰면 RAM에 저장하지 않는다.
+		error_t write(uint32_t block, void *src);
+
+		error_t read(uint32_t block, void *des);
+
+		error_t readBlocks(uint32_t block, uint32_t count, void *des);
+
+		bool isConnected(void);
+
+	private:
+		const Entry *mEntry;
+		uint32_t *mFirstCluster, *mOverlayBlock;
+		uint8_t **mOverlayData, *mBlockBuffer;
+		uint32_t mNumOfBlock, mFatSize, mFatStart, mDataStart, mNumOfCluster, mUsedCluster;
+		uint16_t mNumOfEntry, mMaxOverlay, mOverlayCount;
+		uint8_t mSectorPerCluster;
+		bool mInitFlag;
+
+		void release(void);
+		uint32_t findOverlay(uint32_t block);
+		void build(uint32_t block, uint8_t *des);
+		void buildFat(uint32_t sector, uint32_t *des);
+		void buildDirectory(uint32_t sector, uint8_t *des);
+		void buildData(uint32_t cluster, uint32_t sector, uint8_t *des);
 	};
 }
 }
 
-
 #endif
+
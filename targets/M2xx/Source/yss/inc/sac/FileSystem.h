@@ -10,9 +10,12 @@
 
 #include <sac/MassStorage.h>
 #include <yss/error.h>
+#include <yss/Mutex.h>
 #include <stdint.h>
 
-class FileSystem
+// 파일에 대한 함수들은 선택된 핸들의 파일에 동작한다.
+// 여러 파일을 같이 사용할 때는 lock()을 걸고 selectHandle()로 핸들을 선택한 뒤에 호출한다.
+class FileSystem : public Mutex
 {
 protected :
 
@@ -21,6 +24,7 @@ protected :
 	uint32_t mNumOfSector, mFirstSector;
 	uint8_t mPartitionType;
 	bool mAbleFlag;
+	const void *mDirectoryOwner;
 	
 	FileSystem(MassStorage &storage);
 	~FileSystem(void);
@@ -43,6 +47,7 @@ public :
 	virtual bool isFile(void) = 0;
 	virtual bool isHaveNextCluster(void) = 0;
 	virtual bool compareName(const char *utfName) = 0;
+	virtual error_t moveToName(const char *utfName) = 0;
 	virtual error_t enterDirectory(void) = 0;
 	virtual error_t returnDirectory(void) = 0;
 	virtual error_t makeDirectory(const char*name) = 0;
@@ -50,14 +55,31 @@ public :
 	virtual error_t open(void) = 0;
 	virtual error_t read(void *des) = 0;
 	virtual error_t write(void *src) = 0;
+	virtual uint32_t read(void *des, uint32_t count) = 0;
+	virtual uint32_t write(void *src, uint32_t count) = 0;
 	virtual uint32_t getFileSize(void) = 0;
 	virtual error_t moveToNextSector(void) = 0;
+	virtual error_t moveToSector(uint32_t sector) = 0;
 	virtual error_t close(uint32_t fileSize) = 0;
 	virtual error_t close(void) = 0;
 	virtual uint32_t getCurrentDirectoryCluster(void) = 0;
 	virtual error_t moveToFileStart(void) = 0;
+	virtual error_t sync(void) = 0;
+	virtual error_t sync(uint32_t fileSize) = 0;
+	virtual error_t reserve(uint32_t size, bool clear = false) = 0;
+
+	// open()이 성공하면 새 핸들이 할당되어 선택되고 close()에서 반환된다.
+	virtual int32_t getHandle(void) = 0;
+	virtual error_t selectHandle(int32_t handle) = 0;
+	virtual void* getHandleBuffer(void) = 0;
 
 	void* getSectorBuffer(void);
+
+	// 디렉토리의 탐색 위치를 기억하는 객체를 설정하거나 얻는다. lock()을 건 상태에서 호출한다.
+	// 탐색 위치를 옮기는 함수는 소유자를 0으로 지우므로, Directory는 소유자가 자신이 아니면 자신의 디렉토리로 돌아가서 다시 찾는다.
+	void setDirectoryOwner(const void *owner);
+
+	const void* getDirectoryOwner(void);
 };
 
 #endif
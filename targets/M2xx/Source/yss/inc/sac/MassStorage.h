@@ -23,6 +23,16 @@ public :
 
 	virtual error_t read(uint32_t block, void *des) = 0;
 
+	// block부터 count개의 연속된 블록을 한번에 쓰거나 읽는다.
+	// 기본 구현은 write(), read()를 블록마다 호출하므로 여러 블록을 한 명령으로 전송할 수 있는 장치는 재정의한다.
+	virtual error_t writeBlocks(uint32_t block, uint32_t count, void *src);
+
+	virtual error_t readBlocks(uint32_t block, uint32_t count, void *des);
+
+	// 메모리에만 남아 있는 데이터를 저장 장치에 저장한다.
+	// 기본 구현은 아무것도 하지 않으므로 BlockCache와 같이 쓰기를 늦추는 저장 장치는 재정의한다.
+	virtual error_t sync(void);
+
 	virtual bool isConnected(void) = 0;
 };
 
@@ -17,20 +17,66 @@
 
 namespace sac
 {
+// 한 바이트가 세로 8점(페이지)을 표현하는 OLED/GLCD용 프레임 버퍼를 관리한다.
+// 프레임 버퍼는 페이지 순서로 저장되며 한 페이지는 mWidth 바이트이다. (bit0이 페이지의 가장 위의 점)
+// 그리기 함수는 내용이 실제로 바뀐 열을 페이지별 더티 마스크에 기록하며,
+// 하위 클래스의 refresh()는 getDirtyRange()로 바뀐 열의 범위만 전송한다.
 class MonoLcd : public MonoBrush, public Mutex
 {
   protected:
-	uint16_t mWidth, mHeight;
+	uint16_t mWidth, mHeight, mNumOfPage;
 	uint32_t mBufferSize;
 	uint8_t *mFrameBuffer;
+	uint32_t *mDirtyMask;	// 페이지별 더티 마스크, 한 비트가 mDirtyGroupSize개의 열을 표현
+	uint8_t mDirtyGroupSize;
+	bool mReverseX;			// 프레임 버퍼의 열 순서가 x 좌표와 반대인 경우 true
 
 	void setSize(uint16_t width, uint16_t height);
 
+	// 페이지의 열 범위를 더티로 표시한다.
+	//
+	// uint16_t page
+	//		페이지 번호를 설정한다.
+	// uint16_t start, end
+	//		프레임 버퍼 상의 시작 열과 끝 열을 설정한다. (끝 열 포함)
+	void markDirty(uint16_t page, uint16_t start, uint16_t end);
+
+	// 페이지에서 다음으로 전송할 연속된 더티 열 범위를 얻고 그 범위를 더티 마스크에서 지운다.
+	// 범위 사이의 간격이 한 그룹 뿐이면 명령을 다시 보내는 것보다 이어서 보내는 것이 빠르므로 합친다.
+	//
+	// uint16_t page
+	//		페이지 번호를 설정한다.
+	// uint16_t &x
+	//		전송할 시작 열을 얻는다.
+	// uint16_t &width
+	//		전송할 열의 수를 얻는다.
+	//
+	// 반환
+	//		더 이상 전송할 범위가 없으면 false를 반환한다.
+	bool getDirtyRange(uint16_t page, uint16_t &x, uint16_t &width);
+
   public:
 	MonoLcd(void);
 
-	virtual void drawDot(uint16_t x, uint16_t y, bool data = true) = 0;
+	// 다음 refresh()에서 화면 전체를 전송하도록 한다.
+	void invalidate(void);
+
+	// MonoBrush
+	virtual void drawDot(uint16_t x, uint16_t y, bool data = true);
+
+	virtual void fillRectBase(Position_t pos, Size_t size, bool data);
+
+	virtual uint8_t drawChar(Position_t pos, uint32_t utf8, bool data = true);
+
 	virtual void refresh(void) = 0;
+
+  private:
+	enum
+	{
+		GLYPH_BUFFER_SIZE = 128,
+	};
+
+	void writeGlyphColumn(uint16_t page, uint16_t x, uint16_t count, uint8_t mask, const uint8_t *value);
 };
 }
 
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#ifndef YSS_BLOCK_CACHE__H_
+#define YSS_BLOCK_CACHE__H_
+
+#include <sac/MassStorage.h>
+
+// 저장 장치 앞에 놓이는 블록 캐시
+// 다른 MassStorage를 감싸는 MassStorage로 Fat32 등에 저장 장치 대신 전달하여 사용한다.
+// 블록은 (블록 번호 % 세트의 수)번 세트에 들어가며 세트 안에서는 가장 오래 사용되지 않은 블록이 교체된다.
+// 다른 MassStorage와 같이 사용하는 쪽에서 lock()을 걸고 호출해야 하며 저장 장치에 접근할 때는 저장 장치의 lock()을 건다.
+class BlockCache : public MassStorage
+{
+public:
+	enum
+	{
+		// 변경된 블록은 교체되거나 sync()가 호출될 때 저장된다.
+		WRITE_BACK = 0,
+
+		// 쓰기는 캐시와 저장 장치에 바로 같이 저장된다.
+		WRITE_THROUGH,
+	};
+
+	BlockCache(void);
+
+	// 할당한 버퍼를 반환한다. 저장하지 않은 블록은 버려지므로 먼저 sync()를 호출해야 한다.
+	~BlockCache(void);
+
+	// 캐시를 초기화 한다.
+	// 블록 버퍼로 블록 크기 * numOfSet * numOfWay 바이트를 new로 할당한다.
+	//
+	// MassStorage *storage
+	//		캐시할 저장 장치를 설정한다.
+	// uint16_t numOfSet
+	//		세트의 수를 설정한다. 2의 거듭제곱이어야 한다.
+	// uint8_t numOfWay
+	//		세트당 블록의 수를 설정한다.
+	error_t initialize(MassStorage *storage, uint16_t numOfSet, uint8_t numOfWay);
+
+	// 쓰기 정책을 설정한다.
+	//
+	// uint8_t policy
+	//		WRITE_BACK 또는 WRITE_THROUGH를 설정한다.
+	// uint16_t dirtyLimit
+	//		WRITE_BACK에서 변경된 블록의 수가 dirtyLimit에 이르면 sync()를 호출한다. 0이면 제한하지 않는다.
+	void setWritePolicy(uint8_t policy, uint16_t dirtyLimit = 0);
+
+	// 연속된 블록을 읽고 있으면 다음 블록들을 한 명령으로 미리 읽는다.
+	// 미리 읽기 버퍼로 블록 크기 * count 바이트를 new로 할당하며 sync()에서 연속된 블록을 한번에 저장할 때도 사용한다.
+	//
+	// uint8_t count
+	//		미리 읽을 블록의 수를 설정한다. 세트의 수를 넘을 수 없으며 0이면 미리 읽지 않는다.
+	error_t setReadAhead(uint8_t count);
+
+	// 변경된 블록들을 블록 번호 순서로 저장 장치에 저장한다.
+	error_t sync(void);
+
+	// 저장하지 않은 블록을 포함해 캐시의 모든 블록을 버린다.
+	// 저장 장치가 교체되었을 때 호출한다.
+	void invalidate(void);
+
+	uint32_t getHitCount(void);
+
+	uint32_t getMissCount(void);
+
+	uint32_t getBlockSize(void);
+
+	uint32_t getNumOfBlock(void);
+
+	error_t write(uint32_t block, void *src);
+
+	error_t read(uint32_t block, void *des);
+
+	// 여러 블록의 전송은 캐시를 거치지 않고 저장 장치에 바로 전송하며 캐시에 있는 블록은 함께 갱신된다.
+	error_t writeBlocks(uint32_t block, uint32_t count, void *src);
+
+	error_t readBlocks(uint32_t block, uint32_t count, void *des);
+
+	bool isConnected(void);
+
+private:
+	struct Line
+	{
+		uint32_t block, lastUsed;
+		uint8_t *data;
+		bool dirty;
+	};
+
+	MassStorage *mStorage;
+	Line *mLine;
+	uint8_t *mReadAheadBuffer;
+	uint32_t mBlockSize, mSetMask, mUseCount, mLastMiss, mDirtyCount, mHitCount, mMissCount;
+	uint16_t mDirtyLimit;
+	uint8_t mNumOfWay, mPolicy, mReadAhead;
+
+	Line* find(uint32_t block);
+	Line* findVictim(uint32_t block);
+	Line* findLowestDirty(void);
+	error_t evict(Line *line);
+	error_t fill(Line *line, uint32_t block);
+	error_t prefetch(uint32_t block);
+	void markClean(Line *line);
+};
+
+#endif
+
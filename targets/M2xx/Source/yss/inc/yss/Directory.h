@@ -10,6 +10,9 @@
 
 #include <sac/FileSystem.h>
 
+// 파일 시스템의 디렉토리를 탐색한다.
+// 모든 함수는 파일 시스템을 잠그고 동작하므로 열린 File과 함께 사용할 수 있다.
+// File::open() 등으로 파일 시스템의 탐색 위치가 바뀌었으면 이 객체의 디렉토리로 돌아가서 다시 찾는다.
 class Directory
 {
 public :
@@ -17,6 +20,8 @@ public :
 
 	Directory(FileSystem *fileSystem);
 
+	// 파일 시스템을 초기화하고 현재 디렉토리를 탐색한다.
+	// 열린 파일이 있으면 error_t::BUSY를 반환한다.
 	error_t initialize(void);
 
 	uint32_t getDirectoryCount(void);
@@ -39,7 +44,12 @@ public :
 
 private :
 	FileSystem *mFileSystem;
-	uint32_t mFileCount, mDirectoryCount, mCurrentFileIndex, mCurrentDirectoryIndex;
+	uint32_t mCluster, mFileCount, mDirectoryCount, mCurrentFileIndex, mCurrentDirectoryIndex;
+
+	error_t select(void);
+	error_t moveToFile(uint32_t index);
+	error_t moveToDirectory(uint32_t index);
+	void update(void);
 };
 
 #endif
\ No newline at end of file
@@ -12,9 +12,14 @@
 #include <yss/error.h>
 #include "Fat32Cluster.h"
 #include "Fat32DirectoryEntry.h"
-#include <yss/Mutex.h>
 
-class Fat32 : public FileSystem, public Mutex
+// 동시에 열 수 있는 파일의 수
+// 파일마다 512 바이트의 섹터 버퍼와 커서 및 파일 정보를 위한 (12 x FAT32_EXTENT_COUNT + 52) 바이트의 RAM을 사용한다.
+#if !defined(FAT32_HANDLE_COUNT)
+#define FAT32_HANDLE_COUNT	2
+#endif
+
+class Fat32 : public FileSystem
 {
 public :
 	// 최대 사용 가능한 파일 이름 숫자 maxLfnLength x 13
@@ -42,24 +47,61 @@ public :
 
 	error_t makeFile(const char *name);
 
+	// 현재 항목의 파일을 빈 핸들에 열고 그 핸들을 선택한다.
+	// 파일마다 클러스터 커서를 따로 가지므로 파일이 열려 있어도 디렉토리를 탐색하거나 다른 파일을 열 수 있다.
+	// 반환 : 빈 핸들이 없으면 error_t::BUSY를, 이미 열린 파일이면 error_t::ALREADY_OPENED를 반환한다.
 	error_t open(void);
 
+	// 현재 디렉토리를 기준으로 경로의 파일을 연다. (예 : "logs/2026/day.csv")
+	// '/'로 시작하면 루트 디렉토리를 기준으로 한다.
+	// 파일이 열리면 현재 디렉토리는 파일이 있는 디렉토리가 된다.
 	error_t open(const char *name);
 
 	error_t read(void *des);
 
 	error_t write(void *src);
 
+	// 열린 파일의 현재 섹터부터 count개의 섹터를 읽거나 쓴다.
+	// 저장 장치에서 연속된 섹터들은 한번에 전송한다.
+	// 반환 : 전송한 섹터의 수를 반환한다.
+	uint32_t read(void *des, uint32_t count);
+
+	uint32_t write(void *src, uint32_t count);
+
 	error_t moveToNextSector(void);
 
+	// 열린 파일의 시작에서 sector 번째 섹터로 이동한다.
+	// 클러스터가 없는 빈 파일이면 error_t::NO_DATA를 반환한다.
+	error_t moveToSector(uint32_t sector);
+
+	// 파일의 크기를 디렉토리 엔트리에 저장하고 sync()를 호출한다.
 	error_t close(uint32_t fileSize);
 
 	error_t close(void);
 
 	error_t moveToFileStart(void);
 
+	// 메모리에만 변경된 FAT를 저장 장치에 저장하고 저장 장치의 sync()를 호출한다.
+	error_t sync(void);
+
+	// 열린 파일을 닫지 않고 크기를 디렉토리 엔트리에 저장한다.
+	// 데이터와 FAT를 먼저 저장 장치에 저장한 뒤에 크기를 저장하므로 전원이 꺼져도 크기는 저장된 데이터만 가리킨다.
+	error_t sync(uint32_t fileSize);
+
+	// 열린 파일이 size 바이트를 저장할 수 있도록 체인의 끝에 연속된 클러스터를 미리 할당한다.
+	// clear가 true이면 할당된 클러스터를 0으로 지운다.
+	// 클러스터가 없는 빈 파일은 첫 클러스터를 할당하여 디렉토리 엔트리에 저장한 뒤에 예약한다.
+	error_t reserve(uint32_t size, bool clear = false);
+
+	// 빈 클러스터의 수를 얻는다. 알 수 없으면 0xFFFFFFFF를 반환한다.
+	uint32_t getFreeClusterCount(void);
+
 	bool compareName(const char *utf8);
 
+	// 현재 디렉토리에서 이름이 utf8인 항목으로 이동한다. 이름은 0이나 '/'에서 끝난다.
+	// 디렉토리 캐시를 사용하므로 같은 디렉토리를 다시 찾을 때 처음부터 읽지 않는다.
+	error_t moveToName(const char *utf8);
+
 	bool isDirectory(void);
 
 	bool isFile(void);
@@ -74,7 +116,24 @@ public :
 
 	uint32_t getCurrentDirectoryCluster(void);
 
+	int32_t getHandle(void);
+
+	error_t selectHandle(int32_t handle);
+
+	// 선택된 핸들의 512 바이트 섹터 버퍼를 얻는다.
+	void* getHandleBuffer(void);
+
 private :
+	// 열린 파일의 정보
+	// directoryCluster와 entryPosition은 파일을 닫을 때 크기를 기록할 디렉토리 엔트리의 위치이다.
+	struct Handle
+	{
+		uint32_t buffer[128];
+		Fat32Cluster::Cursor cursor;
+		uint32_t fileCluster, fileSize, directoryCluster, entryPosition;
+		bool openFlag, appendFlag;
+	};
+
 	struct LongFileName
 	{
 		int8_t order;
@@ -93,18 +152,27 @@ private :
 	};
 
 	uint32_t mCurrentFileCluster;
-	bool mAbleFlag, mFileOpen;
+	bool mAbleFlag;
 	uint8_t mSectorPerCluster, mNumFATs;
 	uint16_t mFsInfoSector;
 	uint32_t mNumOfFreeClusters, mNextFreeCluster;
 	uint32_t mFatSize, mRootCluster;
-	uint32_t mBufferedFatSector, mFileCluster;
+	uint32_t mBufferedFatSector;
 	
 	Fat32Cluster mCluster;
 	Fat32DirectoryEntry mDirectoryEntry;
+	Handle mHandle[FAT32_HANDLE_COUNT], *mCurrentHandle;
 
 	error_t initReadCluster(uint32_t cluster, void *des);
 
+	error_t prepareWrite(void);
+
+	error_t allocateFileCluster(bool clear);
+
+	error_t selectFileCursor(void);
+
+	void selectDirectoryCursor(void);
+
 	error_t readNextBlock(void *des);
 
 	uint32_t getCount(uint8_t *type, uint8_t typeCount);
@@ -8,28 +8,93 @@
 #ifndef YSS_FAT32_CLUSTER__H_
 #define YSS_FAT32_CLUSTER__H_
 
+#include <config.h>
 #include <yss/error.h>
 #include <sac/FileSystem.h>
 
+// 메모리에 보관하는 FAT 섹터의 수
+// 섹터당 512 + 12 바이트의 RAM을 사용한다.
+#if !defined(FAT32_FAT_CACHE_COUNT)
+#define FAT32_FAT_CACHE_COUNT	4
+#endif
+
+// 열린 파일의 클러스터 체인에서 기억하는 연속된 클러스터 구간의 수
+// 커서마다 구간당 12 바이트의 RAM을 사용한다.
+// 구간이 모두 사용되면 그 뒤의 체인은 FAT를 읽으며 이동한다.
+#if !defined(FAT32_EXTENT_COUNT)
+#define FAT32_EXTENT_COUNT		16
+#endif
+
+// 빈 클러스터를 찾는 비트맵의 크기 (바이트, 16의 배수)
+// 비트맵은 바이트당 8개의 클러스터씩 FAT의 일부 구간만 나타내며 구간을 벗어나면 FAT를 읽어 다시 만든다.
+// 구간은 FAT 섹터(128개의 클러스터) 단위로 시작하므로 FAT 섹터 하나 이상을 온전히 담아야 한다.
+#if !defined(FAT32_FREE_MAP_SIZE)
+#define FAT32_FREE_MAP_SIZE		256
+#endif
+
+#if (FAT32_FREE_MAP_SIZE % 16) || FAT32_FREE_MAP_SIZE < 16
+#error "FAT32_FREE_MAP_SIZE는 16 이상의 16의 배수여야 합니다."
+#endif
+
+// reserve()에서 연속으로 비어 있는 구간을 찾을 때 살펴보는 클러스터의 최대 수
+// 이 범위 안에서 찾지 못하면 가장 길게 비어 있는 곳부터 조각난 클러스터를 연결한다.
+#if !defined(FAT32_FREE_RUN_SEARCH_SIZE)
+#define FAT32_FREE_RUN_SEARCH_SIZE	(FAT32_FREE_MAP_SIZE * 8 * 4)
+#endif
+
 class Fat32Cluster
 {
 
 public:
 	struct Address
 	{
-		uint32_t start, cluster, next, tableIndex;
+		uint32_t start, cluster, next, tableIndex, index;
 		uint8_t sectorIndex;
 	};
 
-	Fat32Cluster(void);
+	// 연속된 클러스터 구간
+	// index는 구간의 첫 클러스터가 체인에서 몇 번째 클러스터인지를 나타낸다.
+	struct Extent
+	{
+		uint32_t index, cluster, count;
+	};
 
-	void initialize(MassStorage *storage, uint32_t fatSector, uint32_t fatBackup, uint32_t sectorSize, uint8_t sectorPerCluster);
+	// 체인에서의 현재 위치와 지나간 체인의 구간 정보
+	// 열린 파일마다 커서를 따로 두면 FAT 캐시와 빈 클러스터 정보를 같이 사용하면서 여러 체인을 번갈아 탐색할 수 있다.
+	struct Cursor
+	{
+		Address address;
+		Extent extent[FAT32_EXTENT_COUNT];
+		uint32_t extentStart, extentCount;
+	};
 
+	Fat32Cluster(void);
+
+	// uint32_t numOfCluster
+	//		데이터 영역의 클러스터의 수를 설정한다. 0이면 FAT의 크기로 계산한다.
+	void initialize(MassStorage *storage, uint32_t fatSector, uint32_t fatBackup, uint32_t sectorSize, uint8_t sectorPerCluster, uint32_t numOfCluster = 0);
+
+	// FSInfo 섹터의 정보를 설정한다.
+	// 빈 클러스터의 검색은 nextFree부터 시작하고 빈 클러스터의 수는 할당할 때마다 갱신되어 save() 호출 시 FSInfo 섹터에 저장된다.
+	//
+	// uint32_t sector
+	//		FSInfo 섹터의 번호를 설정한다.
+	// uint32_t freeCount
+	//		빈 클러스터의 수를 설정한다. 0xFFFFFFFF이면 알 수 없음을 나타낸다.
+	// uint32_t nextFree
+	//		다음에 할당할 빈 클러스터의 번호를 설정한다.
+	void setFsInfo(uint32_t sector, uint32_t freeCount, uint32_t nextFree);
+
+	uint32_t getFreeClusterCount(void);
+
+	// 변경된 FAT 섹터들을 저장 장치의 첫번째 FAT와 백업 FAT에 모두 저장한다.
+	// 빈 클러스터의 정보가 바뀌었으면 FSInfo 섹터도 저장한다.
 	error_t save(void);
 
 	error_t moveToNextCluster(void);
 
-	error_t increaseDataSectorIndex(void);
+	// 데이터 섹터의 위치를 count개의 섹터만큼 뒤로 옮긴다.
+	error_t increaseDataSectorIndex(uint32_t count = 1);
 
 	error_t append(bool clear = true);
 
@@ -49,29 +114,92 @@ public:
 
 	error_t writeDataSector(void* des);
 
+	// 현재 섹터부터 count개의 연속된 섹터를 한번에 읽거나 쓴다.
+	// count는 getContiguousSectorCount()로 얻은 수를 넘지 않아야 한다.
+	error_t readDataSectors(void* des, uint32_t count);
+
+	error_t writeDataSectors(void* src, uint32_t count);
+
 	error_t moveToRoot(void);
 
 	error_t moveToStart(void);
 
 	error_t moveTo(uint32_t cluster);
 
+	// 현재 체인의 시작에서 sector 번째 섹터로 이동한다.
+	// 이미 지나간 체인은 연속된 클러스터 구간으로 기억하므로 FAT를 다시 읽지 않고 이분 탐색으로 찾는다.
+	error_t moveToSector(uint32_t sector);
+
+	// 현재 섹터부터 저장 장치에서 연속된 섹터의 수를 얻는다.
+	// 구간 정보의 끝에서는 max개의 섹터를 넘을 때까지 FAT를 미리 읽어 구간을 늘린다.
+	// 구간 정보가 없는 곳에서는 현재 클러스터의 남은 섹터의 수가 된다.
+	uint32_t getContiguousSectorCount(uint32_t max);
+
 	uint32_t getSectorSize(void);
 
+	// 현재 체인의 시작에서 현재 섹터까지의 섹터 수를 얻는다.
+	uint32_t getSectorIndex(void);
+
 	uint32_t allocate(bool clear = true);
 
+	// 현재 체인이 count개의 클러스터를 갖도록 체인의 끝에 클러스터를 추가한다.
+	// 체인의 끝에서부터 연속으로 비어 있는 구간을 찾아 할당하므로 체인이 조각나지 않는다.
+	// clear가 true이면 추가된 클러스터를 0으로 지운다.
+	error_t reserve(uint32_t count, bool clear = false);
+
+	// 현재 체인의 시작에서 count개의 클러스터만 남기고 나머지 클러스터를 해제한다.
+	// 첫 클러스터는 디렉토리 엔트리가 가리키므로 count가 0이어도 남긴다.
+	error_t truncate(uint32_t count);
+
+	// 이후의 체인 탐색에 사용할 커서를 설정한다.
+	// 0이면 디렉토리 탐색에 사용하는 기본 커서로 설정한다.
+	void setCursor(Cursor *cursor = 0);
+
+	// 커서의 위치와 구간 정보를 지운다.
+	// 다른 체인에 사용하던 커서를 다시 사용하기 전에 호출한다.
+	void clearCursor(Cursor &cursor);
+
 	void backup(void);
 
 	void restore(void);
 
 private:
-	uint32_t mFatTableBuffer[128], mFatLength;
+	// FAT 섹터 캐시
+	// 변경된 섹터는 save()가 호출되거나 다른 섹터로 교체될 때 저장된다.
+	struct FatCache
+	{
+		uint32_t buffer[128];
+		uint32_t table, lastUsed;
+		bool dirty;
+	};
+
+	FatCache mFatCache[FAT32_FAT_CACHE_COUNT], *mCurrentFat;
+	Cursor mDefaultCursor, *mCursor;
+	uint32_t *mFatTableBuffer, mFatLength, mCacheCount;
+	uint32_t mFreeMap[FAT32_FREE_MAP_SIZE / 4], mFreeMapStart, mFreeMapCount;
+	uint32_t mClusterCount, mFreeCount, mNextFree, mFsInfoSector;
+	uint32_t mFailedRunStart, mFailedRunRange, mFailedRunCount;
 	uint32_t mRoot, mFatSector, mFatBackupSector, mLastReadFatTable, mSectorSize, mDataStartSector;
 	uint8_t mSectorPerCluster;
 	MassStorage *mStorage;
-	bool mUpdateFlag;
-	Address mAddress, mBackupAddress;
+	bool mFsInfoUpdateFlag;
+	Address mBackupAddress;
 
 	error_t readFat(uint32_t cluster);
+	error_t loadFat(uint32_t table);
+	error_t writeFat(FatCache *cache);
+	void clearFatCache(void);
+	FatCache* findOldestFat(void);
+	error_t setAddress(uint32_t index, uint32_t cluster);
+	void addExtent(uint32_t index, uint32_t cluster);
+	Extent* findExtent(uint32_t index);
+	error_t saveFsInfo(void);
+	error_t buildFreeMap(uint32_t cluster);
+	bool isFree(uint32_t cluster);
+	uint32_t findFree(uint32_t cluster);
+	uint32_t findFreeRun(uint32_t cluster, uint32_t count);
+	error_t setFatEntry(uint32_t cluster, uint32_t value);
+	error_t clearCluster(uint32_t cluster);
 	uint32_t calculateNextCluster(void);
 };
 
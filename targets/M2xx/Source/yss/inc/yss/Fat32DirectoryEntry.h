@@ -10,6 +10,12 @@
 
 #include "Fat32Cluster.h"
 
+// 디렉토리 캐시의 항목 수
+// 항목당 12 바이트를 사용한다.
+#if !defined(FAT32_DIRECTORY_CACHE_COUNT)
+#define FAT32_DIRECTORY_CACHE_COUNT	32
+#endif
+
 class Fat32DirectoryEntry
 {
 public:
@@ -47,10 +53,32 @@ public:
 
 	void setTargetFileSize(uint32_t size);
 
+	// 이름은 0이나 '/'에서 끝난다.
 	bool comapreTargetName(const char *utf8);
 
+	// 현재 디렉토리에서 이름이 utf8인 항목으로 이동한다. 이름은 0이나 '/'에서 끝난다.
+	// (디렉토리 클러스터, 이름의 해시)로 항목의 위치를 기억하는 캐시에 있으면 디렉토리를 처음부터 읽지 않고 바로 이동한다.
+	// 캐시에 없으면 디렉토리를 처음부터 찾으며 지나가는 항목들을 캐시에 기억한다.
+	// 반환 : 항목이 없으면 error_t::NOT_EXIST_NAME을 반환한다.
+	error_t moveToName(const char *utf8);
+
+	// cluster에서 시작하는 디렉토리의 캐시를 지운다. 0이면 모든 캐시를 지운다.
+	void invalidateCache(uint32_t cluster = 0);
+
 	error_t saveEntry(void);
 
+	// 현재 항목의 짧은 이름 엔트리의 위치를 얻는다.
+	// 반환 : 디렉토리 시작에서의 섹터 번호 << 4 | 섹터 안의 엔트리 번호
+	uint32_t getTargetPosition(void);
+
+	// cluster에서 시작하는 디렉토리의 position 위치에 있는 엔트리의 파일 크기를 size로 바꿔 저장한다.
+	// 현재 위치는 바뀌지 않는다.
+	error_t saveFileSize(uint32_t cluster, uint32_t position, uint32_t size);
+
+	// cluster에서 시작하는 디렉토리의 position 위치에 있는 엔트리의 시작 클러스터를 fileCluster로 바꿔 저장한다.
+	// 현재 위치는 바뀌지 않는다.
+	error_t saveFileCluster(uint32_t cluster, uint32_t position, uint32_t fileCluster);
+
 private:
 	struct LongFileName
 	{
@@ -80,11 +108,19 @@ private:
 		uint32_t fileSize;
 	};
 	
+	struct DirectoryCache
+	{
+		// position은 디렉토리 시작에서의 섹터 번호 << 4 | 섹터 안의 엔트리 번호
+		uint32_t cluster, hash, position;
+	};
+
 	enum
 	{
 		MAX_LFN = 20
 	};
 
+	DirectoryCache mCache[FAT32_DIRECTORY_CACHE_COUNT];
+	uint32_t mItemPosition;
 	Fat32Cluster *mCluster;
 	DirectoryEntry *mEntryBuffer;
 	uint16_t mSectorSize;
@@ -104,12 +140,31 @@ private:
 
 	void setShortName(void *des, const char *src);
 
+	// 현재 디렉토리를 처음부터 읽어 앞의 6글자가 같은 짧은 이름들이 사용하지 않는 ~1 ~ ~9의 번호를 name에 붙인다.
+	// 반환 : 모든 번호가 사용 중이면 error_t::SAME_FILE_NAME_EXIST를 반환한다.
+	error_t selectShortNameTail(char *name);
+
 	uint8_t calculateChecksum(DirectoryEntry *src);
 
 	void copyStringUtf8ToLfnBuffer(const char *utf8, int32_t len);
 
 	DirectoryEntry getCurrentDirectoryEntry(void);
 
+	uint32_t getPosition(void);
+
+	error_t moveToPosition(uint32_t position);
+
+	uint32_t calculateNameHash(const char *utf8);
+
+	uint32_t calculateTargetNameHash(void);
+
+	void addCache(uint32_t cluster);
+
+	inline bool isNameEnd(char c)
+	{
+		return c == 0 || c == '/';
+	}
+
 	error_t prepareInsert(uint32_t &cluster, DirectoryEntry &sfn, uint8_t attribute, const char *name, uint32_t len);
 };
 
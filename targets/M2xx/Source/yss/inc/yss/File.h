@@ -10,6 +10,16 @@
 
 #include <sac/FileSystem.h>
 
+// APPEND_LOG 모드에서 파일의 끝에 한번에 미리 할당하는 크기 (바이트)
+#if !defined(FILE_LOG_RESERVE_SIZE)
+#define FILE_LOG_RESERVE_SIZE	(64 * 1024)
+#endif
+
+// APPEND_LOG 모드에서 파일의 크기를 디렉토리 엔트리에 저장하는 간격 (바이트)
+#if !defined(FILE_LOG_SYNC_SIZE)
+#define FILE_LOG_SYNC_SIZE		(16 * 1024)
+#endif
+
 class File
 {
 public:
@@ -17,12 +27,22 @@ public:
 	{
 		WRITE_ONLY = 0,
 		READ_ONLY,
+
+		// 기록을 계속 덧붙이는 로그 파일용 모드
+		// 파일이 없으면 만들고 파일의 끝에서부터 쓴다.
+		// 클러스터를 0으로 지워서 미리 할당하고 일정한 간격으로 파일의 크기를 저장한다.
+		// 전원이 꺼져 크기가 저장되지 않은 데이터는 다시 열 때 0이 아닌 마지막 바이트까지 찾아서 복구한다.
+		// 그러므로 기록은 0 바이트로 끝나지 않아야 하며 이 모드로 만든 파일에만 사용한다.
+		APPEND_LOG,
 	};
 
 	File(FileSystem &fileSystem);
 
 	File(FileSystem *fileSystem);
 
+	// 열린 파일은 닫고 핸들을 반환한다.
+	~File(void);
+
 	error_t initialize(void);
 
 	error_t open(const char *fileName, uint8_t mode);
@@ -45,17 +65,46 @@ public:
 
 	error_t makeFile(const char *fileName);
 
+	// 쓰기 모드로 열린 파일이 size 바이트까지 조각나지 않고 저장될 수 있도록 클러스터를 한번에 미리 할당한다.
+	// 사용되지 않은 클러스터는 파일을 닫을 때 해제된다.
+	error_t reserve(uint32_t size);
+
+	// APPEND_LOG 모드의 설정을 바꾼다. open() 전에 호출한다.
+	//
+	// uint32_t reserveSize
+	//		파일의 끝에 한번에 미리 할당할 크기(바이트)를 설정한다.
+	// uint32_t syncSize
+	//		이 크기(바이트)만큼 쓸 때마다 파일의 크기를 디렉토리 엔트리에 저장한다.
+	void setLogOption(uint32_t reserveSize, uint32_t syncSize);
+
+	// APPEND_LOG 모드에서 지금까지 쓴 섹터들과 파일의 크기를 바로 저장한다.
+	error_t sync(void);
+
 	error_t close(void);
 
 private:
 	FileSystem *mFileSystem;
 	bool mOpenFlag;
 	uint8_t *mBuffer, mOpenMode;
+	int32_t mHandle;
 	uint32_t mFileSize, mBufferCount;
+	uint32_t mReserveSize, mSyncSize, mReservedSize, mSyncedSize;
 
-	bool checkFileName(const char *fileName);
+	void lock(void);
 
-	bool bringOneName(char *des, const char **src);
+	void unlock(void);
+
+	uint32_t readData(void *des, uint32_t size);
+
+	uint32_t writeData(void *src, uint32_t size);
+
+	uint32_t writeLog(void *src, uint32_t size);
+
+	error_t openLog(void);
+
+	void clearBufferTail(void);
+
+	bool checkFileName(const char *fileName);
 
 	error_t enterDirectory(const char *name);
 
@@ -9,12 +9,13 @@
 #define YSS_POINTER_EVENT__H_
 
 #include <gui/util.h>
-#include <util/Fifo.h>
+#include <yss/Mutex.h>
 
+// 터치 장치에서 들어온 이벤트를 이벤트 처리기까지 전달하는 큐이다.
+// 끌기(TOUCH_DRAG) 이벤트가 연속되면 마지막 좌표 하나로 합치므로 빠르게 끌어도 큐에는 한 개만 남는다.
+// 누름(TOUCH_DOWN)과 뗌(TOUCH_UP) 이벤트는 합치지 않으며, 큐가 가득 차면 끌기 이벤트를 대신 버려서라도 보관한다.
 class PointerEvent
 {
-	Fifo mFifo;
-	Mutex mMutex;
 public :
 	struct PointerEventData
 	{
@@ -22,11 +23,46 @@ public :
 		uint8_t event;
 	}__PACKED;
 
+	// uint32_t bufferSize
+	//		큐에 보관할 수 있는 이벤트의 수를 설정한다.
 	PointerEvent(uint32_t bufferSize);
+
+	~PointerEvent(void);
+
+	// 이벤트를 큐에 넣는다.
+	// 끌기 이벤트이고 큐의 마지막 이벤트도 끌기이면 마지막 이벤트의 좌표만 갱신한다.
 	void push(PointerEventData &data);
+
+	// 가장 오래된 이벤트를 꺼낸다. 큐가 비어 있으면 TOUCH_UP 이벤트를 반환한다.
 	PointerEventData pop(void);
+
+	// 가장 오래된 이벤트가 끌기 이벤트일 경우에만 꺼내서 data에 덮어쓰고 합쳐진 이벤트의 수를 늘린다.
+	// 이벤트 처리기가 끌기 이벤트를 늦게 전달할 때, 기다리는 동안 들어온 끌기 이벤트를 합치는데 사용한다.
+	//
+	// PointerEventData &data
+	//		꺼낸 이벤트를 저장할 변수를 설정한다. 꺼내지 않으면 변경되지 않는다.
+	//
+	// 반환
+	//		이벤트를 꺼냈으면 true를 반환한다.
+	bool popDrag(PointerEventData &data);
+
 	uint32_t getMessageCount(void);
+
 	void flush(void);
+
+	// 큐가 가득 차서 버려진 이벤트의 수를 얻는다.
+	uint32_t getDroppedCount(void);
+
+	// 다른 끌기 이벤트와 합쳐져서 전달되지 않은 끌기 이벤트의 수를 얻는다.
+	uint32_t getCoalescedCount(void);
+
+private :
+	PointerEventData *mData;
+	Mutex mMutex;
+	uint32_t mSize, mHead, mTail, mCount;
+	uint32_t mDroppedCount, mCoalescedCount;
+
+	bool removeLastDrag(void);
 };
 
 #endif
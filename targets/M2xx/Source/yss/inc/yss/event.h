@@ -26,6 +26,12 @@ namespace event
 	void add(Position_t pos, uint8_t event);
 	void trigger(void);
 	void flush(void);
+
+	// 터치 이벤트 큐가 가득 차서 버려진 이벤트의 수를 얻는다.
+	uint32_t getDroppedCount(void);
+
+	// 다른 끌기 이벤트와 합쳐져서 전달되지 않은 끌기 이벤트의 수를 얻는다.
+	uint32_t getCoalescedCount(void);
 };
 
 #endif
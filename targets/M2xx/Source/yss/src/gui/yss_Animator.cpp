@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI && YSS_L_HEAP_USE
+
+#include <gui/Animator.h>
+#include <gui/Frame.h>
+#include <util/runtime.h>
+#include <yss/thread.h>
+
+namespace ease
+{
+	uint32_t linear(uint32_t t)
+	{
+		return t;
+	}
+
+	uint32_t inQuad(uint32_t t)
+	{
+		return (t * t) >> 15;
+	}
+
+	uint32_t outQuad(uint32_t t)
+	{
+		t = ONE - t;
+		return ONE - ((t * t) >> 15);
+	}
+
+	uint32_t inOutQuad(uint32_t t)
+	{
+		if(t < ONE / 2)
+			return (t * t) >> 14;
+
+		t = ONE - t;
+		return ONE - ((t * t) >> 14);
+	}
+
+	uint32_t inCubic(uint32_t t)
+	{
+		return (((t * t) >> 15) * t) >> 15;
+	}
+
+	uint32_t outCubic(uint32_t t)
+	{
+		t = ONE - t;
+		return ONE - ((((t * t) >> 15) * t) >> 15);
+	}
+
+	uint32_t inOutCubic(uint32_t t)
+	{
+		if(t < ONE / 2)
+			return (((t * t) >> 15) * t) >> 13;
+
+		t = ONE - t;
+		return ONE - ((((t * t) >> 15) * t) >> 13);
+	}
+}
+
+// 진행률(Q15)에 따른 from과 to 사이의 값
+static int32_t interpolate(int32_t from, int32_t to, uint32_t progress)
+{
+	return from + (((to - from) * (int32_t)(progress >> 1)) >> 14);
+}
+
+Animator::Animator(uint16_t maxTween)
+{
+	mTween = new tween_t[maxTween];
+	mMaxTween = maxTween;
+	mNumOfTween = 0;
+	mFrame = 0;
+	mNextFrame = 0;
+	setFps(30);
+}
+
+Animator::~Animator(void)
+{
+	delete[] mTween;
+}
+
+void Animator::setFrame(Frame &frame)
+{
+	mFrame = &frame;
+}
+
+void Animator::setFps(uint8_t fps)
+{
+	if(fps == 0)
+		fps = 1;
+
+	mInterval = 1000 / fps;
+}
+
+Animator::tween_t* Animator::allocate(Object &obj, uint8_t property, uint16_t duration, ease::curve_t curve)
+{
+	tween_t *tween = 0;
+
+	// 같은 객체의 같은 속성은 새 애니메이션으로 교체
+	for(uint16_t i = 0; i < mNumOfTween; i++)
+	{
+		if(mTween[i].obj == &obj && mTween[i].property == property)
+		{
+			tween = &mTween[i];
+			break;
+		}
+	}
+
+	if(tween == 0)
+	{
+		if(mNumOfTween >= mMaxTween)
+			return 0;
+		tween = &mTween[mNumOfTween++];
+	}
+
+	tween->obj = &obj;
+	tween->property = property;
+	tween->duration = duration;
+	tween->curve = curve ? curve : ease::linear;
+	tween->handler = 0;
+	tween->start = runtime::getMsec();
+
+	return tween;
+}
+
+bool Animator::moveTo(Object &obj, Position_t to, uint16_t duration, ease::curve_t curve)
+{
+	Position_t from = obj.getPosition();
+	tween_t *tween = allocate(obj, PROPERTY_POSITION, duration, curve);
+
+	if(tween == 0)
+		return false;
+
+	tween->from[0] = from.x;
+	tween->from[1] = from.y;
+	tween->to[0] = to.x;
+	tween->to[1] = to.y;
+
+	return true;
+}
+
+bool Animator::resizeTo(Object &obj, Size_t to, uint16_t duration, ease::curve_t curve)
+{
+	Size_t from = obj.getSize();
+	tween_t *tween = allocate(obj, PROPERTY_SIZE, duration, curve);
+
+	if(tween == 0)
+		return false;
+
+	tween->from[0] = from.width;
+	tween->from[1] = from.height;
+	tween->to[0] = to.width;
+	tween->to[1] = to.height;
+
+	return true;
+}
+
+bool Animator::fadeColor(Object &obj, Color from, Color to, uint16_t duration, colorHandler_t handler, ease::curve_t curve)
+{
+	uint8_t red, green, blue, alpha;
+	tween_t *tween;
+
+	if(handler == 0)
+		return false;
+
+	tween = allocate(obj, PROPERTY_COLOR, duration, curve);
+	if(tween == 0)
+		return false;
+
+	tween->handler = handler;
+
+	from.getColor(red, green, blue, alpha);
+	tween->from[0] = red;
+	tween->from[1] = green;
+	tween->from[2] = blue;
+	tween->from[3] = alpha;
+
+	to.getColor(red, green, blue, alpha);
+	tween->to[0] = red;
+	tween->to[1] = green;
+	tween->to[2] = blue;
+	tween->to[3] = alpha;
+
+	return true;
+}
+
+void Animator::stop(Object &obj)
+{
+	for(uint16_t i = 0; i < mNumOfTween;)
+	{
+		if(mTween[i].obj == &obj)
+			mTween[i] = mTween[--mNumOfTween];
+		else
+			i++;
+	}
+}
+
+bool Animator::isRunning(void)
+{
+	return mNumOfTween != 0;
+}
+
+void Animator::apply(tween_t &tween, uint32_t progress)
+{
+	int16_t value[4];
+
+	progress = tween.curve(progress);
+
+	for(uint8_t i = 0; i < 4; i++)
+		value[i] = interpolate(tween.from[i], tween.to[i], progress);
+
+	switch(tween.property)
+	{
+	case PROPERTY_POSITION :
+		tween.obj->setPosition(value[0], value[1]);
+		break;
+
+	case PROPERTY_SIZE :
+		tween.obj->setSize((uint16_t)value[0], (uint16_t)value[1]);
+		break;
+
+	case PROPERTY_COLOR :
+		tween.handler(*tween.obj, Color((uint8_t)value[0], (uint8_t)value[1], (uint8_t)value[2], (uint8_t)value[3]));
+		break;
+	}
+}
+
+bool Animator::process(void)
+{
+	uint64_t now = runtime::getMsec(), elapsed;
+	uint32_t progress;
+
+	if(mNumOfTween == 0)
+		return false;
+
+	if(now < mNextFrame)
+		return true;
+
+	// 늦어진 프레임은 몰아서 처리하지 않음
+	mNextFrame = now + mInterval;
+
+	if(mFrame)
+		mFrame->beginUpdate();
+
+	for(uint16_t i = 0; i < mNumOfTween;)
+	{
+		tween_t &tween = mTween[i];
+
+		elapsed = now - tween.start;
+		if(elapsed >= tween.duration)
+			progress = ease::ONE;
+		else
+			progress = ((uint32_t)elapsed << 15) / tween.duration;
+
+		apply(tween, progress);
+
+		// 끝난 애니메이션은 마지막 항목으로 채움
+		if(progress == ease::ONE)
+			mTween[i] = mTween[--mNumOfTween];
+		else
+			i++;
+	}
+
+	if(mFrame)
+		mFrame->endUpdate();
+
+	return mNumOfTween != 0;
+}
+
+void Animator::run(void)
+{
+	uint64_t now;
+
+	while(process())
+	{
+		now = runtime::getMsec();
+		if(now < mNextFrame)
+			thread::delay(mNextFrame - now);
+		else
+			thread::yield();
+	}
+}
+
+#endif
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/BitmapDecoder.h>
+#include <string.h>
+
+bool BitmapDecoder::isCompressed(uint8_t type)
+{
+	switch(type)
+	{
+	case TYPE_RLE565 :
+	case TYPE_INDEX8 :
+	case TYPE_INDEX4 :
+	case TYPE_INDEX2 :
+	case TYPE_INDEX1 :
+		return true;
+
+	default :
+		return false;
+	}
+}
+
+void BitmapDecoder::begin(uint16_t width, uint8_t type, const uint8_t *data)
+{
+	mWidth = width;
+	mType = type;
+	mX = 0;
+	mRemain = 0;
+	mRunFlag = false;
+
+	switch(type)
+	{
+	case TYPE_INDEX8 :
+	case TYPE_INDEX4 :
+	case TYPE_INDEX2 :
+	case TYPE_INDEX1 :
+		// TYPE_INDEX8부터 차례로 8, 4, 2, 1비트
+		mBit = 8 >> (type - TYPE_INDEX8);
+		mMask = (1 << mBit) - 1;
+		mPalette = &data[1];
+		mData = &data[1 + (data[0] + 1) * 2];
+		break;
+
+	default :
+		mPalette = 0;
+		mData = data;
+		break;
+	}
+}
+
+void BitmapDecoder::fetchToken(void)
+{
+	uint8_t token = *mData++;
+
+	mRemain = (token & 0x7F) + 1;
+	mRunFlag = (token & 0x80) == 0x80;
+
+	if(mRunFlag)
+	{
+		mDot[0] = *mData++;
+		mDot[1] = *mData++;
+	}
+}
+
+void BitmapDecoder::read(void *des, uint32_t count)
+{
+	uint8_t *des8 = (uint8_t*)des;
+	const uint8_t *color;
+	uint32_t num;
+
+	switch(mType)
+	{
+	case TYPE_RLE565 :
+		while(count)
+		{
+			if(mRemain == 0)
+				fetchToken();
+
+			num = count < mRemain ? count : mRemain;
+			count -= num;
+			mRemain -= num;
+
+			if(mRunFlag)
+			{
+				while(num--)
+				{
+					*des8++ = mDot[0];
+					*des8++ = mDot[1];
+				}
+			}
+			else
+			{
+				memcpy(des8, mData, num * 2);
+				des8 += num * 2;
+				mData += num * 2;
+			}
+		}
+		break;
+
+	case TYPE_INDEX8 :
+		while(count--)
+		{
+			color = &mPalette[*mData++ * 2];
+			*des8++ = color[0];
+			*des8++ = color[1];
+		}
+		break;
+
+	case TYPE_INDEX4 :
+	case TYPE_INDEX2 :
+	case TYPE_INDEX1 :
+		while(count--)
+		{
+			color = &mPalette[((*mData >> ((mX * mBit) & 0x07)) & mMask) * 2];
+
+			*des8++ = color[0];
+			*des8++ = color[1];
+
+			// 바이트의 마지막 점 또는 줄의 마지막 점이면 다음 바이트로 이동
+			mX++;
+			if(((mX * mBit) & 0x07) == 0 || mX == mWidth)
+				mData++;
+			if(mX == mWidth)
+				mX = 0;
+		}
+		break;
+	}
+}
+
+void BitmapDecoder::readIndex(uint8_t *des, uint32_t count)
+{
+	switch(mType)
+	{
+	case TYPE_INDEX8 :
+		memcpy(des, mData, count);
+		mData += count;
+		break;
+
+	case TYPE_INDEX4 :
+	case TYPE_INDEX2 :
+	case TYPE_INDEX1 :
+		while(count--)
+		{
+			*des++ = (*mData >> ((mX * mBit) & 0x07)) & mMask;
+
+			mX++;
+			if(((mX * mBit) & 0x07) == 0 || mX == mWidth)
+				mData++;
+			if(mX == mWidth)
+				mX = 0;
+		}
+		break;
+	}
+}
+
+void BitmapDecoder::skip(uint32_t count)
+{
+	uint32_t num;
+
+	switch(mType)
+	{
+	case TYPE_RLE565 :
+		while(count)
+		{
+			if(mRemain == 0)
+				fetchToken();
+
+			num = count < mRemain ? count : mRemain;
+			count -= num;
+			mRemain -= num;
+
+			if(!mRunFlag)
+				mData += num * 2;
+		}
+		break;
+
+	case TYPE_INDEX8 :
+		mData += count;
+		break;
+
+	case TYPE_INDEX4 :
+	case TYPE_INDEX2 :
+	case TYPE_INDEX1 :
+		// 줄 단위로 건너뛸 수 있는 부분은 한 번에 건너뜀
+		if(mX == 0 && count >= mWidth)
+		{
+			num = count / mWidth;
+			mData += num * ((mWidth * mBit + 7) / 8);
+			count -= num * mWidth;
+		}
+
+		while(count--)
+		{
+			mX++;
+			if(((mX * mBit) & 0x07) == 0 || mX == mWidth)
+				mData++;
+			if(mX == mWidth)
+				mX = 0;
+		}
+		break;
+	}
+}
+
+#endif
+
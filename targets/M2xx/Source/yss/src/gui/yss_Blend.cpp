@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/Blend.h>
+
+// 두 점이 들어있는 32비트 워드 w를 아래와 같이 두 개의 레인으로 나눈다.
+// 각 성분의 위에 5비트 이상의 여유가 있으므로 0 ~ 32의 알파 값을 곱해도 옆 성분을 침범하지 않는다.
+//
+// RGB565
+//		lane0 = w & 0x07E0F81F        : 점0[4:0], 점0[15:11], 점1[10:5]
+//		lane1 = (w >> 5) & 0x07C0F83F : 점0[10:5], 점1[4:0], 점1[15:11]
+// ARGB1555
+//		lane0 = w & 0x03E07C1F        : 점0[4:0], 점0[14:10], 점1[9:5]
+//		lane1 = (w >> 5) & 0x03E0F81F : 점0[9:5], 점1[4:0], 점1[14:10]
+//
+// 점 하나만 합성할 때는 (p | p << 16) & lane0 으로 한 점의 성분을 하나의 레인에 펼친다.
+// round0, round1은 각 성분의 최하위 위치에 16을 더해 >> 5 의 결과가 반올림 되도록 한다.
+
+namespace blend
+{
+	static const uint32_t RGB565_LANE0 = 0x07E0F81F;
+	static const uint32_t RGB565_LANE1 = 0x07C0F83F;
+	static const uint32_t RGB565_ROUND0 = 0x02008010;
+	static const uint32_t RGB565_ROUND1 = 0x04008010;
+
+	static const uint32_t ARGB1555_LANE0 = 0x03E07C1F;
+	static const uint32_t ARGB1555_LANE1 = 0x03E0F81F;
+	static const uint32_t ARGB1555_ROUND0 = 0x02004010;
+	static const uint32_t ARGB1555_ROUND1 = 0x02008010;
+
+	static inline uint16_t swapByte(uint16_t data)
+	{
+		return (data >> 8) | (data << 8);
+	}
+
+	static inline uint32_t swapHalfword(uint32_t data)
+	{
+		return ((data & 0xFF00FF00) >> 8) | ((data & 0x00FF00FF) << 8);
+	}
+
+	// 0 ~ 255의 알파 값을 0 ~ 32로 바꾼다.
+	static inline uint32_t getAlpha32(uint8_t alpha)
+	{
+		return (alpha + 4) >> 3;
+	}
+
+	// 0 ~ 15의 농도를 0 ~ 32로 바꾼다.
+	static inline uint32_t getLevelAlpha32(uint8_t level)
+	{
+		return (level << 1) + ((level + 1) >> 3);
+	}
+
+	static inline uint8_t getLevel(const uint8_t *mask, uint32_t index)
+	{
+		return (mask[index >> 1] >> ((index & 0x01) << 2)) & 0x0F;
+	}
+
+	// 한 점을 합성한다. des와 src는 바이트 순서가 정리된 값이다.
+	static inline uint16_t blendDot(uint16_t des, uint16_t src, uint32_t a, uint32_t lane, uint32_t round)
+	{
+		uint32_t d = (des | (uint32_t)des << 16) & lane;
+		uint32_t s = (src | (uint32_t)src << 16) & lane;
+
+		d = ((s * a + d * (32 - a) + round) >> 5) & lane;
+		return d | d >> 16;
+	}
+
+	// 같은 알파 값으로 두 점을 합성한다.
+	// src0, src1은 원본의 각 레인에 알파 값을 곱하고 반올림 값을 더해둔 값이다.
+	static inline uint32_t blendPair(uint32_t des, uint32_t src0, uint32_t src1, uint32_t inv, uint32_t lane0, uint32_t lane1)
+	{
+		uint32_t buf0 = (((des & lane0) * inv + src0) >> 5) & lane0;
+		uint32_t buf1 = ((((des >> 5) & lane1) * inv + src1) >> 5) & lane1;
+
+		return buf0 | buf1 << 5;
+	}
+
+	static void blendColor(uint16_t *des, uint16_t color, uint8_t alpha, uint32_t count, bool swap, uint32_t lane0, uint32_t lane1, uint32_t round0, uint32_t round1, uint16_t alphaBit)
+	{
+		uint32_t a = getAlpha32(alpha), inv = 32 - a, pair, src0, src1, alphaPair = alphaBit | (uint32_t)alphaBit << 16;
+		uint32_t *des32;
+
+		if(a == 0 || count == 0)
+			return;
+
+		if(swap)
+			color = swapByte(color);
+
+		pair = color | (uint32_t)color << 16;
+		src0 = (pair & lane0) * a + round0;
+		src1 = ((pair >> 5) & lane1) * a + round1;
+
+		// 대상을 4바이트 정렬
+		if((uintptr_t)des & 0x02)
+		{
+			pair = swap ? swapByte(*des) : *des;
+			pair = blendDot(pair, color, a, lane0, round0) | alphaBit;
+			*des++ = swap ? swapByte(pair) : pair;
+			count--;
+		}
+
+		des32 = (uint32_t*)des;
+
+		if(swap)
+		{
+			while(count >= 2)
+			{
+				pair = swapHalfword(*des32);
+				pair = blendPair(pair, src0, src1, inv, lane0, lane1) | alphaPair;
+				*des32++ = swapHalfword(pair);
+				count -= 2;
+			}
+		}
+		else
+		{
+			while(count >= 2)
+			{
+				*des32 = blendPair(*des32, src0, src1, inv, lane0, lane1) | alphaPair;
+				des32++;
+				count -= 2;
+			}
+		}
+
+		if(count)
+		{
+			des = (uint16_t*)des32;
+			pair = swap ? swapByte(*des) : *des;
+			pair = blendDot(pair, color, a, lane0, round0) | alphaBit;
+			*des = swap ? swapByte(pair) : pair;
+		}
+	}
+
+	static void blendLine(uint16_t *des, const uint16_t *src, const uint8_t *alpha, uint32_t count, bool swap, uint32_t lane, uint32_t round, uint16_t alphaBit)
+	{
+		uint32_t a;
+		uint16_t dot;
+
+		if(swap)
+			alphaBit = swapByte(alphaBit);
+
+		while(count--)
+		{
+			a = getAlpha32(*alpha++);
+
+			if(a == 32)
+				*des = *src | alphaBit;
+			else if(a)
+			{
+				if(swap)
+				{
+					dot = blendDot(swapByte(*des), swapByte(*src), a, lane, round);
+					*des = swapByte(dot) | alphaBit;
+				}
+				else
+					*des = blendDot(*des, *src, a, lane, round) | alphaBit;
+			}
+
+			des++;
+			src++;
+		}
+	}
+
+	static void blendMask(uint16_t *des, uint16_t color, const uint8_t *mask, uint32_t count, bool swap, uint32_t lane0, uint32_t lane1, uint32_t round0, uint32_t round1, uint16_t alphaBit)
+	{
+		uint32_t index = 0, a, inv, pair, colorPair, src0, src1, alphaPair = alphaBit | (uint32_t)alphaBit << 16;
+		uint32_t *des32;
+		uint8_t level0, level1;
+
+		if(count == 0)
+			return;
+
+		if(swap)
+			color = swapByte(color);
+
+		color |= alphaBit;
+		colorPair = color | (uint32_t)color << 16;
+
+		// 대상을 4바이트 정렬
+		if((uintptr_t)des & 0x02)
+		{
+			level0 = getLevel(mask, index++);
+			if(level0)
+			{
+				pair = swap ? swapByte(*des) : *des;
+				pair = blendDot(pair, color, getLevelAlpha32(level0), lane0, round0) | alphaBit;
+				*des = swap ? swapByte(pair) : pair;
+			}
+			des++;
+			count--;
+		}
+
+		des32 = (uint32_t*)des;
+
+		while(count >= 2)
+		{
+			level0 = getLevel(mask, index++);
+			level1 = getLevel(mask, index++);
+			count -= 2;
+
+			// 문자의 대부분을 차지하는 빈 점과 꽉 찬 점은 합성하지 않음
+			if((level0 | level1) == 0)
+			{
+				des32++;
+				continue;
+			}
+
+			if(level0 == 0x0F && level1 == 0x0F)
+			{
+				*des32++ = swap ? swapHalfword(colorPair) : colorPair;
+				continue;
+			}
+
+			pair = swap ? swapHalfword(*des32) : *des32;
+
+			if(level0 == level1)
+			{
+				a = getLevelAlpha32(level0);
+				inv = 32 - a;
+				src0 = (colorPair & lane0) * a + round0;
+				src1 = ((colorPair >> 5) & lane1) * a + round1;
+				pair = blendPair(pair, src0, src1, inv, lane0, lane1) | alphaPair;
+			}
+			else
+			{
+				src0 = pair & 0xFFFF;
+				src1 = pair >> 16;
+
+				if(level0)
+					src0 = blendDot(src0, color, getLevelAlpha32(level0), lane0, round0) | alphaBit;
+				if(level1)
+					src1 = blendDot(src1, color, getLevelAlpha32(level1), lane0, round0) | alphaBit;
+
+				pair = src0 | src1 << 16;
+			}
+
+			*des32++ = swap ? swapHalfword(pair) : pair;
+		}
+
+		if(count)
+		{
+			level0 = getLevel(mask, index);
+			if(level0)
+			{
+				des = (uint16_t*)des32;
+				pair = swap ? swapByte(*des) : *des;
+				pair = blendDot(pair, color, getLevelAlpha32(level0), lane0, round0) | alphaBit;
+				*des = swap ? swapByte(pair) : pair;
+			}
+		}
+	}
+
+	void blendColorRgb565(uint16_t *des, uint16_t color, uint8_t alpha, uint32_t count, bool swap)
+	{
+		blendColor(des, color, alpha, count, swap, RGB565_LANE0, RGB565_LANE1, RGB565_ROUND0, RGB565_ROUND1, 0);
+	}
+
+	void blendLineRgb565(uint16_t *des, const uint16_t *src, const uint8_t *alpha, uint32_t count, bool swap)
+	{
+		blendLine(des, src, alpha, count, swap, RGB565_LANE0, RGB565_ROUND0, 0);
+	}
+
+	void blendMaskRgb565(uint16_t *des, uint16_t color, const uint8_t *mask, uint32_t count, bool swap)
+	{
+		blendMask(des, color, mask, count, swap, RGB565_LANE0, RGB565_LANE1, RGB565_ROUND0, RGB565_ROUND1, 0);
+	}
+
+	void blendColorArgb1555(uint16_t *des, uint16_t color, uint8_t alpha, uint32_t count, bool swap)
+	{
+		blendColor(des, color, alpha, count, swap, ARGB1555_LANE0, ARGB1555_LANE1, ARGB1555_ROUND0, ARGB1555_ROUND1, 0x8000);
+	}
+
+	void blendLineArgb1555(uint16_t *des, const uint16_t *src, const uint8_t *alpha, uint32_t count, bool swap)
+	{
+		blendLine(des, src, alpha, count, swap, ARGB1555_LANE0, ARGB1555_ROUND0, 0x8000);
+	}
+
+	void blendMaskArgb1555(uint16_t *des, uint16_t color, const uint8_t *mask, uint32_t count, bool swap)
+	{
+		blendMask(des, color, mask, count, swap, ARGB1555_LANE0, ARGB1555_LANE1, ARGB1555_ROUND0, ARGB1555_ROUND1, 0x8000);
+	}
+
+	// RGB888은 R과 B를 한 워드(0x00FF00FF)에, G를 따로 합성한다. 알파 값은 0 ~ 256을 사용한다.
+	// rb, g는 원본 성분에 알파 값을 곱하고 반올림 값을 더해둔 값이다.
+	static inline void blendDot888(uint8_t *des, uint32_t rb, uint32_t g, uint32_t inv)
+	{
+		uint32_t buf = (uint32_t)des[2] << 16 | des[0];
+
+		buf = ((buf * inv + rb) >> 8) & 0x00FF00FF;
+		des[0] = buf;
+		des[1] = (des[1] * inv + g) >> 8;
+		des[2] = buf >> 16;
+	}
+
+	void blendColorRgb888(uint8_t *des, uint32_t color, uint8_t alpha, uint32_t count)
+	{
+		uint32_t a = alpha + (alpha >> 7), inv = 256 - a;
+		uint32_t rb = (color & 0x00FF00FF) * a + 0x00800080, g = ((color >> 8) & 0xFF) * a + 0x80;
+
+		if(a == 0)
+			return;
+
+		while(count--)
+		{
+			blendDot888(des, rb, g, inv);
+			des += 3;
+		}
+	}
+
+	void blendLineRgb888(uint8_t *des, const uint8_t *src, const uint8_t *alpha, uint32_t count)
+	{
+		uint32_t a;
+
+		while(count--)
+		{
+			a = *alpha + (*alpha >> 7);
+			alpha++;
+
+			if(a == 256)
+			{
+				des[0] = src[0];
+				des[1] = src[1];
+				des[2] = src[2];
+			}
+			else if(a)
+				blendDot888(des, ((uint32_t)src[2] << 16 | src[0]) * a + 0x00800080, src[1] * a + 0x80, 256 - a);
+
+			des += 3;
+			src += 3;
+		}
+	}
+
+	void blendMaskRgb888(uint8_t *des, uint32_t color, const uint8_t *mask, uint32_t count)
+	{
+		uint32_t rb = color & 0x00FF00FF, g = (color >> 8) & 0xFF, a;
+		uint8_t level;
+
+		for(uint32_t i = 0; i < count; i++)
+		{
+			level = getLevel(mask, i);
+
+			if(level == 0x0F)
+			{
+				des[0] = color;
+				des[1] = color >> 8;
+				des[2] = color >> 16;
+			}
+			else if(level)
+			{
+				a = level * 17 + (level >> 3);
+				blendDot888(des, rb * a + 0x00800080, g * a + 0x80, 256 - a);
+			}
+
+			des += 3;
+		}
+	}
+}
+
+#endif
+
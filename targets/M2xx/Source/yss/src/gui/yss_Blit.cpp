@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/Blit.h>
+#include <gui/Convert.h>
+#include <gui/FrameBuffer.h>
+#include <gui/Color.h>
+
+namespace blit
+{
+	// 16비트 점을 Color의 형식으로 바꾸기 위한 정보
+	// 변환 계산은 R이 상위인 CPU 순서(R[15:11])로 하고 16비트 점을 읽거나 쓸 때에만 형식을 바꾼다.
+	struct Order
+	{
+		bool reverseRgb;
+		bool reverseEndian;
+	};
+
+	static inline Order getOrder(void)
+	{
+		return Order{!Color::getReverseRgbOrder(), !Color::getLittleEndian()};
+	}
+
+	static inline bool isNativeOrder(Order order)
+	{
+		return !order.reverseRgb && !order.reverseEndian;
+	}
+
+	static inline bool isSupportedMode(uint8_t desColorMode)
+	{
+		switch(desColorMode)
+		{
+		case FrameBuffer::COLOR_MODE_RGB565 :
+		case FrameBuffer::COLOR_MODE_ARGB1555 :
+		case FrameBuffer::COLOR_MODE_RGB888 :
+			return true;
+
+		default :
+			return false;
+		}
+	}
+
+	static inline uint16_t swapByte(uint16_t dot)
+	{
+		return (uint16_t)(dot >> 8 | dot << 8);
+	}
+
+	static inline uint16_t swapRgb565(uint16_t dot)
+	{
+		return (uint16_t)((dot & 0x07E0) | (dot >> 11) | (dot << 11));
+	}
+
+	static inline uint16_t swapArgb1555(uint16_t dot)
+	{
+		return (uint16_t)((dot & 0x83E0) | ((dot >> 10) & 0x001F) | ((dot & 0x001F) << 10));
+	}
+
+	// R이 상위인 점을 Color의 형식으로 바꾼다.
+	static inline uint16_t encodeRgb565(uint16_t dot, Order order)
+	{
+		if(order.reverseRgb)
+			dot = swapRgb565(dot);
+		if(order.reverseEndian)
+			dot = swapByte(dot);
+		return dot;
+	}
+
+	static inline uint16_t encodeArgb1555(uint16_t dot, Order order)
+	{
+		if(order.reverseRgb)
+			dot = swapArgb1555(dot);
+		if(order.reverseEndian)
+			dot = swapByte(dot);
+		return dot;
+	}
+
+	// Color 형식의 점을 R이 상위인 점으로 바꾼다.
+	static inline uint16_t decodeRgb565(uint16_t dot, Order order)
+	{
+		if(order.reverseEndian)
+			dot = swapByte(dot);
+		if(order.reverseRgb)
+			dot = swapRgb565(dot);
+		return dot;
+	}
+
+	static inline uint16_t decodeArgb1555(uint16_t dot, Order order)
+	{
+		if(order.reverseEndian)
+			dot = swapByte(dot);
+		if(order.reverseRgb)
+			dot = swapArgb1555(dot);
+		return dot;
+	}
+
+	static inline uint16_t convertRgb888ToRgb565(const uint8_t *src)
+	{
+		return ((uint16_t)(src[2] & 0xF8) << 8) | ((uint16_t)(src[1] & 0xFC) << 3) | (src[0] >> 3);
+	}
+
+	static inline uint16_t convertRgb888ToArgb1555(const uint8_t *src)
+	{
+		return 0x8000 | ((uint16_t)(src[2] & 0xF8) << 7) | ((uint16_t)(src[1] & 0xF8) << 2) | (src[0] >> 3);
+	}
+
+	static inline uint16_t convertRgb565ToArgb1555(uint16_t dot)
+	{
+		return 0x8000 | ((dot >> 1) & 0x7FE0) | (dot & 0x001F);
+	}
+
+	static inline uint16_t convertArgb1555ToRgb565(uint16_t dot)
+	{
+		return ((dot << 1) & 0xFFC0) | ((dot >> 4) & 0x0020) | (dot & 0x001F);
+	}
+
+	static inline void convertRgb565ToRgb888(uint8_t *des, uint16_t dot)
+	{
+		uint8_t buf;
+
+		buf = dot & 0x1F;
+		des[0] = (buf << 3) | (buf >> 2);
+		buf = (dot >> 5) & 0x3F;
+		des[1] = (buf << 2) | (buf >> 4);
+		buf = dot >> 11;
+		des[2] = (buf << 3) | (buf >> 2);
+	}
+
+	static inline void convertArgb1555ToRgb888(uint8_t *des, uint16_t dot)
+	{
+		uint8_t buf;
+
+		buf = dot & 0x1F;
+		des[0] = (buf << 3) | (buf >> 2);
+		buf = (dot >> 5) & 0x1F;
+		des[1] = (buf << 3) | (buf >> 2);
+		buf = (dot >> 10) & 0x1F;
+		des[2] = (buf << 3) | (buf >> 2);
+	}
+
+	static inline uint32_t readRgb888(const uint8_t *src)
+	{
+		return (uint32_t)src[2] << 16 | (uint32_t)src[1] << 8 | src[0];
+	}
+
+	static void copyLineFromRgb565(uint8_t *des, uint8_t desColorMode, const uint16_t *src, uint16_t count, bool keyFlag, uint16_t key)
+	{
+		uint16_t *des16 = (uint16_t*)des;
+		Order order = getOrder();
+
+		switch(desColorMode)
+		{
+		case FrameBuffer::COLOR_MODE_RGB565 :
+			while(count--)
+			{
+				if(!keyFlag || *src != key)
+					*des16 = *src;
+				des16++;
+				src++;
+			}
+			break;
+
+		case FrameBuffer::COLOR_MODE_ARGB1555 :
+			while(count--)
+			{
+				if(!keyFlag || *src != key)
+					*des16 = encodeArgb1555(convertRgb565ToArgb1555(decodeRgb565(*src, order)), order);
+				des16++;
+				src++;
+			}
+			break;
+
+		case FrameBuffer::COLOR_MODE_RGB888 :
+			while(count--)
+			{
+				if(!keyFlag || *src != key)
+					convertRgb565ToRgb888(des, decodeRgb565(*src, order));
+				des += 3;
+				src++;
+			}
+			break;
+		}
+	}
+
+	static void copyLineFromRgb888(uint8_t *des, uint8_t desColorMode, const uint8_t *src, uint16_t count, bool keyFlag, uint32_t key)
+	{
+		uint16_t *des16 = (uint16_t*)des;
+		Order order = getOrder();
+
+		switch(desColorMode)
+		{
+		case FrameBuffer::COLOR_MODE_RGB565 :
+			while(count--)
+			{
+				if(!keyFlag || readRgb888(src) != key)
+					*des16 = encodeRgb565(convertRgb888ToRgb565(src), order);
+				des16++;
+				src += 3;
+			}
+			break;
+
+		case FrameBuffer::COLOR_MODE_ARGB1555 :
+			while(count--)
+			{
+				if(!keyFlag || readRgb888(src) != key)
+					*des16 = encodeArgb1555(convertRgb888ToArgb1555(src), order);
+				des16++;
+				src += 3;
+			}
+			break;
+
+		case FrameBuffer::COLOR_MODE_RGB888 :
+			while(count--)
+			{
+				if(!keyFlag || readRgb888(src) != key)
+				{
+					des[0] = src[0];
+					des[1] = src[1];
+					des[2] = src[2];
+				}
+				des += 3;
+				src += 3;
+			}
+			break;
+		}
+	}
+
+	static void copyLineFromArgb1555(uint8_t *des, uint8_t desColorMode, const uint16_t *src, uint16_t count, bool keyFlag, uint16_t key)
+	{
+		uint16_t *des16 = (uint16_t*)des;
+		Order order = getOrder();
+		uint16_t dot;
+
+		switch(desColorMode)
+		{
+		case FrameBuffer::COLOR_MODE_RGB565 :
+			while(count--)
+			{
+				dot = decodeArgb1555(*src, order);
+				if((dot & 0x8000) && (!keyFlag || *src != key))
+					*des16 = encodeRgb565(convertArgb1555ToRgb565(dot), order);
+				des16++;
+				src++;
+			}
+			break;
+
+		case FrameBuffer::COLOR_MODE_ARGB1555 :
+			while(count--)
+			{
+				dot = decodeArgb1555(*src, order);
+				if((dot & 0x8000) && (!keyFlag || *src != key))
+					*des16 = *src;
+				des16++;
+				src++;
+			}
+			break;
+
+		case FrameBuffer::COLOR_MODE_RGB888 :
+			while(count--)
+			{
+				dot = decodeArgb1555(*src, order);
+				if((dot & 0x8000) && (!keyFlag || *src != key))
+					convertArgb1555ToRgb888(des, dot);
+				des += 3;
+				src++;
+			}
+			break;
+		}
+	}
+
+	void copyLine(void *des, const void *src, uint32_t size)
+	{
+		uint8_t *des8 = (uint8_t*)des;
+		const uint8_t *src8 = (const uint8_t*)src;
+
+		// 4바이트 정렬이 가능하면 앞부분을 정렬한 후 4 워드씩 복사
+		if((((uintptr_t)des8 ^ (uintptr_t)src8) & 0x03) == 0)
+		{
+			while(((uintptr_t)des8 & 0x03) && size)
+			{
+				*des8++ = *src8++;
+				size--;
+			}
+
+			uint32_t *des32 = (uint32_t*)des8;
+			const uint32_t *src32 = (const uint32_t*)src8;
+
+			while(size >= 16)
+			{
+				des32[0] = src32[0];
+				des32[1] = src32[1];
+				des32[2] = src32[2];
+				des32[3] = src32[3];
+				des32 += 4;
+				src32 += 4;
+				size -= 16;
+			}
+
+			while(size >= 4)
+			{
+				*des32++ = *src32++;
+				size -= 4;
+			}
+
+			des8 = (uint8_t*)des32;
+			src8 = (const uint8_t*)src32;
+		}
+		// 2바이트 정렬만 가능하면 2바이트 단위로 복사
+		else if((((uintptr_t)des8 ^ (uintptr_t)src8) & 0x01) == 0)
+		{
+			if(((uintptr_t)des8 & 0x01) && size)
+			{
+				*des8++ = *src8++;
+				size--;
+			}
+
+			uint16_t *des16 = (uint16_t*)des8;
+			const uint16_t *src16 = (const uint16_t*)src8;
+
+			while(size >= 2)
+			{
+				*des16++ = *src16++;
+				size -= 2;
+			}
+
+			des8 = (uint8_t*)des16;
+			src8 = (const uint8_t*)src16;
+		}
+
+		while(size--)
+			*des8++ = *src8++;
+	}
+
+	bool convertLine(void *des, uint8_t desColorMode, const void *src, uint8_t srcType, uint16_t count)
+	{
+		Order order = getOrder();
+
+		if(!isSupportedMode(desColorMode))
+			return false;
+
+		switch(srcType)
+		{
+		case 0 : // RGB565
+			// convert의 줄 단위 함수는 R이 상위인 형식만 처리하므로 그 외의 형식은 점 단위로 변환
+			if(desColorMode == FrameBuffer::COLOR_MODE_RGB565)
+				copyLine(des, src, count * 2);
+			else if(!isNativeOrder(order))
+				copyLineFromRgb565((uint8_t*)des, desColorMode, (const uint16_t*)src, count, false, 0);
+			else if(desColorMode == FrameBuffer::COLOR_MODE_RGB888)
+				convert::rgb565ToRgb888((uint8_t*)des, (const uint16_t*)src, count);
+			else if(desColorMode == FrameBuffer::COLOR_MODE_ARGB1555)
+				convert::rgb565ToArgb1555((uint16_t*)des, (const uint16_t*)src, count);
+			return true;
+
+		case 1 : // RGB888
+			if(desColorMode == FrameBuffer::COLOR_MODE_RGB888)
+				copyLine(des, src, count * 3);
+			else if(desColorMode == FrameBuffer::COLOR_MODE_RGB565)
+			{
+				convert::rgb888ToRgb565((uint16_t*)des, (const uint8_t*)src, count);
+				if(!isNativeOrder(order))
+					convert::reorderRgb565((uint16_t*)des, (const uint16_t*)des, count, order.reverseRgb, order.reverseEndian);
+			}
+			else
+				copyLineFromRgb888((uint8_t*)des, desColorMode, (const uint8_t*)src, count, false, 0);
+			return true;
+
+		case 2 : // ARGB1555
+			copyLineFromArgb1555((uint8_t*)des, desColorMode, (const uint16_t*)src, count, false, 0);
+			return true;
+
+		default :
+			return false;
+		}
+	}
+
+	bool convertLineWithColorKey(void *des, uint8_t desColorMode, const void *src, uint8_t srcType, uint16_t count, uint32_t colorKey)
+	{
+		if(!isSupportedMode(desColorMode))
+			return false;
+
+		switch(srcType)
+		{
+		case 0 : // RGB565
+			copyLineFromRgb565((uint8_t*)des, desColorMode, (const uint16_t*)src, count, true, colorKey);
+			return true;
+
+		case 1 : // RGB888
+			copyLineFromRgb888((uint8_t*)des, desColorMode, (const uint8_t*)src, count, true, colorKey & 0x00FFFFFF);
+			return true;
+
+		case 2 : // ARGB1555
+			copyLineFromArgb1555((uint8_t*)des, desColorMode, (const uint16_t*)src, count, true, colorKey);
+			return true;
+
+		default :
+			return false;
+		}
+	}
+
+	uint32_t convertDot(uint8_t desColorMode, const void *src, uint8_t srcType)
+	{
+		uint32_t code = 0;
+		uint8_t buf[3];
+		const uint8_t *src8 = (const uint8_t*)src;
+		Order order = getOrder();
+
+		switch(srcType)
+		{
+		case 0 : // RGB565
+			convertRgb565ToRgb888(buf, decodeRgb565(src8[0] | src8[1] << 8, order));
+			break;
+
+		case 1 : // RGB888
+			buf[0] = src8[0];
+			buf[1] = src8[1];
+			buf[2] = src8[2];
+			break;
+
+		case 2 : // ARGB1555
+			convertArgb1555ToRgb888(buf, decodeArgb1555(src8[0] | src8[1] << 8, order));
+			break;
+
+		default :
+			return 0;
+		}
+
+		switch(desColorMode)
+		{
+		case FrameBuffer::COLOR_MODE_RGB565 :
+			code = encodeRgb565(convertRgb888ToRgb565(buf), order);
+			break;
+
+		case FrameBuffer::COLOR_MODE_ARGB1555 :
+			code = encodeArgb1555(convertRgb888ToArgb1555(buf), order);
+			break;
+
+		case FrameBuffer::COLOR_MODE_RGB888 :
+			code = readRgb888(buf);
+			break;
+		}
+
+		return code;
+	}
+
+	uint8_t getSourceDotSize(uint8_t srcType)
+	{
+		switch(srcType)
+		{
+		case 0 : // RGB565
+		case 2 : // ARGB1555
+			return 2;
+
+		case 1 : // RGB888
+			return 3;
+
+		default :
+			return 0;
+		}
+	}
+}
+
+#endif
+
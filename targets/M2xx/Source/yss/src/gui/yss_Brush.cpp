@@ -14,6 +14,12 @@
 #include <gui/Bmp1555.h>
 #include <gui/Bmp565.h>
 #include <gui/Bmp888.h>
+#include <gui/Blit.h>
+#include <gui/Convert.h>
+#include <gui/Blend.h>
+#include <gui/BitmapDecoder.h>
+#include <gui/Palette.h>
+#include <string.h>
 
 #define PI (float)3.14159265358979323846
 
@@ -22,6 +28,12 @@ Brush::Brush(void)
 	mSize.height = 0;
 	mSize.width = 0;
 	mFont = 0;
+	mGlyphCache = 0;
+	mTextLayout = 0;
+	mColorKey = 0;
+	mColorKeyFlag = false;
+	mDitherFlag = false;
+	mFontBlendFlag = false;
 	
 	mBrushColorCode = 0x00;
 	mFontColor.setToBlack();
@@ -80,6 +92,13 @@ void Brush::setBrushColor(Color color)
 	case COLOR_MODE_ARGB1555 :
 		mBrushColorCode = color.getArgb1555Code();
 		break;
+
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		mBrushColorCode = findPaletteIndex(color);
+		break;
 	}
 }
 
@@ -106,6 +125,13 @@ void Brush::setBackgroundColor(Color color)
 	case COLOR_MODE_ARGB1555 :
 		mBgColorCode = color.getArgb1555Code();
 		break;
+
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		mBgColorCode = findPaletteIndex(color);
+		break;
 	}
 
 	updateFontColor();
@@ -128,6 +154,13 @@ void Brush::setBrushColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t alph
 	case COLOR_MODE_ARGB1555 :
 		mBrushColorCode = color.getArgb1555Code();
 		break;
+
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		mBrushColorCode = findPaletteIndex(color);
+		break;
 	}
 }
 
@@ -154,6 +187,13 @@ void Brush::setBackgroundColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t
 	case COLOR_MODE_ARGB1555 :
 		mBgColorCode = mBgColor.getArgb1555Code();
 		break;
+
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		mBgColorCode = findPaletteIndex(mBgColor);
+		break;
 	}
 
 	updateFontColor();
@@ -342,6 +382,19 @@ uint16_t Brush::drawString(Position_t pos, const char *str)
 	if(mFont == 0)
 		return 0;
 
+	// 캐시된 배치 결과의 위치에 문자만 그림
+	TextLayout::run_t *run = mTextLayout ? mTextLayout->find(mFont, str) : 0;
+	if(run)
+	{
+		for(uint16_t i = 0; i < run->numOfGlyph; i++)
+		{
+			if(run->glyph[i].fontInfo)
+				drawChar(Position_t{(int16_t)(pos.x + run->glyph[i].x), pos.y}, run->glyph[i].utf8);
+		}
+
+		return pos.x + run->advance;
+	}
+
 	uint8_t width, charWidth = mFont->getCharWidth(), spaceWidth = mFont->getSpaceWidth();
 
 	if (charWidth)
@@ -386,6 +439,10 @@ Size_t Brush::calculateStringSize(const char *str)
 		return Size_t{0, 0};
 
 	Size_t size;
+	TextLayout::run_t *run = mTextLayout ? mTextLayout->find(mFont, str) : 0;
+
+	if(run)
+		return run->size;
 
 	size.width = mFont->getStringWidth(str);
 	size.height = mFont->getStringHeight();
@@ -606,6 +663,12 @@ void Brush::fillRect(Position_t pos, Size_t size, Color color)
 	case COLOR_MODE_RGB565 :
 		fillRectBase(pos, size, color.getRgb565Code());
 		break;
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		fillRectBase(pos, size, findPaletteIndex(color));
+		break;
 	default :
 		return;
 	}
@@ -651,11 +714,240 @@ void Brush::clear(void)
 	eraseRectangle(Position_t{0, 0}, mSize);
 }
 
+void Brush::setColorKey(uint32_t code)
+{
+	mColorKey = code;
+}
+
+void Brush::enableColorKey(bool en)
+{
+	mColorKeyFlag = en;
+}
+
+void Brush::enableDithering(bool en)
+{
+	mDitherFlag = en;
+}
+
+void Brush::drawBitmapData(Position_t pos, uint16_t width, uint16_t height, uint8_t type, const uint8_t *data)
+{
+	uint8_t srcDotSize = blit::getSourceDotSize(type);
+	int32_t srcLine = width * srcDotSize, buf;
+	uint8_t *des;
+
+	if(BitmapDecoder::isCompressed(type))
+	{
+		drawCompressedBitmapData(pos, width, height, type, data);
+		return;
+	}
+
+	if(srcDotSize == 0 || data == 0)
+		return;
+
+	// 좌표가 대상 밖이면 리턴
+	if (pos.x >= mSize.width ||
+		pos.y >= mSize.height ||
+		pos.x + width <= 0 ||
+		pos.y + height <= 0)
+		return;
+
+	// 대상 영역 밖의 부분을 잘라냄
+	if (pos.y < 0)
+	{
+		buf = pos.y * -1;
+		data += srcLine * buf;
+		height -= buf;
+		pos.y = 0;
+	}
+
+	if (pos.x < 0)
+	{
+		buf = pos.x * -1;
+		data += srcDotSize * buf;
+		width -= buf;
+		pos.x = 0;
+	}
+
+	buf = (pos.y + height) - mSize.height;
+	if (buf > 0)
+		height -= buf;
+
+	buf = (pos.x + width) - mSize.width;
+	if (buf > 0)
+		width -= buf;
+
+	// 프레임 버퍼 메모리가 없는 브러쉬와 팔레트 방식은 점 단위로 그림
+	if(mFrameBuffer == 0 || isIndexedColorMode())
+	{
+		const uint8_t *src;
+		uint32_t code;
+		// ARGB1555의 알파 비트는 바이트 순서가 바뀐 형식에서 하위 바이트에 있음
+		uint16_t alphaMask = Color::getLittleEndian() ? 0x8000 : 0x0080;
+
+		for(uint16_t y = 0; y < height; y++)
+		{
+			src = data;
+			for(uint16_t x = 0; x < width; x++)
+			{
+				code = src[0] | src[1] << 8;
+				if(srcDotSize == 3)
+					code |= src[2] << 16;
+
+				if(!(type == 2 && (code & alphaMask) == 0) && !(mColorKeyFlag && code == mColorKey))
+					drawDot(pos.x + x, pos.y + y, convertDot(src, type));
+				src += srcDotSize;
+			}
+			data += srcLine;
+		}
+		return;
+	}
+
+	des = &mFrameBuffer[(pos.y * mSize.width + pos.x) * mDotSize];
+
+	for(uint16_t y = 0; y < height; y++)
+	{
+		if(mColorKeyFlag)
+			blit::convertLineWithColorKey(des, mColorMode, data, type, width, mColorKey);
+		else if(mDitherFlag && type == 1 && mColorMode == COLOR_MODE_RGB565)
+		{
+			// 디더링 결과는 R이 상위인 형식이므로 Color의 형식으로 맞춤
+			convert::rgb888ToRgb565Dither((uint16_t*)des, data, width, pos.x, pos.y + y);
+			if(!Color::getReverseRgbOrder() || !Color::getLittleEndian())
+				convert::reorderRgb565((uint16_t*)des, (const uint16_t*)des, width, !Color::getReverseRgbOrder(), !Color::getLittleEndian());
+		}
+		else
+			blit::convertLine(des, mColorMode, data, type, width);
+
+		des += mSize.width * mDotSize;
+		data += srcLine;
+	}
+}
+
+void Brush::drawCompressedBitmapData(Position_t pos, uint16_t width, uint16_t height, uint8_t type, const uint8_t *data)
+{
+	BitmapDecoder decoder;
+	uint8_t buf[COMPRESSED_BITMAP_BAND * 2], *des;
+	int16_t left = 0, right = 0, top = 0, count;
+	uint16_t orgWidth = width;
+	uint32_t code;
+
+	if(data == 0)
+		return;
+
+	// 좌표가 대상 밖이면 리턴
+	if (pos.x >= mSize.width ||
+		pos.y >= mSize.height ||
+		pos.x + width <= 0 ||
+		pos.y + height <= 0)
+		return;
+
+	// 대상 영역 밖의 부분을 잘라냄
+	if (pos.y < 0)
+	{
+		top = -pos.y;
+		height -= top;
+		pos.y = 0;
+	}
+
+	if (pos.x < 0)
+	{
+		left = -pos.x;
+		width -= left;
+		pos.x = 0;
+	}
+
+	if (pos.y + height > mSize.height)
+		height = mSize.height - pos.y;
+
+	if (pos.x + width > mSize.width)
+	{
+		right = pos.x + width - mSize.width;
+		width -= right;
+	}
+
+	decoder.begin(orgWidth, type, data);
+	decoder.skip(top * orgWidth);
+
+	// 팔레트 방식에 팔레트 비트맵을 그릴 때는 비트맵의 색상표를 브러쉬의 팔레트 번호로 한 번만 바꿔두고
+	// 점마다 색상을 찾지 않고 팔레트 번호만 바꿔서 그림
+	if(isIndexedColorMode() && type >= BitmapDecoder::TYPE_INDEX8 && type <= BitmapDecoder::TYPE_INDEX1 && !mColorKeyFlag)
+	{
+		uint8_t map[256];
+
+		for(uint16_t i = 0; i <= data[0]; i++)
+			map[i] = convertDot(&data[1 + i * 2], BitmapDecoder::TYPE_RGB565);
+
+		for(uint16_t y = 0; y < height; y++)
+		{
+			if(left)
+				decoder.skip(left);
+
+			for(uint16_t x = 0; x < width; x += count)
+			{
+				count = width - x;
+				if(count > COMPRESSED_BITMAP_BAND)
+					count = COMPRESSED_BITMAP_BAND;
+
+				decoder.readIndex(buf, count);
+				for(int16_t i = 0; i < count; i++)
+					drawDot(pos.x + x + i, pos.y + y, (uint32_t)map[buf[i]]);
+			}
+
+			if(right)
+				decoder.skip(right);
+		}
+		return;
+	}
+
+	for(uint16_t y = 0; y < height; y++)
+	{
+		if(left)
+			decoder.skip(left);
+
+		// RGB565 프레임 버퍼는 프레임 버퍼에 바로 풂
+		if(mFrameBuffer && mColorMode == COLOR_MODE_RGB565 && !mColorKeyFlag)
+		{
+			decoder.read(&mFrameBuffer[((pos.y + y) * mSize.width + pos.x) * 2], width);
+		}
+		else
+		{
+			// 일정 점의 수 단위로 풀어서 변환
+			for(uint16_t x = 0; x < width; x += count)
+			{
+				count = width - x;
+				if(count > COMPRESSED_BITMAP_BAND)
+					count = COMPRESSED_BITMAP_BAND;
+
+				decoder.read(buf, count);
+
+				if(mFrameBuffer && !isIndexedColorMode())
+				{
+					des = &mFrameBuffer[((pos.y + y) * mSize.width + pos.x + x) * mDotSize];
+					if(mColorKeyFlag)
+						blit::convertLineWithColorKey(des, mColorMode, buf, BitmapDecoder::TYPE_RGB565, count, mColorKey);
+					else
+						blit::convertLine(des, mColorMode, buf, BitmapDecoder::TYPE_RGB565, count);
+				}
+				else
+				{
+					for(int16_t i = 0; i < count; i++)
+					{
+						code = buf[i * 2] | buf[i * 2 + 1] << 8;
+						if(!(mColorKeyFlag && code == mColorKey))
+							drawDot(pos.x + x + i, pos.y + y, convertDot(&buf[i * 2], BitmapDecoder::TYPE_RGB565));
+					}
+				}
+			}
+		}
+
+		if(right)
+			decoder.skip(right);
+	}
+}
+
 void Brush::drawBitmapBase(Position_t pos, const Bitmap_t &bitmap)
 {
-#warning "내용 작성이 필요함"
-	(void)pos;
-	(void)bitmap;
+	drawBitmapData(pos, bitmap.width, bitmap.height, bitmap.type, bitmap.data);
 }
 
 void Brush::drawBitmap(Position_t pos, const Bitmap_t &bitmap)
@@ -670,9 +962,7 @@ void Brush::drawBitmap(Position_t pos, const Bitmap_t *bitmap)
 
 void Brush::drawBitmapFileBase(Position_t pos, const BitmapFile_t &bitmap)
 {
-#warning "내용 작성이 필요함"
-	(void)pos;
-	(void)bitmap;
+	drawBitmapData(pos, bitmap.width, bitmap.height, bitmap.type, &bitmap.data);
 }
 
 void Brush::drawBitmapFile(Position_t pos, const BitmapFile_t &bitmap)
@@ -685,35 +975,362 @@ void Brush::drawBitmapFile(Position_t pos, const BitmapFile_t *bitmap)
 	drawBitmapFileBase(pos, *bitmap);
 }
 
+void Brush::setGlyphCache(GlyphCache *cache)
+{
+	mGlyphCache = cache;
+}
+
+void Brush::setTextLayout(TextLayout *layout)
+{
+	mTextLayout = layout;
+}
+
+GlyphCache::glyph_t* Brush::cacheChar(uint32_t utf8)
+{
+	Font::fontInfo_t *fontInfo = mFont->getFontInfo(utf8);
+	GlyphCache::glyph_t *glyph;
+	Font::Decoder decoder;
+	uint32_t code;
+	uint16_t stride;
+	uint8_t *des, *src;
+	int8_t xoffset;
+
+	if(fontInfo == 0 || (mDotSize != 2 && mDotSize != 3))
+		return 0;
+	
+	stride = mFont->getDataStride(fontInfo->width);
+	glyph = mGlyphCache->allocate(mFont, utf8, mFontColorCodeTable[15], mFontColorCodeTable[0], mColorMode, stride * fontInfo->height * mDotSize);
+	if(glyph == 0)
+		return 0;
+
+	xoffset = (int8_t)fontInfo->xpos;
+	if(xoffset == 0)
+		xoffset = 1;
+
+	glyph->width = stride;
+	glyph->height = fontInfo->height;
+	glyph->advance = fontInfo->width + xoffset;
+	glyph->xoffset = xoffset;
+	glyph->yoffset = (int8_t)fontInfo->ypos;
+
+	// 글꼴 색상 테이블로 미리 합성된 이미지를 만든다.
+	des = mGlyphCache->getData(glyph);
+	decoder.begin(fontInfo->data, mFont->getDataFormat());
+
+	for(uint32_t i = stride * fontInfo->height; i > 0; i--)
+	{
+		code = mFontColorCodeTable[decoder.getLevel()];
+
+		if(mDotSize == 2)
+		{
+			*(uint16_t*)des = code;
+			des += 2;
+		}
+		else
+		{
+			src = (uint8_t*)&code;
+			*des++ = *src++;
+			*des++ = *src++;
+			*des++ = *src++;
+		}
+	}
+
+	return glyph;
+}
+
+void Brush::drawCachedChar(Position_t pos, GlyphCache::glyph_t *glyph)
+{
+	int16_t xs = pos.x + glyph->xoffset, ys = pos.y + glyph->yoffset, width = glyph->width, height = glyph->height;
+	uint8_t *src = mGlyphCache->getData(glyph), *des;
+	int32_t srcLine = glyph->width * mDotSize, desLine = mSize.width * mDotSize;
+	
+	// 프레임 버퍼 영역에 맞게 자름
+	if(xs < 0)
+	{
+		src -= xs * mDotSize;
+		width += xs;
+		xs = 0;
+	}
+	if(ys < 0)
+	{
+		src -= ys * srcLine;
+		height += ys;
+		ys = 0;
+	}
+	if(xs + width > mSize.width)
+		width = mSize.width - xs;
+	if(ys + height > mSize.height)
+		height = mSize.height - ys;
+
+	if(width <= 0 || height <= 0)
+		return;
+
+	des = &mFrameBuffer[(ys * mSize.width + xs) * mDotSize];
+
+	for(int16_t y = 0; y < height; y++)
+	{
+		memcpy(des, src, width * mDotSize);
+		des += desLine;
+		src += srcLine;
+	}
+}
+
+void Brush::enableFontBlending(bool en)
+{
+	mFontBlendFlag = en;
+}
+
+uint8_t Brush::drawBlendedChar(Position_t pos, uint32_t utf8)
+{
+	Font::fontInfo_t *fontInfo = mFont->getFontInfo(utf8);
+	Font::Decoder decoder;
+	uint8_t mask[128], level, *des;
+	int16_t width, height, stride, xoffset, xs, ys, left = 0, right;
+	uint32_t color = mFontColorCodeTable[15];
+	bool swap = !Color::getLittleEndian();
+
+	if(fontInfo == 0)
+		return 0;
+
+	xoffset = (int8_t)fontInfo->xpos;
+	if(xoffset == 0)
+		xoffset = 1;
+
+	xs = pos.x + xoffset;
+	ys = pos.y + (int8_t)fontInfo->ypos;
+	stride = mFont->getDataStride(fontInfo->width);
+	width = stride;
+	height = fontInfo->height;
+
+	if (xs >= mSize.width || ys >= mSize.height || xs + width <= 0 || ys + height <= 0)
+		return fontInfo->width + xoffset;
+
+	decoder.begin(fontInfo->data, mFont->getDataFormat());
+
+	// 프레임 버퍼 영역에 맞게 자름
+	if(ys < 0)
+	{
+		decoder.skip(stride * -ys);
+		height += ys;
+		ys = 0;
+	}
+	if(xs < 0)
+	{
+		left = -xs;
+		width += xs;
+		xs = 0;
+	}
+	if(xs + width > mSize.width)
+		width = mSize.width - xs;
+	if(ys + height > mSize.height)
+		height = mSize.height - ys;
+	right = stride - left - width;
+
+	// 팔레트 방식은 그려진 점의 색상과 합성한 색상에서 가장 가까운 팔레트 번호로 그림
+	if(isIndexedColorMode())
+	{
+		Color bgColor;
+
+		for(int16_t y = 0; y < height; y++)
+		{
+			if(left)
+				decoder.skip(left);
+
+			for(int16_t x = 0; x < width; x++)
+			{
+				level = decoder.getLevel();
+				if(level == 15)
+				{
+					drawDot(xs + x, ys + y, color);
+				}
+				else if(level)
+				{
+					bgColor = mPalette ? mPalette->getColor(getIndexedDot(xs + x, ys + y)) : mBgColor;
+					drawDot(xs + x, ys + y, findPaletteIndex(mFontColor.calculateFontColorLevel(bgColor, level)));
+				}
+			}
+
+			if(right)
+				decoder.skip(right);
+		}
+
+		return fontInfo->width + xoffset;
+	}
+
+	des = &mFrameBuffer[(ys * mSize.width + xs) * mDotSize];
+
+	for(int16_t y = 0; y < height; y++)
+	{
+		if(left)
+			decoder.skip(left);
+
+		// 한 줄의 농도를 A4 마스크로 모음
+		for(int16_t x = 0; x < width; x++)
+		{
+			level = decoder.getLevel();
+			if(x & 0x01)
+				mask[x >> 1] |= level << 4;
+			else
+				mask[x >> 1] = level;
+		}
+
+		if(right)
+			decoder.skip(right);
+
+		switch(mColorMode)
+		{
+		case COLOR_MODE_RGB565 :
+			blend::blendMaskRgb565((uint16_t*)des, color, mask, width, swap);
+			break;
+
+		case COLOR_MODE_ARGB1555 :
+			blend::blendMaskArgb1555((uint16_t*)des, color, mask, width, swap);
+			break;
+
+		case COLOR_MODE_RGB888 :
+			blend::blendMaskRgb888(des, color, mask, width);
+			break;
+		}
+
+		des += mSize.width * mDotSize;
+	}
+
+	return fontInfo->width + xoffset;
+}
+
+void Brush::blendRect(Position_t pos, Size_t size, Color color, uint8_t alpha)
+{
+	int16_t width = size.width, height = size.height;
+	uint32_t code;
+	uint8_t *des;
+	bool swap = !Color::getLittleEndian();
+
+	// 프레임 버퍼 메모리가 없거나 팔레트 방식이면 배경색과 합성한 색상으로 채움
+	if(mFrameBuffer == 0 || isIndexedColorMode())
+		color = color.calculateFontColorLevel(mBgColor, (alpha * 15 + 127) / 255);
+
+	switch(mColorMode)
+	{
+	case COLOR_MODE_RGB565 :
+		code = color.getRgb565Code();
+		break;
+
+	case COLOR_MODE_ARGB1555 :
+		code = color.getArgb1555Code();
+		break;
+
+	case COLOR_MODE_RGB888 :
+		code = color.getRgb888Code();
+		break;
+
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		code = findPaletteIndex(color);
+		break;
+
+	default :
+		return;
+	}
+
+	if(mFrameBuffer == 0 || isIndexedColorMode())
+	{
+		fillRectBase(pos, size, code);
+		return;
+	}
+
+	// 프레임 버퍼 영역에 맞게 자름
+	if(pos.x < 0)
+	{
+		width += pos.x;
+		pos.x = 0;
+	}
+	if(pos.y < 0)
+	{
+		height += pos.y;
+		pos.y = 0;
+	}
+	if(pos.x + width > mSize.width)
+		width = mSize.width - pos.x;
+	if(pos.y + height > mSize.height)
+		height = mSize.height - pos.y;
+
+	if(width <= 0 || height <= 0)
+		return;
+
+	des = &mFrameBuffer[(pos.y * mSize.width + pos.x) * mDotSize];
+
+	for(int16_t y = 0; y < height; y++)
+	{
+		switch(mColorMode)
+		{
+		case COLOR_MODE_RGB565 :
+			blend::blendColorRgb565((uint16_t*)des, code, alpha, width, swap);
+			break;
+
+		case COLOR_MODE_ARGB1555 :
+			blend::blendColorArgb1555((uint16_t*)des, code, alpha, width, swap);
+			break;
+
+		case COLOR_MODE_RGB888 :
+			blend::blendColorRgb888(des, code, alpha, width);
+			break;
+		}
+
+		des += mSize.width * mDotSize;
+	}
+}
+
 uint8_t Brush::drawChar(Position_t pos, uint32_t utf8)
 {
 	if (mFont == 0)
 		return 0;
 
+	// 프레임 버퍼에 그려진 내용 위에 합성
+	// 팔레트 방식은 getIndexedDot()으로 그려진 점을 읽어서 합성하므로 프레임 버퍼 메모리가 없어도 됨
+	if(mFontBlendFlag && (mFrameBuffer || isIndexedColorMode()))
+		return drawBlendedChar(pos, utf8);
+
+	// 캐시에 합성된 문자 이미지가 있으면 복사만 한다.
+	if(mGlyphCache && mFrameBuffer)
+	{
+		GlyphCache::glyph_t *glyph = mGlyphCache->find(mFont, utf8, mFontColorCodeTable[15], mFontColorCodeTable[0], mColorMode);
+
+		if(glyph == 0)
+			glyph = cacheChar(utf8);
+
+		if(glyph)
+		{
+			drawCachedChar(pos, glyph);
+			return glyph->advance;
+		}
+	}
+
 	Font::fontInfo_t *fontInfo = mFont->getFontInfo(utf8);
-	uint8_t *fontFb, color;
-	int32_t  index = 0;
-	int16_t width = fontInfo->width, height = fontInfo->height, offset = 0, xoffset;
-	int16_t xs = pos.x, ys = pos.y + (int8_t)fontInfo->ypos;
+	Font::Decoder decoder;
+	int16_t width, height, stride, offset = 0, xoffset, xs, ys;
 	
 	if(fontInfo == 0)
 		return 0;
 	
-	fontFb = fontInfo->data;
 	xoffset = (int8_t)fontInfo->xpos;
-
 	if(xoffset == 0) // 문자의 앞 여백이 없을 경우
 		xoffset = 1; // 문자의 앞 여백 하나를 추가해줌
 	
-	xs += xoffset;
+	xs = pos.x + xoffset;
+	ys = pos.y + (int8_t)fontInfo->ypos;
+	stride = mFont->getDataStride(fontInfo->width); // 데이터 형식에 맞게 줄의 크기를 정렬
+	width = stride;
+	height = fontInfo->height;
 
-	if(width & 0x01) // 문자 크기가 홀수 일 경우
-		width++; // 짝수로 만들어줌
+	if (xs >= mSize.width || ys >= mSize.height)
+		return fontInfo->width + xoffset;
 
 	if (xs + width > mSize.width)
 	{
 		width = mSize.width - xs;
-		offset = fontInfo->width - width;
+		offset = stride - width;
 	}
 	if (ys + height > mSize.height)
 		height = mSize.height - ys;
@@ -721,22 +1338,15 @@ uint8_t Brush::drawChar(Position_t pos, uint32_t utf8)
 	width += xs;
 	height += ys;
 
+	decoder.begin(fontInfo->data, mFont->getDataFormat());
+
 	for (int32_t  y = ys; y < height; y++)
 	{
-		for (int32_t  x = xs; x < width; x++, index++)
-		{
-			if (index % 2 == 0)
-			{
-				color = fontFb[index / 2] & 0x0f;
-				drawDot(x, y, mFontColorCodeTable[color]);
-			}
-			else
-			{
-				color = (fontFb[index / 2] >> 4) & 0x0f;
-				drawDot(x, y, mFontColorCodeTable[color]);
-			}
-		}
-		index += offset;
+		for (int32_t  x = xs; x < width; x++)
+			drawDot(x, y, mFontColorCodeTable[decoder.getLevel()]);
+
+		if(offset)
+			decoder.skip(offset);
 	}
 
 	return fontInfo->width + xoffset;
@@ -758,8 +1368,47 @@ void Brush::updateFontColor(void)
 		for(uint8_t i=0;i<16;i++)
 			mFontColorCodeTable[i] = mFontColor.calculateFontColorLevel(mBgColor, i).getArgb1555Code();
 		break;
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		for(uint8_t i=0;i<16;i++)
+			mFontColorCodeTable[i] = findPaletteIndex(mFontColor.calculateFontColorLevel(mBgColor, i));
+		break;
 	}
 }
 
+uint32_t Brush::findPaletteIndex(Color color)
+{
+	if(mPalette == 0)
+		return 0;
+
+	return mPalette->findIndex(color);
+}
+
+uint8_t Brush::getIndexedDot(int16_t x, int16_t y)
+{
+	uint32_t bit = x * mDotBit;
+
+	if(mFrameBuffer == 0 || !isIndexedColorMode())
+		return mBgColorCode;
+
+	return (mFrameBuffer[y * getLineSize() + (bit >> 3)] >> (bit & 0x07)) & ((1 << mDotBit) - 1);
+}
+
+uint32_t Brush::convertDot(const uint8_t *src, uint8_t type)
+{
+	uint32_t code;
+
+	// 팔레트 방식은 RGB888로 변환한 후 가장 가까운 색상 번호를 찾음
+	if(isIndexedColorMode())
+	{
+		code = blit::convertDot(COLOR_MODE_RGB888, src, type);
+		return findPaletteIndex(Color(code >> 16, code >> 8, code));
+	}
+
+	return blit::convertDot(mColorMode, src, type);
+}
+
 
 #endif
\ No newline at end of file
@@ -231,6 +231,16 @@ void Color::setLittleEndian(bool reverse)
 	mLittleEndian = reverse;
 }
 
+bool Color::getReverseRgbOrder(void)
+{
+	return mReverseRgb;
+}
+
+bool Color::getLittleEndian(void)
+{
+	return mLittleEndian;
+}
+
 void Color::getColor(uint8_t &red, uint8_t &green, uint8_t &blue, uint8_t &alpha)
 {
 	red = mRed;
@@ -13,6 +13,7 @@
 #include <config.h>
 #include <yss/gui.h>
 #include <std_ext/malloc.h>
+#include <string.h>
 
 #if YSS_GUI_FRAME_BUFFER == 0	// Rgb565
 	typedef Rgb565		SysFrameBuffer;
@@ -25,10 +26,13 @@
 Container::Container()
 {
 	mObjArr = 0;
+	mQueryBuf = 0;
 	mMaxObj = 0;
 	mNumOfObj = 0;
 	mLastEventObj = 0;
 	mValidFlag = true;
+	mCellSize = Size_t{0, 0};
+	memset(mCell, 0, sizeof(mCell));
 	increaseObjArr();
 }
 
@@ -41,6 +45,14 @@ Container::~Container()
 
 	if (mObjArr)
 		lfree(mObjArr);
+	if (mQueryBuf)
+		lfree(mQueryBuf);
+
+	for (uint16_t i = 0; i < INDEX_GRID * INDEX_GRID; i++)
+	{
+		if (mCell[i].index)
+			lfree(mCell[i].index);
+	}
 	
 	mValidFlag = false;
 }
@@ -73,6 +85,7 @@ void Container::add(Object &obj)
 		increaseObjArr();
 
 	mObjArr[mNumOfObj] = &obj;
+	addIndex(mNumOfObj, obj.getPosition(), obj.getSize());
 	mNumOfObj++;
 
 	obj.setParent(this);
@@ -98,10 +111,12 @@ void Container::increaseObjArr(void)
 			temp[i] = mObjArr[i];
 
 		lfree(mObjArr);
+		lfree(mQueryBuf);
 	}
 	mMaxObj += 512;
 
 	mObjArr = temp;
+	mQueryBuf = (uint16_t *)lmalloc(sizeof(uint16_t) * mMaxObj);
 }
 
 void Container::setBackgroundColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
@@ -117,16 +132,7 @@ void Container::update(void)
 
 void Container::update(Position_t pos, Size_t size)
 {
-	Object *obj;
-
-	mFrameBuffer->eraseRectangle(pos, size);
-
-	for (uint16_t i = 0; i < mNumOfObj; i++)
-	{
-		obj = mObjArr[i];
-		if (obj->isVisible())
-			mFrameBuffer->drawObjectToPartialArea(pos, size, obj);
-	}
+	drawArea(pos, size);
 
 	if (mParent)
 	{
@@ -138,84 +144,335 @@ void Container::update(Position_t pos, Size_t size)
 
 void Container::update(Position_t beforePos, Size_t beforeSize, Position_t currentPos, Size_t currentSize)
 {
+	drawArea(beforePos, beforeSize);
+	drawArea(currentPos, currentSize);
+
+	if (mParent)
+	{
+		beforePos.x += mPos.x;
+		beforePos.y += mPos.y;
+		currentPos.x += mPos.x;
+		currentPos.y += mPos.y;
+		mParent->update(beforePos, beforeSize, currentPos, currentSize);
+	}
+}
+
+// 객체가 영역을 모두 덮는지 확인
+static bool isCovering(Object *obj, Position_t pos, Size_t size)
+{
+	Position_t objPos = obj->getPosition();
+	Size_t objSize = obj->getSize();
+
+	return	objPos.x <= pos.x && 
+			objPos.y <= pos.y && 
+			objPos.x + objSize.width >= pos.x + size.width && 
+			objPos.y + objSize.height >= pos.y + size.height;
+}
+
+void Container::drawArea(Position_t pos, Size_t size)
+{
+	uint16_t num = query(pos, size), start = 0, i, j;
+	Position_t objPos, clipPos;
+	Size_t objSize, clipSize;
 	Object *obj;
+	bool coveredFlag = false;
+
+	// 영역 전체를 덮는 가장 위의 불투명한 객체보다 아래의 객체와 배경은 그리지 않음
+	for (i = num; i > 0; i--)
+	{
+		obj = mObjArr[mQueryBuf[i - 1]];
+		if (obj->isVisible() && obj->isOpaque() && isCovering(obj, pos, size))
+		{
+			start = i - 1;
+			coveredFlag = true;
+			break;
+		}
+	}
 
-	mFrameBuffer->eraseRectangle(beforePos, beforeSize);
-	mFrameBuffer->eraseRectangle(currentPos, currentSize);
+	if (!coveredFlag)
+		mFrameBuffer->eraseRectangle(pos, size);
 
-	for (uint16_t i = 0; i < mNumOfObj; i++)
+	for (i = start; i < num; i++)
 	{
-		obj = mObjArr[i];
-		if (obj->isVisible())
+		obj = mObjArr[mQueryBuf[i]];
+		if (!obj->isVisible())
+			continue;
+
+		// 영역 안에 보이는 부분을 계산
+		objPos = obj->getPosition();
+		objSize = obj->getSize();
+		clipPos.x = objPos.x > pos.x ? objPos.x : pos.x;
+		clipPos.y = objPos.y > pos.y ? objPos.y : pos.y;
+		clipSize.width = (objPos.x + objSize.width < pos.x + size.width ? objPos.x + objSize.width : pos.x + size.width) - clipPos.x;
+		clipSize.height = (objPos.y + objSize.height < pos.y + size.height ? objPos.y + objSize.height : pos.y + size.height) - clipPos.y;
+
+		// 보이는 부분이 위의 불투명한 객체에 모두 가려지면 그리지 않음
+		for (j = i + 1; j < num; j++)
 		{
-			mFrameBuffer->drawObjectToPartialArea(beforePos, beforeSize, obj);
-			mFrameBuffer->drawObjectToPartialArea(currentPos, currentSize, obj);
+			if (mObjArr[mQueryBuf[j]]->isVisible() && mObjArr[mQueryBuf[j]]->isOpaque() && isCovering(mObjArr[mQueryBuf[j]], clipPos, clipSize))
+				break;
 		}
+
+		if (j == num)
+			mFrameBuffer->drawObjectToPartialArea(pos, size, obj);
 	}
+}
 
-	if (mParent)
+void Container::eventSizeChanged(Size_t size)
+{
+	(void)size;
+	resetIndex();
+}
+
+void Container::resetIndex(void)
+{
+	Size_t size = mFrameBuffer->getSize();
+
+	mCellSize.width = (size.width + INDEX_GRID - 1) / INDEX_GRID;
+	mCellSize.height = (size.height + INDEX_GRID - 1) / INDEX_GRID;
+
+	for (uint16_t i = 0; i < INDEX_GRID * INDEX_GRID; i++)
+		mCell[i].num = 0;
+
+	for (uint16_t i = 0; i < mNumOfObj; i++)
+		addIndex(i, mObjArr[i]->getPosition(), mObjArr[i]->getSize());
+}
+
+bool Container::getCellRange(Position_t pos, Size_t size, uint8_t *range)
+{
+	Size_t area = mFrameBuffer->getSize();
+	int32_t sx = pos.x, sy = pos.y, ex = pos.x + size.width - 1, ey = pos.y + size.height - 1;
+
+	if (mCellSize.width == 0 || mCellSize.height == 0 || size.width == 0 || size.height == 0)
+		return false;
+
+	if (ex < 0 || ey < 0 || sx >= area.width || sy >= area.height)
+		return false;
+
+	// Container를 벗어난 부분은 가장자리 칸에 포함
+	if (sx < 0)
+		sx = 0;
+	if (sy < 0)
+		sy = 0;
+	if (ex >= area.width)
+		ex = area.width - 1;
+	if (ey >= area.height)
+		ey = area.height - 1;
+
+	range[0] = sx / mCellSize.width;
+	range[1] = sy / mCellSize.height;
+	range[2] = ex / mCellSize.width;
+	range[3] = ey / mCellSize.height;
+
+	return true;
+}
+
+void Container::addIndex(uint16_t index, Position_t pos, Size_t size)
+{
+	uint8_t range[4];
+	uint16_t *temp, i;
+	Cell *cell;
+
+	if (!getCellRange(pos, size, range))
+		return;
+
+	for (uint8_t y = range[1]; y <= range[3]; y++)
 	{
-		beforePos.x += mPos.x;
-		beforePos.y += mPos.y;
-		currentPos.x += mPos.x;
-		currentPos.y += mPos.y;
-		mParent->update(beforePos, beforeSize, currentPos, currentSize);
+		for (uint8_t x = range[0]; x <= range[2]; x++)
+		{
+			cell = &mCell[y * INDEX_GRID + x];
+
+			if (cell->num >= cell->max)
+			{
+				temp = (uint16_t *)lmalloc(sizeof(uint16_t) * (cell->max + INDEX_GROW));
+				if (cell->index)
+				{
+					memcpy(temp, cell->index, sizeof(uint16_t) * cell->num);
+					lfree(cell->index);
+				}
+				cell->index = temp;
+				cell->max += INDEX_GROW;
+			}
+
+			// 아래에서 위의 순서가 유지되도록 삽입
+			for (i = cell->num; i > 0 && cell->index[i - 1] > index; i--)
+				cell->index[i] = cell->index[i - 1];
+			cell->index[i] = index;
+			cell->num++;
+		}
 	}
 }
 
-Object *Container::handlerPush(Position_t pos)
+void Container::removeIndex(uint16_t index, Position_t pos, Size_t size)
 {
-	Position_t objPos;
-	Size_t objSize;
-	Position_t calculatedPos;
-	Object *rt;
+	uint8_t range[4];
+	uint16_t i;
+	Cell *cell;
+
+	if (!getCellRange(pos, size, range))
+		return;
 
-	for (int16_t i = mNumOfObj - 1; i >= 0; i--)
+	for (uint8_t y = range[1]; y <= range[3]; y++)
 	{
-		objPos = mObjArr[i]->getPosition();
-		objSize = mObjArr[i]->getSize();
+		for (uint8_t x = range[0]; x <= range[2]; x++)
+		{
+			cell = &mCell[y * INDEX_GRID + x];
+
+			for (i = 0; i < cell->num; i++)
+			{
+				if (cell->index[i] == index)
+				{
+					cell->num--;
+					memmove(&cell->index[i], &cell->index[i + 1], sizeof(uint16_t) * (cell->num - i));
+					break;
+				}
+			}
+		}
+	}
+}
 
-		if (mObjArr[i]->isVisible() && objPos.x < pos.x && objPos.y < pos.y && objPos.x + objSize.width > pos.x && objPos.y + objSize.height > pos.y)
+void Container::relocate(Object &obj, Position_t beforePos, Size_t beforeSize)
+{
+	uint8_t range[4];
+	uint16_t index = mNumOfObj, i;
+	Cell *cell;
+
+	// 객체의 번호는 이전 영역의 칸에서 먼저 찾음
+	if (getCellRange(beforePos, beforeSize, range))
+	{
+		cell = &mCell[range[1] * INDEX_GRID + range[0]];
+		for (i = 0; i < cell->num; i++)
 		{
-			calculatedPos.x = pos.x - objPos.x;
-			calculatedPos.y = pos.y - objPos.y;
+			if (mObjArr[cell->index[i]] == &obj)
+			{
+				index = cell->index[i];
+				break;
+			}
+		}
+	}
 
-			rt = mObjArr[i]->handlerPush(calculatedPos);
-			return rt;
+	if (index == mNumOfObj)
+	{
+		for (i = 0; i < mNumOfObj; i++)
+		{
+			if (mObjArr[i] == &obj)
+			{
+				index = i;
+				break;
+			}
 		}
+
+		if (index == mNumOfObj)
+			return;
 	}
 
-	return 0;
+	removeIndex(index, beforePos, beforeSize);
+	addIndex(index, obj.getPosition(), obj.getSize());
 }
 
-Object *Container::handlerDrag(Position_t pos)
+uint16_t Container::query(Position_t pos, Size_t size)
 {
-	Position_t objPos;
-	Size_t objSize;
-	Position_t calculatedPos;
-	Object *rt;
+	uint8_t range[4];
+	Cell *cell[INDEX_GRID * INDEX_GRID];
+	uint16_t cursor[INDEX_GRID * INDEX_GRID], numOfCell = 0, num = 0, min, i;
+	bool foundFlag;
 
-	for (int16_t i = mNumOfObj - 1; i >= 0; i--)
+	if (!getCellRange(pos, size, range))
+		return 0;
+
+	for (uint8_t y = range[1]; y <= range[3]; y++)
 	{
-		objPos = mObjArr[i]->getPosition();
-		objSize = mObjArr[i]->getSize();
+		for (uint8_t x = range[0]; x <= range[2]; x++)
+		{
+			cell[numOfCell] = &mCell[y * INDEX_GRID + x];
+			cursor[numOfCell] = 0;
+			numOfCell++;
+		}
+	}
 
-		if (mObjArr[i]->isVisible() && objPos.x < pos.x && objPos.y < pos.y && objPos.x + objSize.width > pos.x && objPos.y + objSize.height > pos.y)
+	// 칸마다 정렬된 목록을 병합하며 여러 칸에 걸친 객체는 한 번만 포함
+	while (true)
+	{
+		foundFlag = false;
+		min = 0;
+
+		for (i = 0; i < numOfCell; i++)
 		{
-			calculatedPos.x = pos.x - objPos.x;
-			calculatedPos.y = pos.y - objPos.y;
+			if (cursor[i] < cell[i]->num && (!foundFlag || cell[i]->index[cursor[i]] < min))
+			{
+				min = cell[i]->index[cursor[i]];
+				foundFlag = true;
+			}
+		}
 
-			rt = mObjArr[i]->handlerDrag(calculatedPos);
-			return rt;
+		if (!foundFlag)
+			break;
+
+		for (i = 0; i < numOfCell; i++)
+		{
+			if (cursor[i] < cell[i]->num && cell[i]->index[cursor[i]] == min)
+				cursor[i]++;
 		}
+
+		mQueryBuf[num++] = min;
+	}
+
+	return num;
+}
+
+Object *Container::findObject(Position_t pos)
+{
+	uint8_t range[4];
+	Position_t objPos;
+	Size_t objSize;
+	Object *obj;
+	Cell *cell;
+
+	if (!getCellRange(pos, Size_t{1, 1}, range))
+		return 0;
+
+	cell = &mCell[range[1] * INDEX_GRID + range[0]];
+
+	for (int32_t i = cell->num - 1; i >= 0; i--)
+	{
+		obj = mObjArr[cell->index[i]];
+		objPos = obj->getPosition();
+		objSize = obj->getSize();
+
+		if (obj->isVisible() && objPos.x < pos.x && objPos.y < pos.y && objPos.x + objSize.width > pos.x && objPos.y + objSize.height > pos.y)
+			return obj;
 	}
 
 	return 0;
 }
 
+Object *Container::handlerPush(Position_t pos)
+{
+	Object *obj = findObject(pos);
+	Position_t objPos;
+
+	if (obj == 0)
+		return 0;
+
+	objPos = obj->getPosition();
+	return obj->handlerPush(Position_t{(int16_t)(pos.x - objPos.x), (int16_t)(pos.y - objPos.y)});
+}
+
+Object *Container::handlerDrag(Position_t pos)
+{
+	Object *obj = findObject(pos);
+	Position_t objPos;
+
+	if (obj == 0)
+		return 0;
+
+	objPos = obj->getPosition();
+	return obj->handlerDrag(Position_t{(int16_t)(pos.x - objPos.x), (int16_t)(pos.y - objPos.y)});
+}
+
 Object *Container::handlerUp(void)
 {
 	return 0;
 }
 
-#endif
\ No newline at end of file
+#endif
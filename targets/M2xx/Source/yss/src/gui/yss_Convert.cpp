@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/Convert.h>
+
+namespace convert
+{
+	// 4x4 Bayer 행렬 (0 ~ 15)
+	static const uint8_t gBayer[4][4] =
+	{
+		{ 0,  8,  2, 10},
+		{12,  4, 14,  6},
+		{ 3, 11,  1,  9},
+		{15,  7, 13,  5}
+	};
+
+	static inline uint32_t packRgb565(uint32_t red, uint32_t green, uint32_t blue)
+	{
+		return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | ((blue & 0xFF) >> 3);
+	}
+
+	static inline void unpackRgb565(uint8_t *des, uint32_t dot)
+	{
+		uint8_t buf;
+
+		buf = dot & 0x1F;
+		des[0] = (buf << 3) | (buf >> 2);
+		buf = (dot >> 5) & 0x3F;
+		des[1] = (buf << 2) | (buf >> 4);
+		buf = (dot >> 11) & 0x1F;
+		des[2] = (buf << 3) | (buf >> 2);
+	}
+
+	// 두 점씩 처리하는 변환 함수들이며 상위와 하위 16비트가 각각 한 점이다.
+	static inline uint32_t rgb565ToArgb1555(uint32_t dot)
+	{
+		return 0x80008000 | ((dot >> 1) & 0x7FE07FE0) | (dot & 0x001F001F);
+	}
+
+	static inline uint32_t argb1555ToRgb565(uint32_t dot)
+	{
+		return ((dot << 1) & 0xFFC0FFC0) | ((dot >> 4) & 0x00200020) | (dot & 0x001F001F);
+	}
+
+	static inline uint32_t reorderRgb565(uint32_t dot, bool reverseRgb, bool reverseEndian)
+	{
+		if(reverseRgb)
+			dot = (dot & 0x07E007E0) | ((dot >> 11) & 0x001F001F) | ((dot << 11) & 0xF800F800);
+		if(reverseEndian)
+			dot = ((dot >> 8) & 0x00FF00FF) | ((dot << 8) & 0xFF00FF00);
+		return dot;
+	}
+
+	void rgb888ToRgb565(uint16_t *des, const uint8_t *src, uint32_t count)
+	{
+		uint32_t *des32;
+
+		// 대상을 4바이트 정렬
+		if(((uintptr_t)des & 0x03) && count)
+		{
+			*des++ = packRgb565(src[2], src[1], src[0]);
+			src += 3;
+			count--;
+		}
+
+		des32 = (uint32_t*)des;
+
+		// 원본도 정렬되어 있으면 세 워드(네 점)씩 읽음
+		if(((uintptr_t)src & 0x03) == 0)
+		{
+			const uint32_t *src32 = (const uint32_t*)src;
+			uint32_t w0, w1, w2;
+
+			while(count >= 4)
+			{
+				w0 = src32[0];
+				w1 = src32[1];
+				w2 = src32[2];
+				des32[0] = packRgb565(w0 >> 16, w0 >> 8, w0) | packRgb565(w1 >> 8, w1, w0 >> 24) << 16;
+				des32[1] = packRgb565(w2, w1 >> 24, w1 >> 16) | packRgb565(w2 >> 24, w2 >> 16, w2 >> 8) << 16;
+				des32 += 2;
+				src32 += 3;
+				count -= 4;
+			}
+
+			src = (const uint8_t*)src32;
+		}
+
+		while(count >= 2)
+		{
+			*des32++ = packRgb565(src[2], src[1], src[0]) | packRgb565(src[5], src[4], src[3]) << 16;
+			src += 6;
+			count -= 2;
+		}
+
+		if(count)
+			*(uint16_t*)des32 = packRgb565(src[2], src[1], src[0]);
+	}
+
+	void rgb888ToRgb565Dither(uint16_t *des, const uint8_t *src, uint32_t count, uint16_t x, uint16_t y)
+	{
+		const uint8_t *bayer = gBayer[y & 0x03];
+		uint32_t red, green, blue, level;
+
+		while(count--)
+		{
+			// 5비트 성분은 0 ~ 7, 6비트 성분은 0 ~ 3의 문턱 값을 더한 후 버림
+			level = bayer[x++ & 0x03];
+			blue = src[0] + (level >> 1);
+			green = src[1] + (level >> 2);
+			red = src[2] + (level >> 1);
+
+			if(blue > 0xFF)
+				blue = 0xFF;
+			if(green > 0xFF)
+				green = 0xFF;
+			if(red > 0xFF)
+				red = 0xFF;
+
+			*des++ = packRgb565(red, green, blue);
+			src += 3;
+		}
+	}
+
+	void rgb565ToRgb888(uint8_t *des, const uint16_t *src, uint32_t count)
+	{
+		uint32_t dot;
+
+		if(((uintptr_t)src & 0x03) && count)
+		{
+			unpackRgb565(des, *src++);
+			des += 3;
+			count--;
+		}
+
+		// 한 워드에서 두 점을 읽음
+		const uint32_t *src32 = (const uint32_t*)src;
+		while(count >= 2)
+		{
+			dot = *src32++;
+			unpackRgb565(des, dot);
+			unpackRgb565(des + 3, dot >> 16);
+			des += 6;
+			count -= 2;
+		}
+
+		if(count)
+			unpackRgb565(des, *(const uint16_t*)src32);
+	}
+
+	void rgb565ToArgb1555(uint16_t *des, const uint16_t *src, uint32_t count)
+	{
+		// 원본과 대상의 정렬이 다르면 한 점씩 변환
+		if(((uintptr_t)des ^ (uintptr_t)src) & 0x03)
+		{
+			while(count--)
+				*des++ = rgb565ToArgb1555(*src++);
+			return;
+		}
+
+		if(((uintptr_t)des & 0x03) && count)
+		{
+			*des++ = rgb565ToArgb1555(*src++);
+			count--;
+		}
+
+		uint32_t *des32 = (uint32_t*)des;
+		const uint32_t *src32 = (const uint32_t*)src;
+		while(count >= 2)
+		{
+			*des32++ = rgb565ToArgb1555(*src32++);
+			count -= 2;
+		}
+
+		if(count)
+			*(uint16_t*)des32 = rgb565ToArgb1555(*(const uint16_t*)src32);
+	}
+
+	void argb1555ToRgb565(uint16_t *des, const uint16_t *src, uint32_t count)
+	{
+		if(((uintptr_t)des ^ (uintptr_t)src) & 0x03)
+		{
+			while(count--)
+				*des++ = argb1555ToRgb565(*src++);
+			return;
+		}
+
+		if(((uintptr_t)des & 0x03) && count)
+		{
+			*des++ = argb1555ToRgb565(*src++);
+			count--;
+		}
+
+		uint32_t *des32 = (uint32_t*)des;
+		const uint32_t *src32 = (const uint32_t*)src;
+		while(count >= 2)
+		{
+			*des32++ = argb1555ToRgb565(*src32++);
+			count -= 2;
+		}
+
+		if(count)
+			*(uint16_t*)des32 = argb1555ToRgb565(*(const uint16_t*)src32);
+	}
+
+	void reorderRgb565(uint16_t *des, const uint16_t *src, uint32_t count, bool reverseRgb, bool reverseEndian)
+	{
+		if(((uintptr_t)des ^ (uintptr_t)src) & 0x03)
+		{
+			while(count--)
+				*des++ = reorderRgb565(*src++, reverseRgb, reverseEndian);
+			return;
+		}
+
+		if(((uintptr_t)des & 0x03) && count)
+		{
+			*des++ = reorderRgb565(*src++, reverseRgb, reverseEndian);
+			count--;
+		}
+
+		uint32_t *des32 = (uint32_t*)des;
+		const uint32_t *src32 = (const uint32_t*)src;
+		while(count >= 2)
+		{
+			*des32++ = reorderRgb565(*src32++, reverseRgb, reverseEndian);
+			count -= 2;
+		}
+
+		if(count)
+			*(uint16_t*)des32 = reorderRgb565(*(const uint16_t*)src32, reverseRgb, reverseEndian);
+	}
+
+	void reorderRgb888(uint8_t *des, const uint8_t *src, uint32_t count)
+	{
+		uint8_t buf;
+
+		while(count--)
+		{
+			buf = src[0];
+			des[1] = src[1];
+			des[0] = src[2];
+			des[2] = buf;
+			des += 3;
+			src += 3;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <drv/mcu.h>
+#include <gui/Fill.h>
+#include <gui/util.h>
+#include <std_ext/string.h>
+
+// DMA로 채우기 시작하는 워드의 수
+// DMA는 CPU의 stmia보다 느리지만 전송하는 동안 다른 쓰레드가 실행되므로 큰 영역에만 사용한다.
+#if !defined(FILL_DMA_THRESHOLD)
+#define FILL_DMA_THRESHOLD	2048
+#endif
+
+namespace fill
+{
+	static inline void fillWord(uint32_t *des, uint32_t pattern0, uint32_t pattern1, uint32_t count)
+	{
+#if defined(YSS_MEMDMA_SUPPORT) || defined(YSS__DMA_ALLOCATION)
+		if(pattern0 == pattern1 && count >= FILL_DMA_THRESHOLD)
+		{
+			memsetwd(des, pattern0, count);
+			return;
+		}
+#endif
+		copyWordPattern(des, pattern0, pattern1, count);
+	}
+
+	void dot16(void *des, uint16_t color, uint32_t count)
+	{
+		uint16_t *des16 = (uint16_t*)des;
+		uint32_t word = color | (uint32_t)color << 16;
+
+		// 대상을 4바이트 정렬
+		if(((uintptr_t)des16 & 0x03) && count)
+		{
+			*des16++ = color;
+			count--;
+		}
+
+		fillWord((uint32_t*)des16, word, word, count >> 1);
+
+		if(count & 0x01)
+			des16[count - 1] = color;
+	}
+
+	void dot24(void *des, uint32_t color, uint32_t count)
+	{
+		copyRgb888DotPattern(des, color, count);
+	}
+
+	void pattern16(void *des, const uint16_t *pattern, uint32_t count)
+	{
+		uint16_t *des16 = (uint16_t*)des;
+		uint32_t phase = 0, word0, word1;
+
+		// 대상을 4바이트 정렬하고 패턴의 시작 위치를 하나 옮김
+		if(((uintptr_t)des16 & 0x03) && count)
+		{
+			*des16++ = pattern[0];
+			phase = 1;
+			count--;
+		}
+
+		word0 = pattern[phase] | (uint32_t)pattern[(phase + 1) & 0x03] << 16;
+		word1 = pattern[(phase + 2) & 0x03] | (uint32_t)pattern[(phase + 3) & 0x03] << 16;
+		fillWord((uint32_t*)des16, word0, word1, count >> 1);
+
+		if(count & 0x01)
+			des16[count - 1] = pattern[(phase + count - 1) & 0x03];
+	}
+
+	void rect16(void *des, uint32_t stride, uint16_t width, uint16_t height, uint16_t color)
+	{
+		uint8_t *line = (uint8_t*)des;
+
+		if(stride == width * 2u)
+		{
+			dot16(des, color, (uint32_t)width * height);
+			return;
+		}
+
+		while(height--)
+		{
+			dot16(line, color, width);
+			line += stride;
+		}
+	}
+
+	void rect24(void *des, uint32_t stride, uint16_t width, uint16_t height, uint32_t color)
+	{
+		uint8_t *line = (uint8_t*)des;
+
+		if(stride == width * 3u)
+		{
+			dot24(des, color, (uint32_t)width * height);
+			return;
+		}
+
+		while(height--)
+		{
+			dot24(line, color, width);
+			line += stride;
+		}
+	}
+
+	void patternRect16(void *des, uint32_t stride, uint16_t width, uint16_t height, const uint16_t *pattern)
+	{
+		uint8_t *line = (uint8_t*)des;
+
+		for(uint16_t y = 0; y < height; y++)
+		{
+			pattern16(line, &pattern[(y & 0x03) * 4], width);
+			line += stride;
+		}
+	}
+}
+
+#endif
+
@@ -16,6 +16,105 @@ Font::Font(void)
 	mSpaceWidth = 0;
 	mCharWidth = 0;
 	mSize = 0;
+	mDataFormat = DATA_FORMAT_A4;
+}
+
+uint8_t Font::getDataFormat(void)
+{
+	return mDataFormat;
+}
+
+uint16_t Font::getDataStride(uint8_t width)
+{
+	switch(mDataFormat)
+	{
+	case DATA_FORMAT_A2 :
+		return (width + 3) & ~0x03;
+
+	case DATA_FORMAT_A1 :
+		return (width + 7) & ~0x07;
+
+	default :
+		return (width + 1) & ~0x01;
+	}
+}
+
+void Font::Decoder::begin(const uint8_t *data, uint8_t format)
+{
+	mData = data;
+	mFormat = format;
+	mRemain = 0;
+	mBuffer = 0;
+	mLevel = 0;
+	mOddFlag = false;
+
+	switch(format)
+	{
+	case DATA_FORMAT_A2 :
+		mBits = 2;
+		mMask = 0x03;
+		mScale = 5;
+		break;
+
+	case DATA_FORMAT_A1 :
+		mBits = 1;
+		mMask = 0x01;
+		mScale = 15;
+		break;
+
+	default :
+		mBits = 4;
+		mMask = 0x0F;
+		mScale = 1;
+		break;
+	}
+}
+
+void Font::Decoder::skip(uint32_t count)
+{
+	if(mFormat == DATA_FORMAT_RLE)
+	{
+		while(count)
+		{
+			if(mRemain == 0)
+				fetchToken();
+
+			if(mLevel == LITERAL)
+			{
+				getLevel();
+				count--;
+			}
+			else if(count >= mRemain)
+			{
+				count -= mRemain;
+				mRemain = 0;
+			}
+			else
+			{
+				mRemain -= count;
+				count = 0;
+			}
+		}
+		return;
+	}
+
+	// 남아있는 비트를 먼저 소진하고 나머지는 바이트 단위로 건너뛴다.
+	while(count && mRemain)
+	{
+		mBuffer >>= mBits;
+		mRemain -= mBits;
+		count--;
+	}
+
+	count *= mBits;
+	mData += count >> 3;
+	count &= 0x07;
+
+	if(count)
+	{
+		mBuffer = *mData++ >> count;
+		mRemain = 8 - count;
+	}
 }
 
 uint8_t Font::getSpaceWidth(void)
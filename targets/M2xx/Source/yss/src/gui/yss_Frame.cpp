@@ -18,9 +18,12 @@
 Frame::Frame()
 {
 	mOutputFrameBuffer = 0;
+	mHoldFlag = false;
+	mDirtyFlag = false;
 	mFrameBuffer->setSize(ltdc.getLcdSize());
 	mResizeAble = false;
 	mFrameBuffer->clear();
+	resetIndex();
 }
 
 Frame::~Frame(void)
@@ -50,6 +53,12 @@ void Frame::setOutputFrameBuffer(OutputFrameBuffer *outputFrameBuffer)
 
 void Frame::update(void)
 {
+	if(mHoldFlag)
+	{
+		addDirtyArea(Position_t{0, 0}, mFrameBuffer->getSize());
+		return;
+	}
+
 	update(mPos, mFrameBuffer->getSize());
 
 	if(mOutputFrameBuffer)
@@ -58,17 +67,14 @@ void Frame::update(void)
 
 void Frame::update(Position_t pos, Size_t size)
 {
-	Object *obj;
-
-	mFrameBuffer->eraseRectangle(pos, size);
-
-	for (uint16_t i = 0; i < mNumOfObj; i++)
+	if(mHoldFlag)
 	{
-		obj = mObjArr[i];
-		if (obj->isVisible())
-			mFrameBuffer->drawObjectToPartialArea(pos, size, obj);
+		addDirtyArea(pos, size);
+		return;
 	}
 
+	drawArea(pos, size);
+
 	if (mOutputFrameBuffer)
 	{
 		pos.x += mPos.x;
@@ -79,21 +85,16 @@ void Frame::update(Position_t pos, Size_t size)
 
 void Frame::update(Position_t beforePos, Size_t beforeSize, Position_t currentPos, Size_t currentSize)
 {
-	Object *obj;
-
-	mFrameBuffer->eraseRectangle(beforePos, beforeSize);
-	mFrameBuffer->eraseRectangle(currentPos, currentSize);
-
-	for (uint16_t i = 0; i < mNumOfObj; i++)
+	if(mHoldFlag)
 	{
-		obj = mObjArr[i];
-		if (obj->isVisible())
-		{
-			mFrameBuffer->drawObjectToPartialArea(beforePos, beforeSize, obj);
-			mFrameBuffer->drawObjectToPartialArea(currentPos, currentSize, obj);
-		}
+		addDirtyArea(beforePos, beforeSize);
+		addDirtyArea(currentPos, currentSize);
+		return;
 	}
 
+	drawArea(beforePos, beforeSize);
+	drawArea(currentPos, currentSize);
+
 	if (mOutputFrameBuffer)
 	{
 		beforePos.x += mPos.x;
@@ -104,6 +105,51 @@ void Frame::update(Position_t beforePos, Size_t beforeSize, Position_t currentPo
 	}
 }
 
+void Frame::beginUpdate(void)
+{
+	mHoldFlag = true;
+}
+
+void Frame::endUpdate(void)
+{
+	mHoldFlag = false;
+
+	if(mDirtyFlag)
+	{
+		mDirtyFlag = false;
+		update(mDirtyPos, mDirtySize);
+	}
+}
+
+void Frame::addDirtyArea(Position_t pos, Size_t size)
+{
+	int32_t sx, sy, ex, ey;
+
+	if(size.width == 0 || size.height == 0)
+		return;
+
+	if(mDirtyFlag == false)
+	{
+		mDirtyPos = pos;
+		mDirtySize = size;
+		mDirtyFlag = true;
+		return;
+	}
+
+	// 기존 영역과 합친 사각형
+	sx = pos.x < mDirtyPos.x ? pos.x : mDirtyPos.x;
+	sy = pos.y < mDirtyPos.y ? pos.y : mDirtyPos.y;
+	ex = pos.x + size.width;
+	if(ex < mDirtyPos.x + mDirtySize.width)
+		ex = mDirtyPos.x + mDirtySize.width;
+	ey = pos.y + size.height;
+	if(ey < mDirtyPos.y + mDirtySize.height)
+		ey = mDirtyPos.y + mDirtySize.height;
+
+	mDirtyPos = Position_t{(int16_t)sx, (int16_t)sy};
+	mDirtySize = Size_t{(uint16_t)(ex - sx), (uint16_t)(ey - sy)};
+}
+
 void Frame::add(Object &obj)
 {
 	obj.paint();
@@ -112,6 +158,7 @@ void Frame::add(Object &obj)
 		increaseObjArr();
 
 	mObjArr[mNumOfObj] = &obj;
+	addIndex(mNumOfObj, obj.getPosition(), obj.getSize());
 	mNumOfObj++;
 
 	obj.setParent(this);
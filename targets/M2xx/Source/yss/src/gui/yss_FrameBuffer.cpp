@@ -17,6 +17,9 @@ FrameBuffer::FrameBuffer(void)
 {
 	mFrameBuffer = 0;
 	mMemAllocFlag = false;
+	mPalette = 0;
+	mDotSize = 0;
+	mDotBit = 0;
 }
 
 error_t FrameBuffer::setColorMode(uint8_t colorMode)
@@ -25,16 +28,39 @@ error_t FrameBuffer::setColorMode(uint8_t colorMode)
 	{
 	case COLOR_MODE_RGB888 :
 		mDotSize  = 3;
+		mDotBit = 24;
 		mColorMode = colorMode;
 		return error_t::ERROR_NONE;
 	case COLOR_MODE_RGB565 :
 		mDotSize  = 2;
+		mDotBit = 16;
 		mColorMode = colorMode;
 		return error_t::ERROR_NONE;
 	case COLOR_MODE_ARGB1555 :
 		mDotSize  = 2;
+		mDotBit = 16;
 		mColorMode = colorMode;
 		return error_t::ERROR_NONE;		
+	case COLOR_MODE_INDEX8 :
+		mDotSize  = 1;
+		mDotBit = 8;
+		mColorMode = colorMode;
+		return error_t::ERROR_NONE;
+	case COLOR_MODE_INDEX4 :
+		mDotSize  = 1;
+		mDotBit = 4;
+		mColorMode = colorMode;
+		return error_t::ERROR_NONE;
+	case COLOR_MODE_INDEX2 :
+		mDotSize  = 1;
+		mDotBit = 2;
+		mColorMode = colorMode;
+		return error_t::ERROR_NONE;
+	case COLOR_MODE_INDEX1 :
+		mDotSize  = 1;
+		mDotBit = 1;
+		mColorMode = colorMode;
+		return error_t::ERROR_NONE;
 
 	default :
 		return error_t::NOT_SUPPORTED_FORMAT;
@@ -75,9 +101,9 @@ error_t FrameBuffer::setSize(uint16_t width, uint16_t height)
 	// 메모리가 할당가능하다면 새로 메모리를 할당 받는다.
 	if(mMemAllocFlag)
 #if YSS_L_HEAP_USE
-		mFrameBuffer = (uint8_t *)lmalloc(width * height * mDotSize);
+		mFrameBuffer = (uint8_t *)lmalloc(getLineSize() * height);
 #else
-		mFrameBuffer = new uint8_t[width * height * mDotSize];
+		mFrameBuffer = new uint8_t[getLineSize() * height];
 #endif
 
 	return error_t::ERROR_NONE;
@@ -114,5 +140,40 @@ uint8_t FrameBuffer::getDotSize(void)
 	return mDotSize;
 }
 
+uint8_t FrameBuffer::getDotBit(void)
+{
+	return mDotBit;
+}
+
+uint32_t FrameBuffer::getLineSize(void)
+{
+	return (mSize.width * mDotBit + 7) / 8;
+}
+
+void FrameBuffer::setPalette(Palette *palette)
+{
+	mPalette = palette;
+}
+
+Palette* FrameBuffer::getPalette(void)
+{
+	return mPalette;
+}
+
+bool FrameBuffer::isIndexedColorMode(void)
+{
+	switch(mColorMode)
+	{
+	case COLOR_MODE_INDEX8 :
+	case COLOR_MODE_INDEX4 :
+	case COLOR_MODE_INDEX2 :
+	case COLOR_MODE_INDEX1 :
+		return true;
+
+	default :
+		return false;
+	}
+}
+
 #endif
 
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/GlyphCache.h>
+#include <string.h>
+
+GlyphCache::GlyphCache(void *arena, uint32_t size, uint16_t maxGlyph)
+{
+	mMemAllocFlag = false;
+	initialize(arena, size, maxGlyph);
+}
+
+GlyphCache::GlyphCache(uint32_t size, uint16_t maxGlyph)
+{
+	mMemAllocFlag = true;
+	initialize(new uint32_t[(size + 3) / 4], size, maxGlyph);
+}
+
+GlyphCache::~GlyphCache(void)
+{
+	if(mMemAllocFlag && mArena)
+		delete[] (uint32_t*)mArena;
+}
+
+void GlyphCache::initialize(void *arena, uint32_t size, uint16_t maxGlyph)
+{
+	uint32_t tableSize = sizeof(glyph_t) * maxGlyph;
+
+	mArena = (uint8_t*)arena;
+	mHitCount = 0;
+	mMissCount = 0;
+
+	// 항목 테이블도 들어가지 않는 크기라면 캐시를 사용하지 않는다.
+	if(mArena == 0 || size <= tableSize)
+	{
+		mGlyph = 0;
+		mData = 0;
+		mDataSize = 0;
+		mMaxGlyph = 0;
+	}
+	else
+	{
+		mGlyph = (glyph_t*)mArena;
+		mData = mArena + tableSize;
+		mDataSize = size - tableSize;
+		mMaxGlyph = maxGlyph;
+	}
+
+	clear();
+}
+
+void GlyphCache::clear(void)
+{
+	for(uint16_t i = 0; i < mMaxGlyph; i++)
+		mGlyph[i].font = 0;
+
+	mHead = NONE;
+	mTail = NONE;
+	mNumOfGlyph = 0;
+	mTop = 0;
+	mUsedSize = 0;
+}
+
+void GlyphCache::unlink(uint16_t index)
+{
+	glyph_t *glyph = &mGlyph[index];
+
+	if(glyph->prev != NONE)
+		mGlyph[glyph->prev].next = glyph->next;
+	else
+		mHead = glyph->next;
+
+	if(glyph->next != NONE)
+		mGlyph[glyph->next].prev = glyph->prev;
+	else
+		mTail = glyph->prev;
+}
+
+void GlyphCache::linkToHead(uint16_t index)
+{
+	glyph_t *glyph = &mGlyph[index];
+
+	glyph->prev = NONE;
+	glyph->next = mHead;
+
+	if(mHead != NONE)
+		mGlyph[mHead].prev = index;
+	else
+		mTail = index;
+
+	mHead = index;
+}
+
+GlyphCache::glyph_t* GlyphCache::find(Font *font, uint32_t utf8, uint32_t fgColor, uint32_t bgColor, uint8_t colorMode)
+{
+	glyph_t *glyph;
+
+	for(uint16_t i = mHead; i != NONE; i = glyph->next)
+	{
+		glyph = &mGlyph[i];
+
+		if(glyph->utf8 == utf8 && glyph->font == font && glyph->fgColor == fgColor && glyph->bgColor == bgColor && glyph->colorMode == colorMode)
+		{
+			if(i != mHead)
+			{
+				unlink(i);
+				linkToHead(i);
+			}
+
+			mHitCount++;
+			return glyph;
+		}
+	}
+
+	mMissCount++;
+	return 0;
+}
+
+void GlyphCache::evict(void)
+{
+	uint16_t index = mTail;
+
+	if(index == NONE)
+		return;
+
+	unlink(index);
+	mUsedSize -= mGlyph[index].size;
+	mGlyph[index].font = 0;
+	mNumOfGlyph--;
+
+	// 가장 위의 이미지가 제거되면 바로 그 공간을 재사용한다.
+	if(mGlyph[index].offset + mGlyph[index].size == mTop)
+		mTop = mGlyph[index].offset;
+
+	if(mNumOfGlyph == 0)
+		mTop = 0;
+}
+
+void GlyphCache::compact(void)
+{
+	uint32_t top = 0, lowest;
+	uint16_t index;
+
+	// 낮은 주소의 이미지부터 차례로 앞으로 당긴다.
+	while(1)
+	{
+		index = NONE;
+		lowest = 0xFFFFFFFF;
+
+		for(uint16_t i = 0; i < mMaxGlyph; i++)
+		{
+			if(mGlyph[i].font && mGlyph[i].offset >= top && mGlyph[i].offset < lowest)
+			{
+				lowest = mGlyph[i].offset;
+				index = i;
+			}
+		}
+
+		if(index == NONE)
+			break;
+
+		if(lowest != top)
+		{
+			memmove(&mData[top], &mData[lowest], mGlyph[index].size);
+			mGlyph[index].offset = top;
+		}
+
+		top += mGlyph[index].size;
+	}
+
+	mTop = top;
+}
+
+GlyphCache::glyph_t* GlyphCache::allocate(Font *font, uint32_t utf8, uint32_t fgColor, uint32_t bgColor, uint8_t colorMode, uint32_t size)
+{
+	uint16_t index = NONE;
+	glyph_t *glyph;
+
+	size = (size + 3) & ~0x03; // 다음 이미지가 4바이트 정렬이 되도록 함
+
+	if(mMaxGlyph == 0 || size > mDataSize)
+		return 0;
+
+	if(mNumOfGlyph == mMaxGlyph)
+		evict();
+
+	while(mTop + size > mDataSize)
+	{
+		if(mDataSize - mUsedSize >= size)
+			compact();
+		else
+			evict();
+	}
+
+	for(uint16_t i = 0; i < mMaxGlyph; i++)
+	{
+		if(mGlyph[i].font == 0)
+		{
+			index = i;
+			break;
+		}
+	}
+
+	glyph = &mGlyph[index];
+	glyph->font = font;
+	glyph->utf8 = utf8;
+	glyph->fgColor = fgColor;
+	glyph->bgColor = bgColor;
+	glyph->colorMode = colorMode;
+	glyph->offset = mTop;
+	glyph->size = size;
+
+	mTop += size;
+	mUsedSize += size;
+	mNumOfGlyph++;
+	linkToHead(index);
+
+	return glyph;
+}
+
+uint8_t* GlyphCache::getData(glyph_t *glyph)
+{
+	return &mData[glyph->offset];
+}
+
+uint32_t GlyphCache::getHitCount(void)
+{
+	return mHitCount;
+}
+
+uint32_t GlyphCache::getMissCount(void)
+{
+	return mMissCount;
+}
+
+#endif
+
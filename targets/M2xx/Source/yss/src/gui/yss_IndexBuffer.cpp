@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/IndexBuffer.h>
+#include <gui/BitmapDecoder.h>
+#include <string.h>
+
+IndexBuffer::IndexBuffer(uint32_t pointSize, uint8_t colorMode, uint16_t paletteSize)
+{
+	uint16_t maxPaletteSize;
+
+	enableMemoryAlloc(false);
+	if(setColorMode(colorMode) != error_t::ERROR_NONE || !isIndexedColorMode())
+		setColorMode(COLOR_MODE_INDEX8);
+
+	maxPaletteSize = 1 << mDotBit;
+	if(paletteSize == 0 || paletteSize > maxPaletteSize)
+		paletteSize = maxPaletteSize;
+
+	// 색상표 바로 뒤에 팔레트 번호를 저장
+	mBufferSize = (pointSize * mDotBit + 7) / 8;
+	mData = new uint8_t[1 + paletteSize * 2 + mBufferSize];
+	mIndex = &mData[1 + paletteSize * 2];
+	mLineSize = 0;
+
+	mIndexPalette = new Palette(mData, paletteSize);
+	setPalette(mIndexPalette);
+
+	mBitmap.width = 0;
+	mBitmap.height = 0;
+	mBitmap.type = BitmapDecoder::TYPE_INDEX8 + (mColorMode - COLOR_MODE_INDEX8);
+	mBitmap.data = mData;
+
+	mBrushColorCode = 0;
+	mBgColorCode = 0;
+	updateFontColor();
+}
+
+IndexBuffer::~IndexBuffer(void)
+{
+	delete mIndexPalette;
+	delete[] mData;
+}
+
+error_t IndexBuffer::setSize(uint16_t width, uint16_t height)
+{
+	uint32_t lineSize = (width * mDotBit + 7) / 8;
+
+	if (mBufferSize < lineSize * height)
+		return error_t::OVERSIZE;
+
+	mLineSize = lineSize;
+	mBitmap.width = width;
+	mBitmap.height = height;
+	mSize = Size_t{width, height};
+
+	return error_t::ERROR_NONE;
+}
+
+error_t IndexBuffer::setSize(Size_t size)
+{
+	return setSize(size.width, size.height);
+}
+
+Bitmap_t *IndexBuffer::getBitmap(void)
+{
+	return &mBitmap;
+}
+
+uint32_t IndexBuffer::getBufferSize(void)
+{
+	return mBufferSize;
+}
+
+uint8_t* IndexBuffer::getIndexBuffer(void)
+{
+	return mIndex;
+}
+
+uint8_t IndexBuffer::getDot(int16_t x, int16_t y)
+{
+	uint32_t bit = x * mDotBit;
+
+	return (mIndex[y * mLineSize + (bit >> 3)] >> (bit & 0x07)) & ((1 << mDotBit) - 1);
+}
+
+uint8_t IndexBuffer::getIndexedDot(int16_t x, int16_t y)
+{
+	return getDot(x, y);
+}
+
+void IndexBuffer::drawDot(int16_t x, int16_t y)
+{
+	setDot(x, y, mBrushColorCode);
+}
+
+void IndexBuffer::drawDot(int16_t x, int16_t y, Color color)
+{
+	setDot(x, y, findPaletteIndex(color));
+}
+
+void IndexBuffer::drawDot(int16_t x, int16_t y, uint32_t color)
+{
+	setDot(x, y, color);
+}
+
+void IndexBuffer::fillRectBase(Position_t pos, Size_t size, uint32_t color)
+{
+	int32_t sx = pos.x, ex = pos.x + size.width, sy = pos.y, ey = pos.y + size.height, x, bytes;
+	uint8_t pattern, *line;
+
+	if (sx < 0)
+		sx = 0;
+	if (sy < 0)
+		sy = 0;
+	if (ex > mSize.width)
+		ex = mSize.width;
+	if (ey > mSize.height)
+		ey = mSize.height;
+	if (sx >= ex || sy >= ey)
+		return;
+
+	// 한 바이트에 들어가는 점들을 모두 같은 번호로 채운 값
+	pattern = color & ((1 << mDotBit) - 1);
+	for (uint8_t bit = mDotBit; bit < 8; bit <<= 1)
+		pattern |= pattern << bit;
+
+	line = &mIndex[sy * mLineSize];
+	for (int32_t y = sy; y < ey; y++)
+	{
+		x = sx;
+
+		// 바이트의 경계까지는 점 단위로 채움
+		while (x < ex && ((x * mDotBit) & 0x07))
+			setDot(x++, y, color);
+
+		bytes = ((ex - x) * mDotBit) >> 3;
+		if (bytes)
+		{
+			memset(&line[(x * mDotBit) >> 3], pattern, bytes);
+			x += (bytes << 3) / mDotBit;
+		}
+
+		while (x < ex)
+			setDot(x++, y, color);
+
+		line += mLineSize;
+	}
+}
+
+#endif
+
@@ -54,6 +54,11 @@ void Label::setFont(Font &font)
 	mFrameBuffer->setFont(font);
 }
 
+void Label::setTextLayout(TextLayout &layout)
+{
+	mFrameBuffer->setTextLayout(&layout);
+}
+
 void Label::setBackgroundColor(Color color)
 {
 	mFrameBuffer->setBackgroundColor(color);
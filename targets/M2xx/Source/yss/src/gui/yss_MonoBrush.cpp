@@ -42,54 +42,50 @@ uint8_t MonoBrush::drawChar(Position_t pos, uint32_t utf8, bool data)
 		return 0;
 
 	Font::fontInfo_t *fontInfo = mFont->getFontInfo(utf8);
-	uint8_t *fontFb, color;
-	int32_t  index = 0;
-	uint16_t width = fontInfo->width, height = fontInfo->height, offset = 0, xoffset;
-	int16_t xs = pos.x, ys = pos.y + (int8_t)fontInfo->ypos;
+	Font::Decoder decoder;
+	uint16_t width, height, stride, offset = 0, xoffset;
+	int16_t xs, ys;
 
 	if(fontInfo == 0)
 		return 0;
 	
-	fontFb = fontInfo->data;
 	xoffset = fontInfo->xpos;
 	if(xoffset == 0)
 		xoffset = 1;
 	
-	xs += xoffset;
-
-	if (xs + width > mSize.width)
+	xs = pos.x + xoffset;
+	ys = pos.y + (int8_t)fontInfo->ypos;
+	width = fontInfo->width;
+	height = fontInfo->height;
+	stride = mFont->getDataStride(fontInfo->width);
+	offset = stride - width;
+
+	if (xs > mSize.width || ys > mSize.height)
+		return fontInfo->width;
+
+	// mSize는 마지막 점의 좌표이므로 마지막 줄과 열까지 그림
+	if (xs + width > mSize.width + 1)
 	{
-		width = mSize.width - xs;
-		offset = fontInfo->width - width;
+		width = mSize.width + 1 - xs;
+		offset = stride - width;
 	}
-	if (ys + height > mSize.height)
-		height = mSize.height - ys;
+	if (ys + height > mSize.height + 1)
+		height = mSize.height + 1 - ys;
 
-	width += xs;
-	height += ys;
+	decoder.begin(fontInfo->data, mFont->getDataFormat());
 
-	for (int32_t  y = ys; y < height; y++)
+	for (int32_t  y = ys; y < ys + height; y++)
 	{
-		for (int32_t  x = xs; x < width; x++, index++)
+		for (int32_t  x = xs; x < xs + width; x++)
 		{
-			if (index % 2 == 0)
-			{
-				color = fontFb[index / 2] & 0x0f;
-				if (color > 5)
-					drawDot(x, y, data);
-				else
-					drawDot(x, y, !data);
-			}
+			if (decoder.getLevel() > 5)
+				drawDot(x, y, data);
 			else
-			{
-				color = (fontFb[index / 2] >> 4) & 0x0f;
-				if (color > 5)
-					drawDot(x, y, data);
-				else
-					drawDot(x, y, !data);
-			}
+				drawDot(x, y, !data);
 		}
-		index += offset;
+
+		if(offset)
+			decoder.skip(offset);
 	}
 
 	return fontInfo->width;
@@ -140,27 +136,31 @@ uint8_t MonoBrush::drawString(Position_t pos, const char *str, bool data)
 
 void MonoBrush::clear(void)
 {
-	uint16_t width = mSize.width, height = mSize.height;
-
-	for (int32_t  y = 0; y < height; y++)
-	{
-		for (int32_t  x = 0; x < width; x++)
-		{
-			drawDot(x, y, false);
-		}
-	}
+	fillRectBase(Position_t{0, 0}, Size_t{(uint16_t)(mSize.width + 1), (uint16_t)(mSize.height + 1)}, false);
 }
 
 void MonoBrush::fill(void)
 {
-	uint16_t width = mSize.width, height = mSize.height;
+	fillRectBase(Position_t{0, 0}, Size_t{(uint16_t)(mSize.width + 1), (uint16_t)(mSize.height + 1)}, true);
+}
 
-	for (int32_t  y = 0; y < height; y++)
+void MonoBrush::fillRectBase(Position_t pos, Size_t size, bool data)
+{
+	int32_t sx = pos.x, ex = pos.x + size.width - 1, sy = pos.y, ey = pos.y + size.height - 1;
+
+	if (sx < 0)
+		sx = 0;
+	if (sy < 0)
+		sy = 0;
+	if (ey > mSize.height)
+		ey = mSize.height;
+	if (ex > mSize.width)
+		ex = mSize.width;
+
+	for (int32_t y = sy; y <= ey; y++)
 	{
-		for (int32_t  x = 0; x < width; x++)
-		{
-			drawDot(x, y, true);
-		}
+		for (int32_t x = sx; x <= ex; x++)
+			drawDot(x, y, data);
 	}
 }
 
@@ -362,32 +362,12 @@ void MonoBrush::fillRect(Position_t p1, Position_t p2, bool data)
 		ey = p1.y;
 	}
 
-	if (ey > mSize.height - 1)
-		ey = mSize.height - 1;
-	if (ex > mSize.width - 1)
-		ex = mSize.width - 1;
-
-	for (int16_t y = sy; y <= ey; y++)
-	{
-		for (int16_t x = sx; x <= ex; x++)
-			drawDot(x, y, data);
-	}
+	fillRectBase(Position_t{sx, sy}, Size_t{(uint16_t)(ex - sx + 1), (uint16_t)(ey - sy + 1)}, data);
 }
 
 void MonoBrush::fillRect(Position_t pos, Size_t size, bool data)
 {
-	int16_t sx = pos.x, ex = pos.x + size.width, sy = pos.y, ey = pos.y + size.height;
-
-	if (ey > mSize.height - 1)
-		ey = mSize.height - 1;
-	if (ex > mSize.width - 1)
-		ex = mSize.width - 1;
-
-	for (int16_t y = sy; y <= ey; y++)
-	{
-		for (int16_t x = sx; x <= ex; x++)
-			drawDot(x, y, data);
-	}
+	fillRectBase(pos, Size_t{(uint16_t)(size.width + 1), (uint16_t)(size.height + 1)}, data);
 }
 
 #endif
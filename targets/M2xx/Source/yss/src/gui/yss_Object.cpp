@@ -19,6 +19,7 @@ Object::Object(void)
 	mParent = 0;
 	mVisibleFlag = true;
 	mResizeAble = true;
+	mOpaqueFlag = false;
 
 	mFrameBuffer = new YSS_GUI_FRAME_BUFFER;
 }
@@ -65,6 +66,9 @@ void Object::setPosition(int16_t x, int16_t y)
 	Size_t size = mFrameBuffer->getSize();
 	Position_t before = mPos;
 	mPos = Position_t{x, y};
+
+	if(mParent)
+		mParent->relocate(*this, before, size);
 	update(before, size, mPos, size);
 }
 
@@ -77,10 +81,14 @@ void Object::setSize(Size_t size)
 {
 	if(mResizeAble)
 	{
+		Size_t before = mFrameBuffer->getSize();
+
 		mFrameBuffer->setSize(size.width, size.height);
+		if(mParent)
+			mParent->relocate(*this, mPos, before);
 		eventSizeChanged(size);
 		paint();
-		update(mPos, size, mPos, size);
+		update(mPos, before, mPos, size);
 	}
 }
 
@@ -100,6 +108,16 @@ bool Object::isVisible(void)
 	return mVisibleFlag;
 }
 
+void Object::setOpaque(bool en)
+{
+	mOpaqueFlag = en;
+}
+
+bool Object::isOpaque(void)
+{
+	return mOpaqueFlag;
+}
+
 void Object::setParent(Container *parent)
 {
 	mParent = parent;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/PackedFont.h>
+
+// Font::getUtf8()로 얻은 UTF-8 코드를 유니코드 값으로 변환한다.
+static uint32_t convertToUnicode(uint32_t utf8)
+{
+	if(utf8 >= 0xE00000)
+		return ((utf8 >> 4) & 0xF000) | ((utf8 >> 2) & 0x0FC0) | (utf8 & 0x3F);
+	else if(utf8 >= 0xC000)
+		return ((utf8 >> 2) & 0x07C0) | (utf8 & 0x3F);
+	else
+		return utf8;
+}
+
+PackedFont::PackedFont(const packedFontInfo_t *info)
+{
+	mInfo = info;
+	mSize = info->size;
+	mSpaceWidth = mSize / 3;
+	mDataFormat = info->dataFormat;
+}
+
+Font::fontInfo_t *PackedFont::getFontInfo(uint32_t ch)
+{
+	uint32_t code = convertToUnicode(ch), group;
+	int32_t low, high, mid;
+	const Font::fontInfo_t *info = mInfo->fontInfo;
+
+	if(code < mInfo->firstCode)
+		return 0;
+
+	group = (code - mInfo->firstCode) >> mInfo->indexShift;
+	if(group >= mInfo->numOfIndex)
+		return 0;
+
+	low = mInfo->index[group];
+	high = (int32_t)mInfo->index[group + 1] - 1;
+
+	while(low <= high)
+	{
+		mid = (low + high) >> 1;
+
+		if(info[mid].utf8Code == ch)
+			return (Font::fontInfo_t*)&info[mid];
+		else if(info[mid].utf8Code < ch)
+			low = mid + 1;
+		else
+			high = mid - 1;
+	}
+
+	return 0;
+}
+
+#endif
+
@@ -268,6 +268,10 @@ uint8_t Painter::drawChar(Position_t pos, uint32_t utf8)
 	
 	if(fontInfo == 0)
 		return 0;
+	
+	// Dma2d는 A4 형식만 처리할 수 있으므로 그 외의 형식은 소프트웨어로 그린다.
+	if(mFont->getDataFormat() != Font::DATA_FORMAT_A4)
+		return Brush::drawChar(pos, utf8);
 
 	srcSize = Size_t{fontInfo->width, fontInfo->height};
 	if(srcSize.width & 0x01)
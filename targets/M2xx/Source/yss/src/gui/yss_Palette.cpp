@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/Palette.h>
+
+Palette::Palette(uint16_t size)
+{
+	if(size == 0)
+		size = 1;
+	else if(size > 256)
+		size = 256;
+
+	mData = new uint8_t[1 + size * 2];
+	mAllocFlag = true;
+	initialize(size);
+}
+
+Palette::Palette(uint8_t *data, uint16_t size)
+{
+	if(size == 0)
+		size = 1;
+	else if(size > 256)
+		size = 256;
+
+	mData = data;
+	mAllocFlag = false;
+	initialize(size);
+}
+
+Palette::~Palette(void)
+{
+	if(mAllocFlag)
+		delete[] mData;
+	delete[] mColor;
+}
+
+void Palette::initialize(uint16_t size)
+{
+	mSize = size;
+	mColor = new Color[size];
+	mLastFlag = false;
+	mData[0] = size - 1;
+
+	for(uint16_t i = 0; i < size; i++)
+		setColor(i, 0, 0, 0);
+}
+
+void Palette::setColor(uint8_t index, Color color)
+{
+	uint16_t code;
+
+	if(index >= mSize)
+		return;
+
+	mColor[index] = color;
+	code = color.getRgb565Code();
+	mData[1 + index * 2] = code;
+	mData[2 + index * 2] = code >> 8;
+	mLastFlag = false;
+}
+
+void Palette::setColor(uint8_t index, uint8_t red, uint8_t green, uint8_t blue)
+{
+	setColor(index, Color(red, green, blue));
+}
+
+Color Palette::getColor(uint8_t index)
+{
+	if(index >= mSize)
+		return Color();
+
+	return mColor[index];
+}
+
+uint16_t Palette::getSize(void)
+{
+	return mSize;
+}
+
+uint8_t Palette::findIndex(Color color)
+{
+	uint8_t red, green, blue, alpha, r, g, b, a;
+	int32_t dr, dg, db;
+	uint32_t distance, min = 0xFFFFFFFF;
+
+	if(mLastFlag && !mLastColor.compare(color))
+		return mLastIndex;
+
+	color.getColor(red, green, blue, alpha);
+
+	for(uint16_t i = 0; i < mSize; i++)
+	{
+		mColor[i].getColor(r, g, b, a);
+		dr = r - red;
+		dg = g - green;
+		db = b - blue;
+		distance = dr * dr + dg * dg + db * db;
+
+		if(distance < min)
+		{
+			min = distance;
+			mLastIndex = i;
+			if(distance == 0)
+				break;
+		}
+	}
+
+	mLastColor = color;
+	mLastFlag = true;
+
+	return mLastIndex;
+}
+
+const uint8_t* Palette::getData(void)
+{
+	return mData;
+}
+
+#endif
+
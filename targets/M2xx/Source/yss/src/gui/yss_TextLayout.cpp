@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <config.h>
+
+#if USE_GUI
+
+#include <gui/TextLayout.h>
+#include <string.h>
+
+TextLayout::TextLayout(uint16_t numOfRun, uint16_t maxLength)
+{
+	mNumOfRun = numOfRun;
+	mMaxLength = maxLength;
+	mRun = new run_t[numOfRun];
+	mGlyph = new glyph_t[numOfRun * maxLength];
+	mText = new char[numOfRun * maxLength];
+
+	for(uint16_t i = 0; i < numOfRun; i++)
+	{
+		mRun[i].glyph = &mGlyph[i * maxLength];
+		mRun[i].text = &mText[i * maxLength];
+	}
+
+	clear();
+}
+
+TextLayout::~TextLayout(void)
+{
+	delete[] mRun;
+	delete[] mGlyph;
+	delete[] mText;
+}
+
+void TextLayout::clear(void)
+{
+	for(uint16_t i = 0; i < mNumOfRun; i++)
+	{
+		mRun[i].font = 0;
+		mRun[i].lastUse = 0;
+	}
+
+	mUseCount = 0;
+	mHitCount = 0;
+	mMissCount = 0;
+}
+
+uint32_t TextLayout::getHitCount(void)
+{
+	return mHitCount;
+}
+
+uint32_t TextLayout::getMissCount(void)
+{
+	return mMissCount;
+}
+
+TextLayout::run_t* TextLayout::find(Font *font, const char *str)
+{
+	uint32_t hash = 2166136261;
+	uint16_t length = 0;
+	run_t *run, *oldest;
+
+	if(font == 0 || mNumOfRun == 0)
+		return 0;
+
+	// FNV-1a 해시
+	while(str[length])
+	{
+		if(length >= mMaxLength)
+			return 0;
+
+		hash = (hash ^ (uint8_t)str[length]) * 16777619;
+		length++;
+	}
+
+	oldest = &mRun[0];
+	for(uint16_t i = 0; i < mNumOfRun; i++)
+	{
+		run = &mRun[i];
+
+		if(	run->font == font &&
+			run->hash == hash &&
+			run->length == length &&
+			run->spaceWidth == font->getSpaceWidth() &&
+			run->charWidth == font->getCharWidth() &&
+			memcmp(run->text, str, length) == 0)
+		{
+			run->lastUse = ++mUseCount;
+			mHitCount++;
+			return run;
+		}
+
+		if(run->lastUse < oldest->lastUse)
+			oldest = run;
+	}
+
+	mMissCount++;
+	oldest->hash = hash;
+	oldest->length = length;
+	oldest->lastUse = ++mUseCount;
+	memcpy(oldest->text, str, length);
+	layout(oldest, font, str);
+
+	return oldest;
+}
+
+void TextLayout::layout(run_t *run, Font *font, const char *str)
+{
+	Font::fontInfo_t *fontInfo;
+	uint32_t utf8;
+	uint16_t x = 0, width = 0, buf = 0;
+	uint8_t advance;
+	glyph_t *glyph;
+
+	run->font = font;
+	run->spaceWidth = font->getSpaceWidth();
+	run->charWidth = font->getCharWidth();
+	run->numOfGlyph = 0;
+
+	// x는 Brush::drawString(), width는 Font::getStringWidth()와 같은 방법으로 계산
+	while(*str)
+	{
+		utf8 = font->getUtf8(&str);
+
+		if(utf8 == ' ')
+		{
+			x += run->spaceWidth;
+			buf = run->spaceWidth;
+			if(run->charWidth == 0)
+				width += run->spaceWidth;
+			else if(buf > run->charWidth)
+				width += buf;
+			else
+				width += run->charWidth;
+			continue;
+		}
+
+		fontInfo = font->getFontInfo(utf8);
+		glyph = &run->glyph[run->numOfGlyph++];
+		glyph->fontInfo = fontInfo;
+		glyph->utf8 = utf8;
+		glyph->x = x;
+
+		advance = 0;
+		if(fontInfo)
+		{
+			if(fontInfo->xpos == 0)
+				buf = fontInfo->width + fontInfo->xpos + 1;
+			else
+				buf = fontInfo->width + fontInfo->xpos;
+
+			advance = fontInfo->width + (fontInfo->xpos ? (int8_t)fontInfo->xpos : 1);
+		}
+
+		if(run->charWidth)
+		{
+			x += run->charWidth > advance ? run->charWidth : advance;
+			width += buf > run->charWidth ? buf : run->charWidth;
+		}
+		else
+		{
+			x += advance;
+			if(fontInfo)
+				width += buf;
+		}
+	}
+
+	run->advance = x;
+	run->size.width = width;
+	run->size.height = font->getStringHeight();
+}
+
+#endif
+
@@ -144,4 +144,72 @@ unalignedGreater:
 	subs r3, r2, #4
 	bhi unalignedRepeat
 	b remain
+#elif defined(YSS__CORE_CM0_H_GENERIC)
+	.thumb_func
+	.syntax unified
+	.func copyRgb888DotPattern
+	.type copyRgb888DotPattern, %function
+	.global copyRgb888DotPattern
+	.section .text, "ax"
+copyRgb888DotPattern:
+	push {r4-r7}
+	lsls r1, #8
+	lsrs r1, #8
+	lsls r3, r1, #24
+	mov r5, r1
+	orrs r5, r3
+	lsrs r6, r1, #8
+	lsls r3, r1, #16
+	orrs r6, r3
+	lsrs r7, r1, #16
+	lsls r3, r1, #8
+	orrs r7, r3
+	movs r4, #3
+align:
+	tst r0, r4
+	beq aligned
+	cmp r2, #0
+	beq finish
+	strb r5, [r0]
+	strb r6, [r0, #1]
+	strb r7, [r0, #2]
+	adds r0, #3
+	subs r2, #1
+	b align
+aligned:
+	lsrs r3, r2, #5
+	beq block
+repeat:
+	stmia r0!, {r5-r7}
+	stmia r0!, {r5-r7}
+	stmia r0!, {r5-r7}
+	stmia r0!, {r5-r7}
+	stmia r0!, {r5-r7}
+	stmia r0!, {r5-r7}
+	stmia r0!, {r5-r7}
+	stmia r0!, {r5-r7}
+	subs r3, #1
+	bne repeat
+block:
+	lsrs r3, r2, #2
+	movs r1, #7
+	ands r3, r1
+	beq remain
+blockRepeat:
+	stmia r0!, {r5-r7}
+	subs r3, #1
+	bne blockRepeat
+remain:
+	ands r2, r4
+	beq finish
+remainRepeat:
+	strb r5, [r0]
+	strb r6, [r0, #1]
+	strb r7, [r0, #2]
+	adds r0, #3
+	subs r2, #1
+	bne remainRepeat
+finish:
+	pop {r4-r7}
+	bx lr
 #endif
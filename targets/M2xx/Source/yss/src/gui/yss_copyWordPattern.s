@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include "../../inc/drv/mcu.h"
+
+// void copyWordPattern(void *des, uint32_t pattern0, uint32_t pattern1, uint32_t count)
+// des는 4바이트 정렬이 되어 있어야 하며 count는 워드 단위이다.
+// pattern0, pattern1, pattern0, pattern1 순서로 저장하며 stmia 한 번에 네 워드를 저장한다.
+#if defined(YSS__CORE_CM3_CM4_CM7_H_GENERIC) || defined(YSS__CORE_CM33_H_GENERIC) || defined(YSS__CORE_CM0_H_GENERIC)
+	.thumb_func
+	.syntax unified
+	.func copyWordPattern
+	.type copyWordPattern, %function
+	.global copyWordPattern
+	.section .text, "ax"
+copyWordPattern:
+	push {r4-r7}
+	mov r4, r1
+	mov r5, r2
+	mov r6, r1
+	mov r7, r2
+	movs r2, r3
+	lsrs r3, r2, #5
+	beq block
+repeat:
+	stmia r0!, {r4-r7}
+	stmia r0!, {r4-r7}
+	stmia r0!, {r4-r7}
+	stmia r0!, {r4-r7}
+	stmia r0!, {r4-r7}
+	stmia r0!, {r4-r7}
+	stmia r0!, {r4-r7}
+	stmia r0!, {r4-r7}
+	subs r3, #1
+	bne repeat
+block:
+	lsrs r3, r2, #2
+	movs r1, #7
+	ands r3, r1
+	beq remain
+blockRepeat:
+	stmia r0!, {r4-r7}
+	subs r3, #1
+	bne blockRepeat
+remain:
+	movs r1, #3
+	ands r2, r1
+	beq finish
+	str r4, [r0]
+	subs r2, #1
+	beq finish
+	str r5, [r0, #4]
+	subs r2, #1
+	beq finish
+	str r4, [r0, #8]
+finish:
+	pop {r4-r7}
+	bx lr
+#endif
@@ -34,6 +34,7 @@ TM0027::TM0027(void)
 	mA0.port = 0;
 	mRst.port = 0;
 	mPeri = 0;
+	mReverseX = true;
 	setSize(128, 64);
 }
 
@@ -97,44 +98,23 @@ void TM0027::sendData(void *data, uint32_t size)
 	mPeri->unlock();
 }
 
-void TM0027::clear(void)
-{
-	memset(mFrameBuffer, 0x00, 128 * 64 / 8);
-}
-
-void TM0027::fill(void)
-{
-	memset(mFrameBuffer, 0xff, 128 * 64 / 8);
-}
-
 void TM0027::refresh(void)
 {
-	uint8_t *des = mFrameBuffer;
+	uint16_t x, width;
 
-	for (int32_t  i = 0; i < 8; i++)
+	for (uint16_t page = 0; page < mNumOfPage; page++)
 	{
-		sendCmd(0x40);     // Display start line set
-		sendCmd(0xb0 | i); // Page address set
-		sendCmd(0x10);     // Column address set upper bit
-		sendCmd(0x00);     // Column address set lower bit
-
-		sendData(des, 128);
-		des += 128;
-//		thread::delay(5);
+		while (getDirtyRange(page, x, width))
+		{
+			sendCmd(0x40);					// Display start line set
+			sendCmd(0xb0 | page);			// Page address set
+			sendCmd(0x10 | (x >> 4));		// Column address set upper bit
+			sendCmd(0x00 | (x & 0x0F));		// Column address set lower bit
+			sendData(&mFrameBuffer[page * mWidth + x], width);
+		}
 	}
 }
 
-void TM0027::drawDot(uint16_t x, uint16_t y, bool data)
-{
-	if (x < 128 && y < 64)
-	{
-		x = 127 - x;
-		if (data)
-			mFrameBuffer[y / 8 * 128 + x] |= 1 << (y % 8);
-		else
-			mFrameBuffer[y / 8 * 128 + x] &= ~(1 << (y % 8));
-	}
-}
 }
 }
 
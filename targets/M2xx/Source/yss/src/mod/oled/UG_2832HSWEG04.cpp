@@ -114,41 +114,20 @@ void UG_2832HSWEG04::sendData(void *data, uint32_t size)
 	mPeri->unlock();
 }
 
-void UG_2832HSWEG04::clear(void)
-{
-	memset(mFrameBuffer, 0x00, 128 * 32 / 8);
-}
-
-void UG_2832HSWEG04::fill(void)
-{
-	memset(mFrameBuffer, 0xff, 128 * 32 / 8);
-}
-
 void UG_2832HSWEG04::refresh(void)
 {
-	uint8_t *des = mFrameBuffer;
+	uint16_t x, width;
 
-	for (int32_t  i = 0; i < 4; i++)
-	{
-		sendCmd(0x22);
-		sendCmd(i);
-
-		sendCmd(0x00);
-		sendCmd(0x10);
-
-		sendData(des, 128);
-		des += 128;
-	}
-}
-
-void UG_2832HSWEG04::drawDot(uint16_t x, uint16_t y, bool data)
-{
-	if (x < 128 && y < 32)
+	for (uint16_t page = 0; page < mNumOfPage; page++)
 	{
-		if (data)
-			mFrameBuffer[y / 8 * 128 + x] |= 1 << (y % 8);
-		else
-			mFrameBuffer[y / 8 * 128 + x] &= ~(1 << (y % 8));
+		while (getDirtyRange(page, x, width))
+		{
+			sendCmd(0xB0 | page);		// Page start address
+			sendCmd(0x00 | (x & 0x0F));	// Lower column start address
+			sendCmd(0x10 | (x >> 4));	// Higher column start address
+
+			sendData(&mFrameBuffer[page * mWidth + x], width);
+		}
 	}
 }
 
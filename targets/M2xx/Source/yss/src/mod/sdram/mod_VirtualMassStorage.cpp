@@ -5,80 +5,468 @@
  * See the file "LICENSE" in the main directory of this archive for more details.
  */
 
-#include <yss/thread.h>
-#include <std_ext/malloc.h>
 #include <mod/sdram/VirtualMassStorage.h>
+#include <string.h>
+
+#define BLOCK_SIZE			512
+#define PARTITION_START		64
+#define RESERVED_SECTOR		32
+#define NUM_OF_FAT			2
+#define FS_INFO_SECTOR		1
+#define BACKUP_BOOT_SECTOR	6
+
+// 호스트가 FAT32로 인식하는 최소 클러스터 수와 그 때의 FAT 크기 (섹터)
+#define MIN_CLUSTER			65525
+#define MIN_FAT_SIZE		(((MIN_CLUSTER + 2) * 4 + BLOCK_SIZE - 1) / BLOCK_SIZE)
+
+// 파일의 날짜 (2015년 1월 1일)
+#define ENTRY_DATE			(((2015 - 1980) << 9) | (1 << 5) | 1)
 
 namespace mod
 {
 namespace sdram
 {
+	static void set16(uint8_t *des, uint16_t value)
+	{
+		des[0] = value;
+		des[1] = value >> 8;
+	}
+
+	static void set32(uint8_t *des, uint32_t value)
+	{
+		des[0] = value;
+		des[1] = value >> 8;
+		des[2] = value >> 16;
+		des[3] = value >> 24;
+	}
+
+	// 8.3 형식의 이름을 디렉토리 엔트리의 11 바이트 이름으로 바꾼다.
+	// 형식이 맞지 않으면 false를 반환한다.
+	static bool setShortName(uint8_t *des, const char *name)
+	{
+		uint8_t i = 0, limit = 8;
+		char c;
+
+		memset(des, ' ', 11);
+
+		while(*name)
+		{
+			c = *name++;
+			if(c == '.')
+			{
+				if(limit == 11 || i == 0)
+					return false;
+				i = 8;
+				limit = 11;
+				continue;
+			}
+
+			if(i >= limit || c == ' ' || c == '/' || c == '\\')
+				return false;
+
+			if(c >= 'a' && c <= 'z')
+				c -= 'a' - 'A';
+			des[i++] = c;
+		}
+
+		return i > 0;
+	}
+
 	VirtualMassStorage::VirtualMassStorage(void)
 	{
-		mInitFlag = false;
-		mBlockSize = 0;
+		mEntry = 0;
+		mFirstCluster = 0;
+		mOverlayBlock = 0;
+		mOverlayData = 0;
+		mBlockBuffer = 0;
 		mNumOfBlock = 0;
+		mFatSize = 0;
+		mFatStart = 0;
+		mDataStart = 0;
+		mNumOfCluster = 0;
+		mUsedCluster = 0;
+		mNumOfEntry = 0;
+		mMaxOverlay = 0;
+		mOverlayCount = 0;
+		mSectorPerCluster = 0;
+		mInitFlag = false;
+	}
+
+	VirtualMassStorage::~VirtualMassStorage(void)
+	{
+		release();
 	}
 
-	bool VirtualMassStorage::initialize(uint32_t blockSize, uint32_t numOfBlock) 
+	void VirtualMassStorage::release(void)
 	{
-		uint32_t size = blockSize * numOfBlock;
+		discard();
+
+		delete[] mFirstCluster;
+		delete[] mOverlayBlock;
+		delete[] mOverlayData;
+		delete[] (uint32_t*)mBlockBuffer;
+
+		mFirstCluster = 0;
+		mOverlayBlock = 0;
+		mOverlayData = 0;
+		mBlockBuffer = 0;
+		mInitFlag = false;
+	}
+
+	error_t VirtualMassStorage::initialize(const Config &config)
+	{
+		uint32_t numOfSector, need, cluster, clusterSize = config.sectorPerCluster * BLOCK_SIZE;
+		uint8_t name[11];
+
+		release();
+
+		if(config.sectorPerCluster == 0 || (config.sectorPerCluster & (config.sectorPerCluster - 1)))
+			return error_t::WRONG_CONFIG;
 
-//		mMemroy = (int8_t*)lmalloc(size);
-		mMemroy = new int8_t[size];
-		if(mMemroy)
+		// 예약 영역, 두 FAT와 최소 클러스터 수가 들어가지 않으면 아래의 계산이 음수가 되어 잘못된 구조를 만듦
+		if(config.numOfBlock < (uint32_t)(PARTITION_START + RESERVED_SECTOR + NUM_OF_FAT * MIN_FAT_SIZE + MIN_CLUSTER * config.sectorPerCluster))
+			return error_t::WRONG_SIZE;
+
+		// 루트 디렉토리는 한 클러스터
+		if(config.numOfEntry > config.sectorPerCluster * 16)
+			return error_t::OVERSIZE;
+
+		for(uint16_t i = 0; i < config.numOfEntry; i++)
+		{
+			if(setShortName(name, config.entry[i].name) == false)
+				return error_t::WRONG_FILE_NAME;
+		}
+
+		// FAT의 크기와 클러스터의 수를 함께 결정
+		numOfSector = config.numOfBlock - PARTITION_START;
+		mFatSize = 1;
+		while(true)
+		{
+			mNumOfCluster = (numOfSector - RESERVED_SECTOR - NUM_OF_FAT * mFatSize) / config.sectorPerCluster;
+			need = ((mNumOfCluster + 2) * 4 + BLOCK_SIZE - 1) / BLOCK_SIZE;
+			if(need <= mFatSize)
+				break;
+			mFatSize = need;
+		}
+
+		if(mNumOfCluster < MIN_CLUSTER)
+			return error_t::WRONG_SIZE;
+
+		mFirstCluster = new uint32_t[config.numOfEntry + 1];
+		mOverlayBlock = new uint32_t[config.maxOverlay];
+		mOverlayData = new uint8_t*[config.maxOverlay];
+		mBlockBuffer = (uint8_t*)new uint32_t[BLOCK_SIZE / 4];
+		if(mFirstCluster == 0 || mOverlayBlock == 0 || mOverlayData == 0 || mBlockBuffer == 0)
 		{
-			mBlockSize = blockSize;
-			mNumOfBlock = numOfBlock;
-			mInitFlag = true;
-			return true;
+			release();
+			return error_t::MALLOC_FAILED;
 		}
-		else
+
+		// 루트 디렉토리(클러스터 2) 뒤에 파일들을 차례로 연속된 클러스터에 배치
+		// mFirstCluster[numOfEntry]는 마지막 파일의 끝
+		cluster = 3;
+		for(uint16_t i = 0; i < config.numOfEntry; i++)
 		{
-			mInitFlag = false;
-			return false;
+			mFirstCluster[i] = cluster;
+			cluster += config.entry[i].size / clusterSize + (config.entry[i].size % clusterSize ? 1 : 0);
+			if(cluster > mNumOfCluster + 2)
+			{
+				release();
+				return error_t::OVERSIZE;
+			}
 		}
+		mFirstCluster[config.numOfEntry] = cluster;
+
+		mEntry = config.entry;
+		mNumOfEntry = config.numOfEntry;
+		mNumOfBlock = config.numOfBlock;
+		mSectorPerCluster = config.sectorPerCluster;
+		mMaxOverlay = config.maxOverlay;
+		mUsedCluster = cluster - 2;
+		mFatStart = PARTITION_START + RESERVED_SECTOR;
+		mDataStart = mFatStart + NUM_OF_FAT * mFatSize;
+		mInitFlag = true;
+
+		return error_t::ERROR_NONE;
 	}
 
-	bool VirtualMassStorage::writeBlock(uint32_t block, void *src)
+	uint16_t VirtualMassStorage::getOverlayCount(void)
 	{
-		if(mInitFlag == false)
-			return false;
-		if(block >= mNumOfBlock)
-			return false;
-		
-		int8_t *des = &mMemroy[mBlockSize * block];
-		int8_t *cSrc = (int8_t*)src;
-		for(uint32_t i=0;i<mBlockSize;i++)
-			*des++ = *cSrc++;
+		return mOverlayCount;
+	}
+
+	void VirtualMassStorage::discard(void)
+	{
+		for(uint16_t i = 0; i < mOverlayCount; i++)
+			delete[] (uint32_t*)mOverlayData[i];
 
-		return true;
+		mOverlayCount = 0;
 	}
 
-	bool VirtualMassStorage::readBlock(uint32_t block, void *des)
+	// 덮어쓴 블록의 목록은 블록 번호 순서로 정렬되어 있다.
+	// block 이상인 첫 항목의 번호를 반환한다.
+	uint32_t VirtualMassStorage::findOverlay(uint32_t block)
 	{
-		if(mInitFlag == false)
-			return false;
-		if(block >= mNumOfBlock)
-			return false;
+		uint32_t low = 0, high = mOverlayCount, mid;
+
+		while(low < high)
+		{
+			mid = (low + high) / 2;
+			if(mOverlayBlock[mid] < block)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		return low;
+	}
+
+	// 원래의 이미지에서 block 번 블록의 내용을 만든다.
+	void VirtualMassStorage::build(uint32_t block, uint8_t *des)
+	{
+		uint32_t sector;
+
+		if(block >= mDataStart)
+		{
+			sector = block - mDataStart;
+			if(sector / mSectorPerCluster == 0)
+				buildDirectory(sector, des);
+			else
+				buildData(sector / mSectorPerCluster + 2, sector % mSectorPerCluster, des);
+			return;
+		}
+
+		if(block >= mFatStart)
+		{
+			// 두 FAT는 같은 내용이며 FAT는 워드 단위로 채움
+			sector = (block - mFatStart) % mFatSize;
+			if((uint32_t)(uintptr_t)des & 0x03)
+			{
+				buildFat(sector, (uint32_t*)mBlockBuffer);
+				memcpy(des, mBlockBuffer, BLOCK_SIZE);
+			}
+			else
+				buildFat(sector, (uint32_t*)des);
+			return;
+		}
 
-		int8_t *cDes = (int8_t*)des;
-		int8_t *src = &mMemroy[mBlockSize * block];
-		for(uint32_t i=0;i<mBlockSize;i++)
-			*cDes++ = *src++;
+		memset(des, 0, BLOCK_SIZE);
 
-		return true;
+		switch(block)
+		{
+		case 0 :
+			// MBR
+			des[0x1BE + 4] = 0x0C;
+			set32(&des[0x1BE + 8], PARTITION_START);
+			set32(&des[0x1BE + 12], mNumOfBlock - PARTITION_START);
+			set16(&des[0x1FE], 0xAA55);
+			break;
+
+		case PARTITION_START :
+		case PARTITION_START + BACKUP_BOOT_SECTOR :
+			memcpy(des, "\xEB\x58\x90MSWIN4.1", 11);
+			set16(&des[0x0B], BLOCK_SIZE);
+			des[0x0D] = mSectorPerCluster;
+			set16(&des[0x0E], RESERVED_SECTOR);
+			des[0x10] = NUM_OF_FAT;
+			des[0x15] = 0xF8;
+			set16(&des[0x18], 63);
+			set16(&des[0x1A], 255);
+			set32(&des[0x1C], PARTITION_START);
+			set32(&des[0x20], mNumOfBlock - PARTITION_START);
+			set32(&des[0x24], mFatSize);
+			set32(&des[0x2C], 2);
+			set16(&des[0x30], FS_INFO_SECTOR);
+			set16(&des[0x32], BACKUP_BOOT_SECTOR);
+			des[0x40] = 0x80;
+			des[0x42] = 0x29;
+			set32(&des[0x43], 0x20150000);
+			memcpy(&des[0x47], "NO NAME    FAT32   ", 19);
+			set16(&des[0x1FE], 0xAA55);
+			break;
+
+		case PARTITION_START + FS_INFO_SECTOR :
+		case PARTITION_START + BACKUP_BOOT_SECTOR + FS_INFO_SECTOR :
+			set32(&des[0x000], 0x41615252);
+			set32(&des[0x1E4], 0x61417272);
+			set32(&des[0x1E8], mNumOfCluster - mUsedCluster);
+			set32(&des[0x1EC], mUsedCluster + 2);
+			set16(&des[0x1FE], 0xAA55);
+			break;
+		}
+	}
+
+	void VirtualMassStorage::buildFat(uint32_t sector, uint32_t *des)
+	{
+		uint32_t first = sector * (BLOCK_SIZE / 4), last = first + BLOCK_SIZE / 4, start, end;
+
+		memset(des, 0, BLOCK_SIZE);
+
+		// 예약된 두 항목과 루트 디렉토리
+		if(sector == 0)
+		{
+			des[0] = 0x0FFFFFF8;
+			des[1] = 0x0FFFFFFF;
+			des[2] = 0x0FFFFFFF;
+		}
+
+		// 파일은 연속된 클러스터에 있으므로 각 클러스터는 다음 클러스터를 가리키고 마지막 클러스터만 체인의 끝
+		for(uint16_t i = 0; i < mNumOfEntry; i++)
+		{
+			start = mFirstCluster[i];
+			end = mFirstCluster[i + 1];
+			if(start >= last)
+				break;
+			if(end <= first || start == end)
+				continue;
+
+			for(uint32_t cluster = start > first ? start : first; cluster < end && cluster < last; cluster++)
+				des[cluster - first] = cluster + 1;
+
+			if(end - 1 < last && end - 1 >= first)
+				des[end - 1 - first] = 0x0FFFFFFF;
+		}
+	}
+
+	void VirtualMassStorage::buildDirectory(uint32_t sector, uint8_t *des)
+	{
+		uint32_t index, cluster;
+		uint8_t *entry;
+
+		memset(des, 0, BLOCK_SIZE);
+
+		for(uint32_t i = 0; i < BLOCK_SIZE / 32; i++)
+		{
+			index = sector * (BLOCK_SIZE / 32) + i;
+			if(index >= mNumOfEntry)
+				break;
+
+			entry = &des[i * 32];
+			cluster = mEntry[index].size ? mFirstCluster[index] : 0;
+
+			setShortName(entry, mEntry[index].name);
+			entry[0x0B] = 0x20;
+			set16(&entry[0x10], ENTRY_DATE);
+			set16(&entry[0x12], ENTRY_DATE);
+			set16(&entry[0x14], cluster >> 16);
+			set16(&entry[0x18], ENTRY_DATE);
+			set16(&entry[0x1A], cluster);
+			set32(&entry[0x1C], mEntry[index].size);
+		}
+	}
+
+	void VirtualMassStorage::buildData(uint32_t cluster, uint32_t sector, uint8_t *des)
+	{
+		uint32_t low = 0, high = mNumOfEntry, mid, offset, size = 0;
+
+		// 파일은 클러스터 번호 순서로 놓여 있으므로 이진 탐색으로 찾음
+		while(low < high)
+		{
+			mid = (low + high) / 2;
+			if(mFirstCluster[mid + 1] <= cluster)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		if(low < mNumOfEntry)
+		{
+			offset = ((cluster - mFirstCluster[low]) * mSectorPerCluster + sector) * BLOCK_SIZE;
+			if(offset < mEntry[low].size)
+			{
+				size = mEntry[low].size - offset;
+				if(size > BLOCK_SIZE)
+					size = BLOCK_SIZE;
+				memcpy(des, (const uint8_t*)mEntry[low].data + offset, size);
+			}
+		}
+
+		if(size < BLOCK_SIZE)
+			memset(&des[size], 0, BLOCK_SIZE - size);
 	}
 
 	uint32_t VirtualMassStorage::getBlockSize(void)
 	{
-		return mBlockSize;
+		return BLOCK_SIZE;
 	}
 
 	uint32_t VirtualMassStorage::getNumOfBlock(void)
 	{
 		return mNumOfBlock;
 	}
+
+	error_t VirtualMassStorage::write(uint32_t block, void *src)
+	{
+		uint32_t index;
+		uint8_t *data;
+
+		if(mInitFlag == false)
+			return error_t::NOT_INITIALIZED;
+		if(block >= mNumOfBlock)
+			return error_t::INDEX_OVER;
+
+		index = findOverlay(block);
+		if(index < mOverlayCount && mOverlayBlock[index] == block)
+		{
+			memcpy(mOverlayData[index], src, BLOCK_SIZE);
+			return error_t::ERROR_NONE;
+		}
+
+		build(block, mBlockBuffer);
+		if(memcmp(mBlockBuffer, src, BLOCK_SIZE) == 0)
+			return error_t::ERROR_NONE;
+
+		if(mOverlayCount >= mMaxOverlay)
+			return error_t::NO_FREE_DATA;
+
+		data = (uint8_t*)new uint32_t[BLOCK_SIZE / 4];
+		if(data == 0)
+			return error_t::MALLOC_FAILED;
+		memcpy(data, src, BLOCK_SIZE);
+
+		// 정렬된 순서를 유지하며 삽입
+		memmove(&mOverlayBlock[index + 1], &mOverlayBlock[index], (mOverlayCount - index) * sizeof(uint32_t));
+		memmove(&mOverlayData[index + 1], &mOverlayData[index], (mOverlayCount - index) * sizeof(uint8_t*));
+		mOverlayBlock[index] = block;
+		mOverlayData[index] = data;
+		mOverlayCount++;
+
+		return error_t::ERROR_NONE;
+	}
+
+	error_t VirtualMassStorage::read(uint32_t block, void *des)
+	{
+		return readBlocks(block, 1, des);
+	}
+
+	error_t VirtualMassStorage::readBlocks(uint32_t block, uint32_t count, void *des)
+	{
+		uint8_t *cDes = (uint8_t*)des;
+		uint32_t index;
+
+		if(mInitFlag == false)
+			return error_t::NOT_INITIALIZED;
+		if(block >= mNumOfBlock || count > mNumOfBlock - block)
+			return error_t::INDEX_OVER;
+
+		// 덮어쓴 블록의 목록을 블록 번호와 함께 따라가며 한번만 탐색
+		index = findOverlay(block);
+		for(uint32_t i = 0; i < count; i++)
+		{
+			if(index < mOverlayCount && mOverlayBlock[index] == block + i)
+				memcpy(cDes, mOverlayData[index++], BLOCK_SIZE);
+			else
+				build(block + i, cDes);
+			cDes += BLOCK_SIZE;
+		}
+
+		return error_t::ERROR_NONE;
+	}
+
+	bool VirtualMassStorage::isConnected(void)
+	{
+		return mInitFlag;
+	}
 }
 }
 
@@ -10,6 +10,8 @@
 #if USE_GUI == true
 
 #include <mod/tft_lcd_driver/ILI9341_with_Brush.h>
+#include <gui/BitmapDecoder.h>
+#include <gui/Convert.h>
 
 ILI9341_with_Brush::ILI9341_with_Brush(void)
 {
@@ -68,6 +70,55 @@ void ILI9341_with_Brush::updateLcdSize(void)
 
 void ILI9341_with_Brush::drawBitmapBase(Position_t pos, const Bitmap_t &bitmap)
 {
+	// 압축된 비트맵은 작은 버퍼 단위로 풀어서 LCD의 창에 이어서 씀
+	if (BitmapDecoder::isCompressed(bitmap.type))
+	{
+		BitmapDecoder decoder;
+		uint8_t buf[COMPRESSED_BITMAP_BAND * 2], cmd = MEMORY_WRITE;
+		uint32_t remain = bitmap.width * bitmap.height, count;
+
+		decoder.begin(bitmap.width, bitmap.type, bitmap.data);
+
+		enable();
+		setWindows(pos.x, pos.y, bitmap.width, bitmap.height);
+		while(remain)
+		{
+			count = remain > COMPRESSED_BITMAP_BAND ? COMPRESSED_BITMAP_BAND : remain;
+			decoder.read(buf, count);
+			sendCmd(cmd, buf, count * 2);
+			cmd = WRITE_MEMORY_CONTINUE;
+			remain -= count;
+		}
+		disable();
+		return;
+	}
+
+	// RGB888 비트맵은 작은 버퍼 단위로 LCD의 RGB565 형식으로 변환하여 씀
+	if (bitmap.type == 1)
+	{
+		uint16_t buf[COMPRESSED_BITMAP_BAND];
+		const uint8_t *src = bitmap.data;
+		uint8_t cmd = MEMORY_WRITE;
+		uint32_t remain = bitmap.width * bitmap.height, count;
+		bool reverseRgb = getReverseRgbOrder(), reverseEndian = getReverseEndian();
+
+		enable();
+		setWindows(pos.x, pos.y, bitmap.width, bitmap.height);
+		while(remain)
+		{
+			count = remain > COMPRESSED_BITMAP_BAND ? COMPRESSED_BITMAP_BAND : remain;
+			convert::rgb888ToRgb565(buf, src, count);
+			if(reverseRgb || reverseEndian)
+				convert::reorderRgb565(buf, buf, count, reverseRgb, reverseEndian);
+			sendCmd(cmd, buf, count * 2);
+			cmd = WRITE_MEMORY_CONTINUE;
+			src += count * 3;
+			remain -= count;
+		}
+		disable();
+		return;
+	}
+
 	// RGB565가 아니면 리턴
 	if (bitmap.type != 0)
 		return;
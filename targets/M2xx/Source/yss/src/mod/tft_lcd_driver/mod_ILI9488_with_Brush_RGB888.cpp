@@ -10,6 +10,7 @@
 #if USE_GUI == true
 
 #include <mod/tft_lcd_driver/ILI9488_with_Brush_RGB888.h>
+#include <gui/Convert.h>
 
 ILI9488_with_Brush_RGB888::ILI9488_with_Brush_RGB888(void)
 {
@@ -74,6 +75,31 @@ void ILI9488_with_Brush_RGB888::updateLcdSize(void)
 
 void ILI9488_with_Brush_RGB888::drawBitmapBase(Position_t pos, const Bitmap_t &bitmap)
 {
+	// RGB565 비트맵은 작은 버퍼 단위로 LCD의 RGB888 형식으로 변환하여 씀
+	if (bitmap.type == 0)
+	{
+		uint8_t buf[COMPRESSED_BITMAP_BAND * 3], cmd = MEMORY_WRITE;
+		const uint16_t *src = (const uint16_t*)bitmap.data;
+		uint32_t remain = bitmap.width * bitmap.height, count;
+		bool reverseRgb = getReverseRgbOrder();
+
+		enable();
+		setWindows(pos.x, pos.y, bitmap.width, bitmap.height);
+		while(remain)
+		{
+			count = remain > COMPRESSED_BITMAP_BAND ? COMPRESSED_BITMAP_BAND : remain;
+			convert::rgb565ToRgb888(buf, src, count);
+			if(reverseRgb)
+				convert::reorderRgb888(buf, buf, count);
+			sendCmd(cmd, buf, count * 3);
+			cmd = WRITE_MEMORY_CONTINUE;
+			src += count;
+			remain -= count;
+		}
+		disable();
+		return;
+	}
+
 	// RGB888이 아니면 리턴
 	if (bitmap.type != 1)
 		return;
@@ -15,6 +15,7 @@ FileSystem::FileSystem(MassStorage &storage)
 	mPartitionType = 0;
 	mStorage = &storage;
 	mSectorBuffer = new uint8_t[512];
+	mDirectoryOwner = 0;
 }
 
 FileSystem::~FileSystem(void)
@@ -98,3 +99,13 @@ void* FileSystem::getSectorBuffer(void)
 	return mSectorBuffer;
 }
 
+void FileSystem::setDirectoryOwner(const void *owner)
+{
+	mDirectoryOwner = owner;
+}
+
+const void* FileSystem::getDirectoryOwner(void)
+{
+	return mDirectoryOwner;
+}
+
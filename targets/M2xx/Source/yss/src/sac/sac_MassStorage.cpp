@@ -7,6 +7,45 @@
 
 #include <sac/MassStorage.h>
 
+error_t MassStorage::writeBlocks(uint32_t block, uint32_t count, void *src)
+{
+	uint8_t *cSrc = (uint8_t*)src;
+	uint32_t size = getBlockSize();
+	error_t result;
+
+	for(uint32_t i=0;i<count;i++)
+	{
+		result = write(block + i, cSrc);
+		if(result != error_t::ERROR_NONE)
+			return result;
+		cSrc += size;
+	}
+
+	return error_t::ERROR_NONE;
+}
+
+error_t MassStorage::readBlocks(uint32_t block, uint32_t count, void *des)
+{
+	uint8_t *cDes = (uint8_t*)des;
+	uint32_t size = getBlockSize();
+	error_t result;
+
+	for(uint32_t i=0;i<count;i++)
+	{
+		result = read(block + i, cDes);
+		if(result != error_t::ERROR_NONE)
+			return result;
+		cDes += size;
+	}
+
+	return error_t::ERROR_NONE;
+}
+
+error_t MassStorage::sync(void)
+{
+	return error_t::ERROR_NONE;
+}
+
 namespace sac
 {
 }
@@ -11,23 +11,310 @@
 
 #include <sac/MonoLcd.h>
 #include <std_ext/malloc.h>
+#include <string.h>
 
 namespace sac
 {
 MonoLcd::MonoLcd(void)
 {
 	mFrameBuffer = 0;
+	mDirtyMask = 0;
+	mWidth = 0;
+	mHeight = 0;
+	mNumOfPage = 0;
+	mBufferSize = 0;
+	mDirtyGroupSize = 1;
+	mReverseX = false;
 }
 
 void MonoLcd::setSize(uint16_t width, uint16_t height)
 {
 	if (mFrameBuffer)
-		delete mFrameBuffer;
+		delete[] mFrameBuffer;
+	if (mDirtyMask)
+		delete[] mDirtyMask;
 
-	mFrameBuffer = new uint8_t[width * height / 8];
+	mWidth = width;
+	mHeight = height;
+	mNumOfPage = (height + 7) / 8;
+	mBufferSize = width * mNumOfPage;
+	mDirtyGroupSize = (width + 31) / 32;
+
+	mFrameBuffer = new uint8_t[mBufferSize];
+	mDirtyMask = new uint32_t[mNumOfPage];
+	memset(mFrameBuffer, 0x00, mBufferSize);
+	invalidate();
 
 	MonoBrush::setSize(width, height);
 }
+
+void MonoLcd::invalidate(void)
+{
+	for (uint16_t i = 0; i < mNumOfPage; i++)
+		mDirtyMask[i] = 0xFFFFFFFF;
+}
+
+void MonoLcd::markDirty(uint16_t page, uint16_t start, uint16_t end)
+{
+	uint32_t mask;
+
+	start /= mDirtyGroupSize;
+	end /= mDirtyGroupSize;
+
+	if (end >= 31)
+		mask = 0xFFFFFFFF;
+	else
+		mask = (1UL << (end + 1)) - 1;
+	mask &= ~((1UL << start) - 1);
+
+	mDirtyMask[page] |= mask;
+}
+
+bool MonoLcd::getDirtyRange(uint16_t page, uint16_t &x, uint16_t &width)
+{
+	uint32_t mask = mDirtyMask[page];
+	uint8_t start = 0, end;
+
+	if (mask == 0)
+		return false;
+
+	// 한 그룹만 비어있는 사이는 합침
+	mask |= (mask >> 1) & (mask << 1);
+
+	while ((mask & (1UL << start)) == 0)
+		start++;
+
+	end = start;
+	while (end < 32 && (mask & (1UL << end)))
+	{
+		mask &= ~(1UL << end);
+		end++;
+	}
+
+	mDirtyMask[page] = mask;
+
+	x = start * mDirtyGroupSize;
+	end *= mDirtyGroupSize;
+	if (end > mWidth)
+		end = mWidth;
+	width = end - x;
+
+	return width > 0;
+}
+
+void MonoLcd::drawDot(uint16_t x, uint16_t y, bool data)
+{
+	uint8_t *des, bit, buf;
+
+	if (x >= mWidth || y >= mHeight)
+		return;
+
+	if (mReverseX)
+		x = mWidth - 1 - x;
+
+	des = &mFrameBuffer[y / 8 * mWidth + x];
+	bit = 1 << (y % 8);
+
+	if (data)
+		buf = *des | bit;
+	else
+		buf = *des & ~bit;
+
+	if (buf != *des)
+	{
+		*des = buf;
+		markDirty(y / 8, x, x);
+	}
+}
+
+void MonoLcd::fillRectBase(Position_t pos, Size_t size, bool data)
+{
+	int32_t sx = pos.x, ex = pos.x + size.width - 1, sy = pos.y, ey = pos.y + size.height - 1, buf;
+	uint16_t page, top, first, last;
+	uint8_t mask, value, *des;
+
+	if (sx < 0)
+		sx = 0;
+	if (sy < 0)
+		sy = 0;
+	if (ex >= mWidth)
+		ex = mWidth - 1;
+	if (ey >= mHeight)
+		ey = mHeight - 1;
+
+	if (sx > ex || sy > ey)
+		return;
+
+	// 프레임 버퍼 상의 열 범위
+	if (mReverseX)
+	{
+		buf = sx;
+		sx = mWidth - 1 - ex;
+		ex = mWidth - 1 - buf;
+	}
+
+	for (page = sy / 8; page <= ey / 8; page++)
+	{
+		top = page * 8;
+		mask = 0xFF;
+		if (sy > top)
+			mask &= 0xFF << (sy - top);
+		if (ey < top + 7)
+			mask &= 0xFF >> (top + 7 - ey);
+
+		value = data ? mask : 0x00;
+		des = &mFrameBuffer[page * mWidth];
+
+		if (mask == 0xFF)
+		{
+			// 페이지 전체를 채우는 경우 바뀐 범위만 찾아서 바이트 단위로 채움
+			first = sx;
+			while (first <= ex && des[first] == value)
+				first++;
+			if (first > ex)
+				continue;
+
+			last = ex;
+			while (des[last] == value)
+				last--;
+
+			memset(&des[first], value, last - first + 1);
+			markDirty(page, first, last);
+		}
+		else
+		{
+			first = 0xFFFF;
+			last = 0;
+
+			for (int32_t x = sx; x <= ex; x++)
+			{
+				buf = (des[x] & ~mask) | value;
+				if (buf != des[x])
+				{
+					des[x] = buf;
+					if (first == 0xFFFF)
+						first = x;
+					last = x;
+				}
+			}
+
+			if (first != 0xFFFF)
+				markDirty(page, first, last);
+		}
+	}
+}
+
+void MonoLcd::writeGlyphColumn(uint16_t page, uint16_t x, uint16_t count, uint8_t mask, const uint8_t *value)
+{
+	uint8_t *des = &mFrameBuffer[page * mWidth], buf;
+	uint16_t first = 0xFFFF, last = 0, column;
+
+	for (uint16_t i = 0; i < count; i++)
+	{
+		column = mReverseX ? mWidth - 1 - (x + i) : x + i;
+		buf = (des[column] & ~mask) | value[i];
+
+		if (buf != des[column])
+		{
+			des[column] = buf;
+			if (first == 0xFFFF || column < first)
+				first = column;
+			if (column > last)
+				last = column;
+		}
+	}
+
+	if (first != 0xFFFF)
+		markDirty(page, first, last);
+}
+
+uint8_t MonoLcd::drawChar(Position_t pos, uint32_t utf8, bool data)
+{
+	if (mFont == 0)
+		return 0;
+
+	Font::fontInfo_t *fontInfo = mFont->getFontInfo(utf8);
+	Font::Decoder decoder;
+	uint8_t column[GLYPH_BUFFER_SIZE], mask = 0, bit;
+	int16_t xs, ys, ye, left = 0, count, right, page;
+	uint16_t xoffset, stride;
+
+	if (fontInfo == 0)
+		return 0;
+
+	xoffset = fontInfo->xpos;
+	if (xoffset == 0)
+		xoffset = 1;
+
+	xs = pos.x + xoffset;
+	ys = pos.y + (int8_t)fontInfo->ypos;
+	ye = ys + fontInfo->height - 1;
+	stride = mFont->getDataStride(fontInfo->width);
+	count = fontInfo->width;
+
+	// 화면 영역에 맞게 자름
+	if (xs < 0)
+	{
+		left = -xs;
+		count -= left;
+		xs = 0;
+	}
+	if (xs + count > mWidth)
+		count = mWidth - xs;
+	if (ye >= mHeight)
+		ye = mHeight - 1;
+
+	if (count <= 0 || ys > ye || ye < 0)
+		return fontInfo->width;
+
+	// 버퍼보다 넓은 문자는 점 단위로 그림
+	if (count > GLYPH_BUFFER_SIZE)
+		return MonoBrush::drawChar(pos, utf8, data);
+
+	right = stride - left - count;
+
+	decoder.begin(fontInfo->data, mFont->getDataFormat());
+
+	if (ys < 0)
+	{
+		decoder.skip(stride * -ys);
+		ys = 0;
+	}
+
+	// 한 페이지에 해당하는 줄들을 열 단위의 바이트로 모은 후 한 번에 씀
+	page = ys / 8;
+	memset(column, 0x00, count);
+
+	for (int16_t y = ys; y <= ye; y++)
+	{
+		if (y / 8 != page)
+		{
+			writeGlyphColumn(page, xs, count, mask, column);
+			page = y / 8;
+			mask = 0;
+			memset(column, 0x00, count);
+		}
+
+		bit = 1 << (y % 8);
+		mask |= bit;
+
+		if (left)
+			decoder.skip(left);
+
+		for (int16_t x = 0; x < count; x++)
+		{
+			if ((decoder.getLevel() > 5) == data)
+				column[x] |= bit;
+		}
+
+		if (right)
+			decoder.skip(right);
+	}
+
+	writeGlyphColumn(page, xs, count, mask, column);
+
+	return fontInfo->width;
+}
 }
 
 #endif
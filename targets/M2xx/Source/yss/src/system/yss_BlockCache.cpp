@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+#include <yss/BlockCache.h>
+#include <yss/error.h>
+#include <string.h>
+
+#define INVALID_BLOCK	0xFFFFFFFF
+
+BlockCache::BlockCache(void)
+{
+	mStorage = 0;
+	mLine = 0;
+	mReadAheadBuffer = 0;
+	mBlockSize = 0;
+	mSetMask = 0;
+	mUseCount = 0;
+	mLastMiss = INVALID_BLOCK;
+	mDirtyCount = 0;
+	mHitCount = 0;
+	mMissCount = 0;
+	mDirtyLimit = 0;
+	mNumOfWay = 0;
+	mPolicy = WRITE_BACK;
+	mReadAhead = 0;
+}
+
+BlockCache::~BlockCache(void)
+{
+	if(mLine)
+	{
+		delete[] mLine[0].data;
+		delete[] mLine;
+	}
+
+	delete[] mReadAheadBuffer;
+}
+
+error_t BlockCache::initialize(MassStorage *storage, uint16_t numOfSet, uint8_t numOfWay)
+{
+	uint32_t numOfLine = (uint32_t)numOfSet * numOfWay;
+	uint8_t *buffer;
+
+	if(numOfSet == 0 || (numOfSet & (numOfSet - 1)) || numOfWay == 0)
+		return error_t::WRONG_CONFIG;
+
+	if(mLine)
+	{
+		delete[] mLine[0].data;
+		delete[] mLine;
+		mLine = 0;
+	}
+
+	mStorage = storage;
+	mBlockSize = storage->getBlockSize();
+	if(mBlockSize == 0)
+		return error_t::NOT_READY;
+
+	mLine = new Line[numOfLine];
+	if(mLine == 0)
+		return error_t::MALLOC_FAILED;
+
+	buffer = new uint8_t[mBlockSize * numOfLine];
+	if(buffer == 0)
+	{
+		delete[] mLine;
+		mLine = 0;
+		return error_t::MALLOC_FAILED;
+	}
+
+	for(uint32_t i = 0; i < numOfLine; i++)
+	{
+		mLine[i].data = &buffer[mBlockSize * i];
+		mLine[i].block = INVALID_BLOCK;
+		mLine[i].lastUsed = 0;
+		mLine[i].dirty = false;
+	}
+
+	mSetMask = numOfSet - 1;
+	mNumOfWay = numOfWay;
+	mUseCount = 0;
+	mDirtyCount = 0;
+	mLastMiss = INVALID_BLOCK;
+
+	// 블록 크기가 바뀌었을 수 있으므로 미리 읽기 버퍼를 다시 할당
+	if(mReadAhead)
+		return setReadAhead(mReadAhead);
+
+	return error_t::ERROR_NONE;
+}
+
+void BlockCache::setWritePolicy(uint8_t policy, uint16_t dirtyLimit)
+{
+	mPolicy = policy;
+	mDirtyLimit = dirtyLimit;
+}
+
+error_t BlockCache::setReadAhead(uint8_t count)
+{
+	if(mLine == 0)
+		return error_t::NOT_INITIALIZED;
+
+	// 미리 읽은 블록들이 서로를 교체하지 않도록 세트의 수로 제한
+	if(count > mSetMask + 1)
+		count = mSetMask + 1;
+
+	if(mReadAheadBuffer)
+	{
+		delete[] mReadAheadBuffer;
+		mReadAheadBuffer = 0;
+	}
+
+	mReadAhead = 0;
+	if(count == 0)
+		return error_t::ERROR_NONE;
+
+	mReadAheadBuffer = new uint8_t[mBlockSize * count];
+	if(mReadAheadBuffer == 0)
+		return error_t::MALLOC_FAILED;
+
+	mReadAhead = count;
+	return error_t::ERROR_NONE;
+}
+
+BlockCache::Line* BlockCache::find(uint32_t block)
+{
+	Line *line = &mLine[(block & mSetMask) * mNumOfWay];
+
+	for(uint8_t i = 0; i < mNumOfWay; i++, line++)
+	{
+		if(line->block == block)
+			return line;
+	}
+
+	return 0;
+}
+
+// 비어 있는 블록이 있으면 비어 있는 블록을, 없으면 세트에서 가장 오래 사용되지 않은 블록을 얻는다.
+BlockCache::Line* BlockCache::findVictim(uint32_t block)
+{
+	Line *line = &mLine[(block & mSetMask) * mNumOfWay], *victim = line;
+
+	for(uint8_t i = 0; i < mNumOfWay; i++, line++)
+	{
+		if(line->block == INVALID_BLOCK)
+			return line;
+
+		if(line->lastUsed < victim->lastUsed)
+			victim = line;
+	}
+
+	return victim;
+}
+
+BlockCache::Line* BlockCache::findLowestDirty(void)
+{
+	Line *line = 0;
+	uint32_t numOfLine = (mSetMask + 1) * mNumOfWay;
+
+	for(uint32_t i = 0; i < numOfLine; i++)
+	{
+		if(mLine[i].dirty && (line == 0 || mLine[i].block < line->block))
+			line = &mLine[i];
+	}
+
+	return line;
+}
+
+void BlockCache::markClean(Line *line)
+{
+	if(line->dirty)
+	{
+		line->dirty = false;
+		mDirtyCount--;
+	}
+}
+
+// 교체될 블록이 변경되었으면 저장 장치에 저장한다.
+error_t BlockCache::evict(Line *line)
+{
+	error_t result;
+
+	if(line->dirty)
+	{
+		mStorage->lock();
+		result = mStorage->write(line->block, line->data);
+		mStorage->unlock();
+
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		markClean(line);
+	}
+
+	line->block = INVALID_BLOCK;
+	return error_t::ERROR_NONE;
+}
+
+error_t BlockCache::fill(Line *line, uint32_t block)
+{
+	error_t result;
+
+	result = evict(line);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	mStorage->lock();
+	result = mStorage->read(block, line->data);
+	mStorage->unlock();
+
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	line->block = block;
+	line->lastUsed = ++mUseCount;
+	return error_t::ERROR_NONE;
+}
+
+// block부터 미리 읽기 수만큼의 블록을 한 명령으로 읽어 캐시에 없는 블록들을 채운다.
+error_t BlockCache::prefetch(uint32_t block)
+{
+	uint32_t count = mReadAhead, numOfBlock = mStorage->getNumOfBlock();
+	error_t result;
+	Line *line;
+
+	if(block + count > numOfBlock)
+		count = numOfBlock - block;
+
+	mStorage->lock();
+	result = mStorage->readBlocks(block, count, mReadAheadBuffer);
+	mStorage->unlock();
+
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		// 캐시에 있는 블록은 저장 장치보다 새로운 데이터일 수 있으므로 그대로 둠
+		if(find(block + i))
+			continue;
+
+		line = findVictim(block + i);
+		result = evict(line);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		memcpy(line->data, &mReadAheadBuffer[mBlockSize * i], mBlockSize);
+		line->block = block + i;
+		line->lastUsed = ++mUseCount;
+	}
+
+	mLastMiss = block + count - 1;
+	return error_t::ERROR_NONE;
+}
+
+error_t BlockCache::read(uint32_t block, void *des)
+{
+	error_t result;
+	Line *line;
+
+	if(mLine == 0)
+		return error_t::NOT_INITIALIZED;
+
+	line = find(block);
+	if(line)
+	{
+		mHitCount++;
+		line->lastUsed = ++mUseCount;
+		memcpy(des, line->data, mBlockSize);
+		return error_t::ERROR_NONE;
+	}
+
+	mMissCount++;
+
+	// 직전에 놓친 블록의 다음 블록이면 연속 읽기로 보고 미리 읽음
+	if(mReadAhead > 1 && block == mLastMiss + 1)
+	{
+		result = prefetch(block);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		line = find(block);
+	}
+	else
+	{
+		line = findVictim(block);
+		result = fill(line, block);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		mLastMiss = block;
+	}
+
+	memcpy(des, line->data, mBlockSize);
+	return error_t::ERROR_NONE;
+}
+
+error_t BlockCache::write(uint32_t block, void *src)
+{
+	error_t result;
+	Line *line;
+
+	if(mLine == 0)
+		return error_t::NOT_INITIALIZED;
+
+	line = find(block);
+	if(line == 0)
+	{
+		// 블록 전체를 덮어 쓰므로 저장 장치에서 읽지 않음
+		line = findVictim(block);
+		result = evict(line);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		line->block = block;
+	}
+
+	memcpy(line->data, src, mBlockSize);
+	line->lastUsed = ++mUseCount;
+
+	if(mPolicy == WRITE_THROUGH)
+	{
+		mStorage->lock();
+		result = mStorage->write(block, line->data);
+		mStorage->unlock();
+		return result;
+	}
+
+	if(!line->dirty)
+	{
+		line->dirty = true;
+		mDirtyCount++;
+	}
+
+	if(mDirtyLimit && mDirtyCount >= mDirtyLimit)
+		return sync();
+
+	return error_t::ERROR_NONE;
+}
+
+error_t BlockCache::writeBlocks(uint32_t block, uint32_t count, void *src)
+{
+	uint8_t *cSrc = (uint8_t*)src;
+	error_t result;
+	Line *line;
+
+	if(mLine == 0)
+		return error_t::NOT_INITIALIZED;
+
+	if(count == 1)
+		return write(block, src);
+
+	mStorage->lock();
+	result = mStorage->writeBlocks(block, count, src);
+	mStorage->unlock();
+
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	// 캐시에 있던 블록은 새 데이터로 바꾸고 저장된 상태로 표시
+	for(uint32_t i = 0; i < count; i++)
+	{
+		line = find(block + i);
+		if(line)
+		{
+			memcpy(line->data, &cSrc[mBlockSize * i], mBlockSize);
+			markClean(line);
+		}
+	}
+
+	return error_t::ERROR_NONE;
+}
+
+error_t BlockCache::readBlocks(uint32_t block, uint32_t count, void *des)
+{
+	uint8_t *cDes = (uint8_t*)des;
+	error_t result;
+	Line *line;
+
+	if(mLine == 0)
+		return error_t::NOT_INITIALIZED;
+
+	if(count == 1)
+		return read(block, des);
+
+	mStorage->lock();
+	result = mStorage->readBlocks(block, count, des);
+	mStorage->unlock();
+
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	// 저장되지 않은 블록은 캐시의 데이터로 덮어 씀
+	for(uint32_t i = 0; i < count; i++)
+	{
+		line = find(block + i);
+		if(line && line->dirty)
+			memcpy(&cDes[mBlockSize * i], line->data, mBlockSize);
+	}
+
+	return error_t::ERROR_NONE;
+}
+
+error_t BlockCache::sync(void)
+{
+	uint32_t block, count;
+	error_t result;
+	Line *line;
+
+	while(mDirtyCount)
+	{
+		line = findLowestDirty();
+		block = line->block;
+
+		// 뒤로 이어지는 변경된 블록들을 미리 읽기 버퍼에 모아 한 명령으로 저장
+		count = 1;
+		if(mReadAheadBuffer)
+		{
+			memcpy(mReadAheadBuffer, line->data, mBlockSize);
+			while(count < mReadAhead)
+			{
+				line = find(block + count);
+				if(line == 0 || !line->dirty)
+					break;
+
+				memcpy(&mReadAheadBuffer[mBlockSize * count], line->data, mBlockSize);
+				count++;
+			}
+
+			mStorage->lock();
+			result = mStorage->writeBlocks(block, count, mReadAheadBuffer);
+			mStorage->unlock();
+		}
+		else
+		{
+			mStorage->lock();
+			result = mStorage->write(block, line->data);
+			mStorage->unlock();
+		}
+
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		for(uint32_t i = 0; i < count; i++)
+			markClean(find(block + i));
+	}
+
+	mStorage->lock();
+	result = mStorage->sync();
+	mStorage->unlock();
+
+	return result;
+}
+
+void BlockCache::invalidate(void)
+{
+	uint32_t numOfLine = (mSetMask + 1) * mNumOfWay;
+
+	for(uint32_t i = 0; i < numOfLine; i++)
+	{
+		mLine[i].block = INVALID_BLOCK;
+		mLine[i].dirty = false;
+	}
+
+	mDirtyCount = 0;
+	mLastMiss = INVALID_BLOCK;
+}
+
+uint32_t BlockCache::getHitCount(void)
+{
+	return mHitCount;
+}
+
+uint32_t BlockCache::getMissCount(void)
+{
+	return mMissCount;
+}
+
+uint32_t BlockCache::getBlockSize(void)
+{
+	return mBlockSize;
+}
+
+uint32_t BlockCache::getNumOfBlock(void)
+{
+	return mStorage->getNumOfBlock();
+}
+
+bool BlockCache::isConnected(void)
+{
+	return mStorage && mStorage->isConnected();
+}
+
@@ -10,6 +10,7 @@
 Directory::Directory(FileSystem &fileSystem)
 {
 	mFileSystem = &fileSystem;
+	mCluster = 0;
 	mFileCount = mDirectoryCount = 0;
 	mCurrentFileIndex = mCurrentDirectoryIndex = 0xFFFFFFFF;
 }
@@ -17,6 +18,7 @@ Directory::Directory(FileSystem &fileSystem)
 Directory::Directory(FileSystem *fileSystem)
 {
 	mFileSystem = fileSystem;
+	mCluster = 0;
 	mFileCount = mDirectoryCount = 0;
 	mCurrentFileIndex = mCurrentDirectoryIndex = 0xFFFFFFFF;
 }
@@ -24,38 +26,49 @@ Directory::Directory(FileSystem *fileSystem)
 error_t Directory::initialize(void)
 {
 	error_t result;
+
+	mFileSystem->lock();
 	result = mFileSystem->initialize();
-	if(result != error_t::ERROR_NONE)
-		return result;
+	if(result == error_t::ERROR_NONE)
+		update();
+	if(result == error_t::ERROR_NONE)
+		mFileSystem->setDirectoryOwner(this);
+	mFileSystem->unlock();
+
+	return result;
+}
 
+// 파일 시스템의 현재 디렉토리로 개수와 클러스터를 갱신한다. lock()을 건 상태에서 호출한다.
+void Directory::update(void)
+{
 	mDirectoryCount = mFileSystem->getDirectoryCount();
 	mFileCount = mFileSystem->getFileCount();
+	mCluster = mFileSystem->getCurrentDirectoryCluster();
 	mCurrentFileIndex = mCurrentDirectoryIndex = 0xFFFFFFFF;
-
-	return error_t::ERROR_NONE;
 }
 
-uint32_t Directory::getDirectoryCount(void)
+// 다른 객체가 탐색 위치를 옮겼으면 이 객체의 디렉토리로 돌아가서 처음부터 다시 찾도록 한다.
+// 탐색이 성공하면 각 함수의 끝에서 소유자를 이 객체로 설정한다. lock()을 건 상태에서 호출한다.
+error_t Directory::select(void)
 {
-	return mDirectoryCount;
-}
+	if(mFileSystem->getDirectoryOwner() == this)
+		return error_t::ERROR_NONE;
 
-uint32_t Directory::getFileCount(void)
-{
-	return mFileCount;
+	mCurrentFileIndex = mCurrentDirectoryIndex = 0xFFFFFFFF;
+
+	return mFileSystem->moveToCluster(mCluster);
 }
 
-error_t Directory::getFileName(uint32_t index, void* des, uint32_t size)
+error_t Directory::moveToFile(uint32_t index)
 {
-	error_t result;
-
-	if(index >= mFileCount)
-		return error_t::INDEX_OVER;
+	error_t result = error_t::ERROR_NONE;
 
 	mCurrentDirectoryIndex = 0xFFFFFFFF;
 
 	if(index < mCurrentFileIndex)
 	{
+		mCurrentFileIndex = 0xFFFFFFFF;
+
 		result = mFileSystem->moveToStart();
 		if(result != error_t::ERROR_NONE)
 			return result;
@@ -71,35 +84,34 @@ error_t Directory::getFileName(uint32_t index, void* des, uint32_t size)
 	while(index != mCurrentFileIndex)
 	{
 		result = mFileSystem->moveToNextFile();
-		if(result != error_t::ERROR_NONE)
-			return result;
-
-		if(mFileSystem->isFile() == false)
+		if(result == error_t::ERROR_NONE && mFileSystem->isFile() == false)
 			result = mFileSystem->moveToNextFile();
 		if(result != error_t::ERROR_NONE)
+		{
+			mCurrentFileIndex = 0xFFFFFFFF;
 			return result;
+		}
 
 		mCurrentFileIndex++;
 	}
 
-	return mFileSystem->getName(des, size);
+	return result;
 }
 
-error_t Directory::getDirectoryName(uint32_t index, void* des, uint32_t size)
+error_t Directory::moveToDirectory(uint32_t index)
 {
-	error_t result;
-
-	if(index >= mDirectoryCount)
-		return error_t::INDEX_OVER;
+	error_t result = error_t::ERROR_NONE;
 
 	mCurrentFileIndex = 0xFFFFFFFF;
 
 	if(index < mCurrentDirectoryIndex)
 	{
+		mCurrentDirectoryIndex = 0xFFFFFFFF;
+
 		result = mFileSystem->moveToStart();
 		if(result != error_t::ERROR_NONE)
 			return result;
-		
+
 		if(mFileSystem->isDirectory() == false)
 			result = mFileSystem->moveToNextDirectory();
 		if(result != error_t::ERROR_NONE)
@@ -112,137 +124,175 @@ error_t Directory::getDirectoryName(uint32_t index, void* des, uint32_t size)
 	{
 		result = mFileSystem->moveToNextDirectory();
 		if(result != error_t::ERROR_NONE)
+		{
+			mCurrentDirectoryIndex = 0xFFFFFFFF;
 			return result;
+		}
 
 		mCurrentDirectoryIndex++;
 	}
-	
-	return mFileSystem->getName(des, size);
+
+	return result;
 }
 
-error_t Directory::enterDirectory(uint32_t index)
+uint32_t Directory::getDirectoryCount(void)
+{
+	return mDirectoryCount;
+}
+
+uint32_t Directory::getFileCount(void)
+{
+	return mFileCount;
+}
+
+error_t Directory::getFileName(uint32_t index, void* des, uint32_t size)
 {
 	error_t result;
 
-	if(index >= mDirectoryCount)
+	if(index >= mFileCount)
 		return error_t::INDEX_OVER;
 
-	mCurrentFileIndex = 0xFFFFFFFF;
+	mFileSystem->lock();
+	result = select();
+	if(result == error_t::ERROR_NONE)
+		result = moveToFile(index);
+	if(result == error_t::ERROR_NONE)
+		result = mFileSystem->getName(des, size);
+	if(result == error_t::ERROR_NONE)
+		mFileSystem->setDirectoryOwner(this);
+	mFileSystem->unlock();
+
+	return result;
+}
 
-	if(index < mCurrentDirectoryIndex)
-	{
-		result = mFileSystem->moveToStart();
-		if(result != error_t::ERROR_NONE)
-			return result;
-		
-		if(mFileSystem->isDirectory() == false)
-			result = mFileSystem->moveToNextDirectory();
-		if(result != error_t::ERROR_NONE)
-			return result;
+error_t Directory::getDirectoryName(uint32_t index, void* des, uint32_t size)
+{
+	error_t result;
 
-		mCurrentDirectoryIndex = 0;
-	}
+	if(index >= mDirectoryCount)
+		return error_t::INDEX_OVER;
 
-	while(index != mCurrentDirectoryIndex)
-	{
-		result = mFileSystem->moveToNextDirectory();
-		if(result != error_t::ERROR_NONE)
-		{
-			return result;
-		}
+	mFileSystem->lock();
+	result = select();
+	if(result == error_t::ERROR_NONE)
+		result = moveToDirectory(index);
+	if(result == error_t::ERROR_NONE)
+		result = mFileSystem->getName(des, size);
+	if(result == error_t::ERROR_NONE)
+		mFileSystem->setDirectoryOwner(this);
+	mFileSystem->unlock();
+
+	return result;
+}
 
-		mCurrentDirectoryIndex++;
-	}
-	
-	result = mFileSystem->enterDirectory();
-	if(result != error_t::ERROR_NONE)
-		return result;
-	
-	mDirectoryCount = mFileSystem->getDirectoryCount();
-	mFileCount = mFileSystem->getFileCount();
+error_t Directory::enterDirectory(uint32_t index)
+{
+	error_t result;
 
-	mCurrentDirectoryIndex = 0xFFFFFFFF;
-	mCurrentFileIndex = 0xFFFFFFFF;
-	return error_t::ERROR_NONE;
+	if(index >= mDirectoryCount)
+		return error_t::INDEX_OVER;
+
+	mFileSystem->lock();
+	result = select();
+	if(result == error_t::ERROR_NONE)
+		result = moveToDirectory(index);
+	if(result == error_t::ERROR_NONE)
+		result = mFileSystem->enterDirectory();
+	if(result == error_t::ERROR_NONE)
+		update();
+	if(result == error_t::ERROR_NONE)
+		mFileSystem->setDirectoryOwner(this);
+	mFileSystem->unlock();
+
+	return result;
 }
 
 error_t Directory::enterDirectory(const char *utfName)
 {
 	error_t result;
 
-	mCurrentFileIndex = 0xFFFFFFFF;
+	if(mDirectoryCount == 0)
+		return error_t::NOT_EXIST_NAME;
 
-	result = mFileSystem->moveToStart();
+	mFileSystem->lock();
+	result = select();
 	if(result != error_t::ERROR_NONE)
-		return result;
-	
-	if(mFileSystem->isDirectory() == false)
-		result = mFileSystem->moveToNextDirectory();
-	if(result != error_t::ERROR_NONE)
-		return result;
+		goto error_handler;
 
-	mCurrentDirectoryIndex = 0;
+	result = moveToDirectory(0);
+	if(result != error_t::ERROR_NONE)
+		goto error_handler;
 
+	result = error_t::NOT_EXIST_NAME;
 	while(mCurrentDirectoryIndex < mDirectoryCount)
 	{
-		mCurrentDirectoryIndex++;
-
 		if(mFileSystem->compareName(utfName) == false)
 		{
 			result = mFileSystem->enterDirectory();
-			if(result != error_t::ERROR_NONE)
-				return result;
-
-			mDirectoryCount = mFileSystem->getDirectoryCount();
-			mFileCount = mFileSystem->getFileCount();
+			if(result == error_t::ERROR_NONE)
+				update();
+			break;
+		}
 
-			return error_t::ERROR_NONE;
+		mCurrentDirectoryIndex++;
+		if(mCurrentDirectoryIndex == mDirectoryCount)
+		{
+			mCurrentDirectoryIndex = 0xFFFFFFFF;
+			break;
 		}
 
 		result = mFileSystem->moveToNextDirectory();
 		if(result != error_t::ERROR_NONE)
-			return result;
+		{
+			mCurrentDirectoryIndex = 0xFFFFFFFF;
+			break;
+		}
+		result = error_t::NOT_EXIST_NAME;
 	}
-	
-	return error_t::NOT_EXIST_NAME;
+
+error_handler:
+	if(result == error_t::ERROR_NONE)
+		mFileSystem->setDirectoryOwner(this);
+	mFileSystem->unlock();
+	return result;
 }
 
 error_t Directory::returnDirectory(void)
 {
 	error_t result;
 
-	result = mFileSystem->returnDirectory();
-	if(result != error_t::ERROR_NONE)
-		return result;
-	
-	mDirectoryCount = mFileSystem->getDirectoryCount();
-	mFileCount = mFileSystem->getFileCount();
-
-	mCurrentDirectoryIndex = 0xFFFFFFFF;
-	mCurrentFileIndex = 0xFFFFFFFF;
-	
-	return error_t::ERROR_NONE;
+	mFileSystem->lock();
+	result = select();
+	if(result == error_t::ERROR_NONE)
+		result = mFileSystem->returnDirectory();
+	if(result == error_t::ERROR_NONE)
+		update();
+	if(result == error_t::ERROR_NONE)
+		mFileSystem->setDirectoryOwner(this);
+	mFileSystem->unlock();
+
+	return result;
 }
 
 error_t Directory::makeDirectory(const char *name)
 {
 	error_t result;
 
-	result = mFileSystem->makeDirectory(name);
-	if(result != error_t::ERROR_NONE)
-		return result;
-	
-	mDirectoryCount = mFileSystem->getDirectoryCount();
-	mFileCount = mFileSystem->getFileCount();
-
-	mCurrentDirectoryIndex = 0xFFFFFFFF;
-	mCurrentFileIndex = 0xFFFFFFFF;
-	
-	return error_t::ERROR_NONE;
+	mFileSystem->lock();
+	result = select();
+	if(result == error_t::ERROR_NONE)
+		result = mFileSystem->makeDirectory(name);
+	if(result == error_t::ERROR_NONE)
+		update();
+	if(result == error_t::ERROR_NONE)
+		mFileSystem->setDirectoryOwner(this);
+	mFileSystem->unlock();
+
+	return result;
 }
 
 uint32_t Directory::getCurrentDirectoryCluster(void)
 {
-	return mFileSystem->getCurrentDirectoryCluster();
+	return mCluster;
 }
 
@@ -21,14 +21,23 @@
 Fat32::Fat32(MassStorage &storage) : FileSystem(storage)
 {
 	mAbleFlag = false;
-	mFileOpen = false;
+	mCurrentHandle = 0;
+	for(uint32_t i=0;i<FAT32_HANDLE_COUNT;i++)
+		mHandle[i].openFlag = false;
 	mDirectoryEntry.initialize(mCluster, getSectorBuffer());
 }
 
 error_t Fat32::initialize(void)
 {
 	error_t result;
-	uint32_t fatStartSector, fatBackupStartSector;
+	uint32_t fatStartSector, fatBackupStartSector, numOfSector, numOfCluster;
+
+	// 열린 파일이 있으면 FAT 캐시와 핸들의 정보가 사라지므로 다시 초기화하지 않음
+	for(uint32_t i=0;i<FAT32_HANDLE_COUNT;i++)
+	{
+		if(mHandle[i].openFlag)
+			return error_t::BUSY;
+	}
 	
 	mStorage->lock();
 	if(mStorage->isConnected() == false)
@@ -60,6 +69,10 @@ error_t Fat32::initialize(void)
 		mFatSize = *(uint32_t*)&mSectorBuffer[0x24];
 		mRootCluster = *(uint32_t*)&mSectorBuffer[0x2C];
 		fatBackupStartSector = fatStartSector + mFatSize;
+		numOfSector = *(uint32_t*)&mSectorBuffer[0x20];
+		if(numOfSector == 0)
+			numOfSector = mNumOfSector;
+		numOfCluster = (mFirstSector + numOfSector - (fatBackupStartSector + mFatSize)) / mSectorPerCluster;
 
 		mStorage->lock();
 		result = mStorage->read(mFsInfoSector, mSectorBuffer);
@@ -77,7 +90,8 @@ error_t Fat32::initialize(void)
 		mNumOfFreeClusters = *(uint32_t*)&mSectorBuffer[0x1E8];
 		mNextFreeCluster = *(uint32_t*)&mSectorBuffer[0x1EC];
 		
-		mCluster.initialize(mStorage, fatStartSector, fatBackupStartSector, 512, mSectorPerCluster);
+		mCluster.initialize(mStorage, fatStartSector, fatBackupStartSector, 512, mSectorPerCluster, numOfCluster);
+		mCluster.setFsInfo(mFsInfoSector, mNumOfFreeClusters, mNextFreeCluster);
 		mCluster.setRootCluster(mRootCluster);
 		mDirectoryEntry.initialize(mCluster, mSectorBuffer);
 
@@ -94,8 +108,7 @@ uint32_t Fat32::getCount(uint8_t *type, uint8_t typeCount)
 
 	error_t result;
 
-	if(mFileOpen)
-		return 0;
+	selectDirectoryCursor();
 
 	result = mDirectoryEntry.moveToStart();
 	if(result != error_t::ERROR_NONE)
@@ -137,8 +150,7 @@ error_t Fat32::returnDirectory(void)
 {
 	error_t result;
 
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	if(mCluster.getCurrentCluster() != mRootCluster)
 	{
@@ -160,8 +172,7 @@ error_t Fat32::returnDirectory(void)
 
 error_t Fat32::moveToNextItem(uint8_t *type, uint8_t typeCount)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	error_t result;
 	uint8_t attribute;
@@ -187,8 +198,7 @@ error_t Fat32::moveToCluster(uint32_t cluster)
 {
 	error_t result;
 
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 	
 	result = mDirectoryEntry.setCluster(cluster);
 	if(result != error_t::ERROR_NONE)
@@ -199,24 +209,21 @@ error_t Fat32::moveToCluster(uint32_t cluster)
 
 error_t Fat32::moveToRootDirectory(void)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	return mDirectoryEntry.moveToRoot();
 }
 
 error_t Fat32::moveToStart(void)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	return mDirectoryEntry.moveToStart();
 }
 
 error_t Fat32::moveToNextDirectory(void)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	const uint8_t type[1] = {DIRECTORY};
 
@@ -225,8 +232,7 @@ error_t Fat32::moveToNextDirectory(void)
 
 error_t Fat32::moveToNextFile(void)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	const uint8_t type[4] = {READ_ONLY, HIDDEN_FILE, SYSEM_FILE, ARCHIVE};
 
@@ -235,8 +241,7 @@ error_t Fat32::moveToNextFile(void)
 
 error_t Fat32::enterDirectory(void)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	uint32_t cluster;
 
@@ -254,16 +259,14 @@ error_t Fat32::enterDirectory(void)
 
 error_t Fat32::getName(void* des, uint32_t size)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	mCluster.setCursor();
 
 	return mDirectoryEntry.getTargetName(des, size);
 }
 
 error_t Fat32::makeDirectory(const char *name)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	error_t result;
 
@@ -293,7 +296,11 @@ error_t Fat32::makeDirectory(const char *name)
 			return result;
 	}
 
-	return mDirectoryEntry.makeDirectory(name);
+	result = mDirectoryEntry.makeDirectory(name);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	return mCluster.save();
 }
 
 bool Fat32::isDirectory(void)
@@ -323,55 +330,97 @@ error_t Fat32::open(void)
 {
 	error_t result;
 
-	if(mFileOpen)
+	Handle *handle = 0;
+	uint32_t cluster, directoryCluster, entryPosition;
+
+	mCluster.setCursor();
+	cluster = mDirectoryEntry.getTargetCluster();
+	directoryCluster = mCluster.getStartCluster();
+	entryPosition = mDirectoryEntry.getTargetPosition();
+
+	for(uint32_t i=0;i<FAT32_HANDLE_COUNT;i++)
+	{
+		if(!mHandle[i].openFlag)
+		{
+			if(handle == 0)
+				handle = &mHandle[i];
+		}
+		// 같은 체인을 두 커서가 바꾸지 않도록 같은 파일은 한번만 열 수 있음
+		// 클러스터가 없는 빈 파일도 구분하도록 디렉토리 엔트리의 위치로 비교
+		else if(mHandle[i].directoryCluster == directoryCluster && mHandle[i].entryPosition == entryPosition)
+			return error_t::ALREADY_OPENED;
+	}
+
+	if(handle == 0)
 		return error_t::BUSY;
-	
-	mCluster.backup();
-	mFileCluster = mDirectoryEntry.getTargetCluster();
-	result = mCluster.setCluster(mFileCluster);
 
-	if(result == error_t::ERROR_NONE)
-		mFileOpen = true;
+	handle->fileCluster = cluster;
+	handle->fileSize = mDirectoryEntry.getTargetFileSize();
+	handle->directoryCluster = directoryCluster;
+	handle->entryPosition = entryPosition;
+	handle->appendFlag = false;
+
+	mCluster.clearCursor(handle->cursor);
+	mCluster.setCursor(&handle->cursor);
+	result = mCluster.setCluster(cluster);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	handle->openFlag = true;
+	mCurrentHandle = handle;
 	
-	return result;
+	return error_t::ERROR_NONE;
 }
 
 error_t Fat32::open(const char *name)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
-	error_t result;
+	error_t result = error_t::ERROR_NONE;
+	uint32_t directory = mCluster.getStartCluster();
+	const char *next;
 
-	// 동일한 이름이 있는지 확인 시작
-	result = mDirectoryEntry.moveToStart();
-	if(result != error_t::ERROR_NONE)
-		return result;
+	if(*name == '/')
+	{
+		result = mDirectoryEntry.moveToRoot();
+		name++;
+	}
 	
-	while(true)
+	// 경로의 디렉토리들을 차례로 들어감
+	while(result == error_t::ERROR_NONE && (next = strchr(name, '/')))
 	{
-		if(!mDirectoryEntry.comapreTargetName(name))
+		if(next != name)
 		{
-			mCluster.backup();
-			result = mCluster.setCluster(mDirectoryEntry.getTargetCluster());
-
+			result = mDirectoryEntry.moveToName(name);
 			if(result == error_t::ERROR_NONE)
-				mFileOpen = true;
-
-			return result;
+				result = enterDirectory();
 		}
+		name = next + 1;
+	}
 
-		result = mDirectoryEntry.moveToNext();
-		if(result == error_t::INDEX_OVER)
-			return error_t::NO_FILE;
-		else if(result != error_t::ERROR_NONE)
-			return result;
+	if(result == error_t::ERROR_NONE)
+		result = mDirectoryEntry.moveToName(name);
+	
+	// 실패하면 원래의 디렉토리로 되돌림
+	if(result != error_t::ERROR_NONE)
+	{
+		mDirectoryEntry.setCluster(directory);
+		return result == error_t::NOT_EXIST_NAME ? error_t::NO_FILE : result;
 	}
+
+	return open();
 }
 
 error_t Fat32::moveToFileStart(void)
 {
-	return mCluster.setCluster(mFileCluster);
+	error_t result;
+
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	mCurrentHandle->appendFlag = false;
+	return mCluster.setCluster(mCurrentHandle->fileCluster);
 }
 
 bool Fat32::compareName(const char *utf8)
@@ -379,10 +428,21 @@ bool Fat32::compareName(const char *utf8)
 	return mDirectoryEntry.comapreTargetName(utf8);
 }
 
+error_t Fat32::moveToName(const char *utf8)
+{
+	selectDirectoryCursor();
+
+	return mDirectoryEntry.moveToName(utf8);
+}
+
 error_t Fat32::read(void *des)
 {
 	error_t result;
 
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
 	result = mCluster.readDataSector(des);
 	if(result == error_t::ERROR_NONE)
 		result = mCluster.increaseDataSectorIndex();
@@ -394,27 +454,201 @@ error_t Fat32::write(void *src)
 {
 	error_t result;
 
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	result = prepareWrite();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
 	result = mCluster.writeDataSector(src);
 	if(result == error_t::ERROR_NONE)
 		result = mCluster.increaseDataSectorIndex();
 	
+	// 체인의 마지막 섹터까지 썼으면 다음 쓰기에서 클러스터를 추가
+	if(result == error_t::NO_DATA)
+	{
+		mCurrentHandle->appendFlag = true;
+		result = error_t::ERROR_NONE;
+	}
+
 	return result;
 }
 
+uint32_t Fat32::read(void *des, uint32_t count)
+{
+	uint8_t *cDes = (uint8_t*)des;
+	uint32_t len = 0, num;
+	error_t result;
+
+	if(selectFileCursor() != error_t::ERROR_NONE)
+		return 0;
+
+	while(count)
+	{
+		num = mCluster.getContiguousSectorCount(count);
+		if(num > count)
+			num = count;
+
+		result = mCluster.readDataSectors(cDes, num);
+		if(result != error_t::ERROR_NONE)
+			break;
+
+		cDes += num * 512;
+		len += num;
+		count -= num;
+
+		result = mCluster.increaseDataSectorIndex(num);
+		if(result != error_t::ERROR_NONE)
+			break;
+	}
+
+	return len;
+}
+
+uint32_t Fat32::write(void *src, uint32_t count)
+{
+	uint8_t *cSrc = (uint8_t*)src;
+	uint32_t len = 0, num;
+	error_t result;
+
+	if(selectFileCursor() != error_t::ERROR_NONE)
+		return 0;
+
+	while(count)
+	{
+		result = prepareWrite();
+		if(result != error_t::ERROR_NONE)
+			break;
+
+		num = mCluster.getContiguousSectorCount(count);
+		if(num > count)
+			num = count;
+
+		result = mCluster.writeDataSectors(cSrc, num);
+		if(result != error_t::ERROR_NONE)
+			break;
+
+		cSrc += num * 512;
+		len += num;
+		count -= num;
+
+		result = mCluster.increaseDataSectorIndex(num);
+		if(result == error_t::NO_DATA)
+			mCurrentHandle->appendFlag = true;
+		else if(result != error_t::ERROR_NONE)
+			break;
+	}
+
+	return len;
+}
+
+// 선택된 핸들의 커서로 체인을 탐색하도록 설정한다.
+error_t Fat32::selectFileCursor(void)
+{
+	if(mCurrentHandle == 0)
+		return error_t::FILE_NOT_OPENED;
+
+	mCluster.setCursor(&mCurrentHandle->cursor);
+	return error_t::ERROR_NONE;
+}
+
+// 디렉토리의 커서로 체인을 탐색하도록 설정한다.
+// 디렉토리의 탐색 위치가 옮겨지므로 탐색 위치를 기억하는 Directory가 다시 찾도록 소유자를 지운다.
+void Fat32::selectDirectoryCursor(void)
+{
+	mCluster.setCursor();
+	mDirectoryOwner = 0;
+}
+
+// 이전의 쓰기가 체인의 끝에서 멈췄으면 새 클러스터를 추가하고 그 곳으로 이동한다.
+// 새 클러스터는 바로 데이터로 덮어쓰므로 0으로 지우지 않는다.
+error_t Fat32::prepareWrite(void)
+{
+	error_t result;
+
+	if(mCurrentHandle->fileCluster < 2)
+		return allocateFileCluster(false);
+
+	if(mCurrentHandle->appendFlag)
+	{
+		result = mCluster.append(false);
+		if(result != error_t::ERROR_NONE)
+			return result;
+		mCurrentHandle->appendFlag = false;
+	}
+
+	return error_t::ERROR_NONE;
+}
+
+// 다른 기기에서 만든 0 바이트 파일은 시작 클러스터가 0이므로 첫 클러스터를 할당하여 디렉토리 엔트리에 먼저 저장하고 그 곳으로 이동한다.
+// 엔트리보다 FAT가 먼저 저장 장치에 기록되도록 저장한 뒤에 엔트리를 바꾼다.
+error_t Fat32::allocateFileCluster(bool clear)
+{
+	Handle *handle = mCurrentHandle;
+	uint32_t cluster;
+	error_t result;
+
+	cluster = mCluster.allocate(clear);
+	if(cluster == 0)
+		return error_t::NO_FREE_DATA;
+
+	result = mCluster.save();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	mCluster.setCursor();
+	result = mDirectoryEntry.saveFileCluster(handle->directoryCluster, handle->entryPosition, cluster);
+	mCluster.setCursor(&handle->cursor);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	handle->fileCluster = cluster;
+	handle->appendFlag = false;
+
+	return mCluster.setCluster(cluster);
+}
+
 uint32_t Fat32::getFileSize(void)
 {
-	return mDirectoryEntry.getTargetFileSize();
+	if(mCurrentHandle == 0)
+		return 0;
+
+	return mCurrentHandle->fileSize;
 }
 
 error_t Fat32::moveToNextSector(void)
 {
+	error_t result;
+
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
 	return mCluster.increaseDataSectorIndex();
 }
 
+error_t Fat32::moveToSector(uint32_t sector)
+{
+	error_t result;
+
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	mCurrentHandle->appendFlag = false;
+
+	// 클러스터가 없는 빈 파일은 이동할 섹터가 없음
+	if(mCurrentHandle->fileCluster < 2)
+		return error_t::NO_DATA;
+
+	return mCluster.moveToSector(sector);
+}
+
 error_t Fat32::makeFile(const char *name)
 {
-	if(mFileOpen)
-		return error_t::BUSY;
+	selectDirectoryCursor();
 
 	error_t result;
 
@@ -422,32 +656,168 @@ error_t Fat32::makeFile(const char *name)
 	if(result != error_t::ERROR_NONE)
 		return result;
 
-	return mDirectoryEntry.makeFile(name);
+	result = mDirectoryEntry.makeFile(name);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	return mCluster.save();
 }
 
 error_t Fat32::close(uint32_t fileSize)
 {
-	mCluster.restore();
-	mCluster.readDataSector(mSectorBuffer);
-	mFileOpen = false;
-	mDirectoryEntry.setTargetFileSize(fileSize);
-	return mDirectoryEntry.saveEntry();
+	uint32_t clusterSize = mSectorPerCluster * 512;
+	Handle *handle = mCurrentHandle;
+	error_t result;
+
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	// 오류가 발생해도 핸들은 반환
+	handle->openFlag = false;
+	mCurrentHandle = 0;
+
+	// 파일 크기보다 뒤에 남은 클러스터(reserve()로 예약했거나 덮어쓰기 전의 파일)를 해제
+	result = mCluster.truncate((fileSize + clusterSize - 1) / clusterSize);
+	mCluster.setCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	result = mDirectoryEntry.saveFileSize(handle->directoryCluster, handle->entryPosition, fileSize);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	return sync();
 }
 
 // 현재 열린 파일을 닫는다.
 // 반환 : 현재 발생한 에러를 반환한다.
 error_t Fat32::close(void)
 {
-	mFileOpen = false;
-	mCluster.restore();
+	error_t result;
+
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	mCurrentHandle->openFlag = false;
+	mCurrentHandle = 0;
+	mCluster.setCursor();
+	return mCluster.save();
+}
+
+error_t Fat32::reserve(uint32_t size, bool clear)
+{
+	uint32_t clusterSize = mSectorPerCluster * 512;
+	error_t result;
+
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	// 파일을 만들 때처럼 크기가 0이어도 첫 클러스터는 가지도록 함
+	if(mCurrentHandle->fileCluster < 2)
+	{
+		result = allocateFileCluster(clear);
+		if(result != error_t::ERROR_NONE)
+			return result;
+	}
+
+	result = mCluster.reserve((size + clusterSize - 1) / clusterSize, clear);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	// 쓰기가 체인의 끝에서 멈춰 있었으면 예약된 첫 클러스터로 이동
+	if(mCurrentHandle->appendFlag)
+	{
+		result = mCluster.moveToNextCluster();
+		if(result != error_t::ERROR_NONE)
+			return result;
+		mCurrentHandle->appendFlag = false;
+	}
+
 	return error_t::ERROR_NONE;
 }
 
+uint32_t Fat32::getFreeClusterCount(void)
+{
+	return mCluster.getFreeClusterCount();
+}
+
+error_t Fat32::sync(void)
+{
+	error_t result;
+
+	result = mCluster.save();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	mStorage->lock();
+	result = mStorage->sync();
+	mStorage->unlock();
+
+	return result;
+}
+
+error_t Fat32::sync(uint32_t fileSize)
+{
+	Handle *handle = mCurrentHandle;
+	error_t result;
+
+	result = selectFileCursor();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	// 크기보다 데이터와 FAT가 먼저 저장 장치에 기록되어야 함
+	result = sync();
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	mCluster.setCursor();
+	result = mDirectoryEntry.saveFileSize(handle->directoryCluster, handle->entryPosition, fileSize);
+	if(result != error_t::ERROR_NONE)
+		return result;
+	handle->fileSize = fileSize;
+
+	return sync();
+}
+
 // 현재 설정된 디렉토리의 시작 클러스터를 얻는 함수이다.
 // 반환 : 현재 클러스터의 번지를 반환함.
 uint32_t Fat32::getCurrentDirectoryCluster(void)
 {
+	mCluster.setCursor();
 	return mCluster.getStartCluster();
 }
 
+// 선택된 핸들의 번호를 얻는다.
+// 반환 : 선택된 핸들이 없으면 -1을 반환한다.
+int32_t Fat32::getHandle(void)
+{
+	if(mCurrentHandle == 0)
+		return -1;
+
+	return mCurrentHandle - mHandle;
+}
+
+error_t Fat32::selectHandle(int32_t handle)
+{
+	if(handle < 0 || handle >= FAT32_HANDLE_COUNT)
+		return error_t::WRONG_INDEX;
+
+	if(!mHandle[handle].openFlag)
+		return error_t::FILE_NOT_OPENED;
+
+	mCurrentHandle = &mHandle[handle];
+	return error_t::ERROR_NONE;
+}
+
+void* Fat32::getHandleBuffer(void)
+{
+	if(mCurrentHandle == 0)
+		return 0;
+
+	return mCurrentHandle->buffer;
+}
+
 
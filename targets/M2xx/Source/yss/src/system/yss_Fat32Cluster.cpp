@@ -14,62 +14,189 @@ static const int8_t gClearBuffer[512] = {0, };
 Fat32Cluster::Fat32Cluster(void)
 {
 	mStorage = 0;
-	mRoot = mAddress.cluster = 0;
+	mRoot = 0;
 	mFatSector = 0;
 	mFatBackupSector = 0;
-	mAddress.next = 0;
 	mFatLength = 0;
-	mAddress.sectorIndex = 0;
+	mCursor = &mDefaultCursor;
+	clearCursor(mDefaultCursor);
+	mFreeMapStart = 0;
+	mFreeMapCount = 0;
+	mClusterCount = 0;
+	mFreeCount = 0xFFFFFFFF;
+	mNextFree = 2;
+	mFailedRunCount = 0;
+	mFsInfoSector = 0;
+	mFsInfoUpdateFlag = false;
+	clearFatCache();
+}
+
+void Fat32Cluster::clearFatCache(void)
+{
+	for(uint32_t i=0;i<FAT32_FAT_CACHE_COUNT;i++)
+	{
+		mFatCache[i].table = 0xFFFFFFFF;
+		mFatCache[i].lastUsed = 0;
+		mFatCache[i].dirty = false;
+	}
+
+	mCacheCount = 0;
+	mCurrentFat = &mFatCache[0];
+	mFatTableBuffer = mCurrentFat->buffer;
 	mLastReadFatTable = 0xFFFFFFFF;
-	mUpdateFlag = false;
 }
 
 error_t Fat32Cluster::readFat(uint32_t cluster)
 {
-	uint32_t table = cluster / 128;
-	mAddress.tableIndex = cluster % 128;
-	error_t result = error_t::ERROR_NONE;
+	mCursor->address.tableIndex = cluster % 128;
+	return loadFat(cluster / 128);
+}
+
+// FAT 섹터를 캐시에서 찾아 현재 FAT 섹터로 설정한다.
+// 캐시에 없으면 가장 오래 사용되지 않은 섹터를 저장한 뒤에 그 자리로 읽어온다.
+error_t Fat32Cluster::loadFat(uint32_t table)
+{
+	FatCache *cache = mCurrentFat;
+	error_t result;
 
-	if(table != mLastReadFatTable)
+	if(cache->table != table)
 	{
-		result = save();
-		if(result != error_t::ERROR_NONE)
-			return result;
-	
-		mStorage->lock();
-		result = mStorage->read(mFatSector + table, mFatTableBuffer);
-		mStorage->unlock();
+		cache = 0;
+		for(uint32_t i=0;i<FAT32_FAT_CACHE_COUNT;i++)
+		{
+			if(mFatCache[i].table == table)
+			{
+				cache = &mFatCache[i];
+				break;
+			}
+		}
 
+		if(cache == 0)
+		{
+			cache = findOldestFat();
+
+			if(cache->dirty)
+			{
+				result = writeFat(cache);
+				if(result != error_t::ERROR_NONE)
+					return result;
+			}
+
+			mStorage->lock();
+			result = mStorage->read(mFatSector + table, cache->buffer);
+			mStorage->unlock();
+
+			if(result != error_t::ERROR_NONE)
+			{
+				cache->table = 0xFFFFFFFF;
+				cache->lastUsed = 0;
+				return result;
+			}
+
+			cache->table = table;
+		}
+
+		mCurrentFat = cache;
+		mFatTableBuffer = cache->buffer;
 		mLastReadFatTable = table;
 	}
 
+	cache->lastUsed = ++mCacheCount;
+
+	return error_t::ERROR_NONE;
+}
+
+Fat32Cluster::FatCache* Fat32Cluster::findOldestFat(void)
+{
+	FatCache *cache = &mFatCache[0];
+
+	for(uint32_t i=1;i<FAT32_FAT_CACHE_COUNT;i++)
+	{
+		if(mFatCache[i].lastUsed < cache->lastUsed)
+			cache = &mFatCache[i];
+	}
+
+	return cache;
+}
+
+// 캐시된 FAT 섹터를 첫번째 FAT와 백업 FAT에 저장한다.
+error_t Fat32Cluster::writeFat(FatCache *cache)
+{
+	error_t result;
+
+	mStorage->lock();
+	result = mStorage->write(mFatSector + cache->table, cache->buffer);
+	if(result == error_t::ERROR_NONE)
+		result = mStorage->write(mFatBackupSector + cache->table, cache->buffer);
+	mStorage->unlock();
+
+	if(result == error_t::ERROR_NONE)
+		cache->dirty = false;
+
 	return result;
 }
 
 uint32_t Fat32Cluster::calculateNextCluster(void)
 {
-	return mFatTableBuffer[mAddress.tableIndex] & 0x0FFFFFFF;
+	return mFatTableBuffer[mCursor->address.tableIndex] & 0x0FFFFFFF;
 }
 
-void Fat32Cluster::initialize(MassStorage *storage, uint32_t fatSector, uint32_t fatBackup, uint32_t sectorSize, uint8_t sectorPerCluster)
+void Fat32Cluster::initialize(MassStorage *storage, uint32_t fatSector, uint32_t fatBackup, uint32_t sectorSize, uint8_t sectorPerCluster, uint32_t numOfCluster)
 {
 	mStorage = storage;
 	mFatSector = fatSector;
 	mFatBackupSector = fatBackup;
-	mAddress.next = 0;
 	mFatLength = fatBackup - fatSector;
 	mSectorPerCluster = sectorPerCluster;
 	mSectorSize = sectorSize;
 	mDataStartSector = fatBackup + mFatLength;
-	mUpdateFlag = false;
+	mCursor = &mDefaultCursor;
+	clearCursor(mDefaultCursor);
+	clearFatCache();
+
+	// 클러스터 번호는 2부터 시작
+	mClusterCount = mFatLength * 128;
+	if(numOfCluster && numOfCluster + 2 < mClusterCount)
+		mClusterCount = numOfCluster + 2;
+
+	mFreeMapStart = 0;
+	mFreeMapCount = 0;
+	mFreeCount = 0xFFFFFFFF;
+	mNextFree = 2;
+	mFailedRunCount = 0;
+	mFsInfoSector = 0;
+	mFsInfoUpdateFlag = false;
+}
+
+void Fat32Cluster::setFsInfo(uint32_t sector, uint32_t freeCount, uint32_t nextFree)
+{
+	mFsInfoSector = sector;
+	mFsInfoUpdateFlag = false;
+
+	if(freeCount > mClusterCount - 2)
+		freeCount = 0xFFFFFFFF;
+	mFreeCount = freeCount;
+
+	if(nextFree < 2 || nextFree >= mClusterCount)
+		nextFree = 2;
+	mNextFree = nextFree;
+}
+
+uint32_t Fat32Cluster::getFreeClusterCount(void)
+{
+	return mFreeCount;
 }
 
 error_t Fat32Cluster::readDataSector(void* des)
 {
 	error_t result;
 	
+	// 클러스터가 없는 빈 파일의 커서는 데이터 영역 앞을 가리키므로 거부
+	if(mCursor->address.cluster < 2)
+		return error_t::WRONG_INDEX;
+
 	mStorage->lock();
-	result = mStorage->read(mDataStartSector + (mAddress.cluster - 2) * mSectorPerCluster + mAddress.sectorIndex, des);
+	result = mStorage->read(mDataStartSector + (mCursor->address.cluster - 2) * mSectorPerCluster + mCursor->address.sectorIndex, des);
 	mStorage->unlock();
 
 	return result;
@@ -79,8 +206,42 @@ error_t Fat32Cluster::writeDataSector(void* des)
 {
 	error_t result;
 
+	// 클러스터가 없는 빈 파일의 커서는 데이터 영역 앞을 가리키므로 거부
+	if(mCursor->address.cluster < 2)
+		return error_t::WRONG_INDEX;
+
+	mStorage->lock();
+	result = mStorage->write(mDataStartSector + (mCursor->address.cluster - 2) * mSectorPerCluster + mCursor->address.sectorIndex, des);
+	mStorage->unlock();
+
+	return result;
+}
+
+error_t Fat32Cluster::readDataSectors(void* des, uint32_t count)
+{
+	error_t result;
+	
+	// 클러스터가 없는 빈 파일의 커서는 데이터 영역 앞을 가리키므로 거부
+	if(mCursor->address.cluster < 2)
+		return error_t::WRONG_INDEX;
+
+	mStorage->lock();
+	result = mStorage->readBlocks(mDataStartSector + (mCursor->address.cluster - 2) * mSectorPerCluster + mCursor->address.sectorIndex, count, des);
+	mStorage->unlock();
+
+	return result;
+}
+
+error_t Fat32Cluster::writeDataSectors(void* src, uint32_t count)
+{
+	error_t result;
+
+	// 클러스터가 없는 빈 파일의 커서는 데이터 영역 앞을 가리키므로 거부
+	if(mCursor->address.cluster < 2)
+		return error_t::WRONG_INDEX;
+
 	mStorage->lock();
-	result = mStorage->write(mDataStartSector + (mAddress.cluster - 2) * mSectorPerCluster + mAddress.sectorIndex, des);
+	result = mStorage->writeBlocks(mDataStartSector + (mCursor->address.cluster - 2) * mSectorPerCluster + mCursor->address.sectorIndex, count, src);
 	mStorage->unlock();
 
 	return result;
@@ -88,64 +249,205 @@ error_t Fat32Cluster::writeDataSector(void* des)
 
 error_t Fat32Cluster::moveToStart(void)
 {
-	return moveTo(mAddress.start);
+	return moveTo(mCursor->address.start);
 }
 
 error_t Fat32Cluster::moveToRoot(void)
 {
-	mAddress.start = mRoot;
+	mCursor->address.start = mRoot;
 	return moveTo(mRoot);
 }
 
 error_t Fat32Cluster::moveTo(uint32_t cluster)
 {
+	mCursor->address.sectorIndex = 0;
+
+	// 다른 체인으로 바뀌면 구간 정보를 새로 만듬
+	// 비어 있는 파일은 시작 클러스터가 0이므로 지워진 커서와 구분하기 위해 구간의 수도 확인
+	if(mCursor->extentStart != cluster || mCursor->extentCount == 0)
+	{
+		mCursor->extentStart = cluster;
+		mCursor->extent[0].index = 0;
+		mCursor->extent[0].cluster = cluster;
+		mCursor->extent[0].count = 1;
+		mCursor->extentCount = 1;
+	}
+
+	return setAddress(0, cluster);
+}
+
+// 체인의 index 번째 클러스터로 현재 위치를 설정한다.
+// 다음 클러스터가 구간 정보에 있으면 FAT를 읽지 않는다.
+error_t Fat32Cluster::setAddress(uint32_t index, uint32_t cluster)
+{
+	Extent *extent = findExtent(index + 1);
 	uint32_t next;
-	error_t result = error_t::ERROR_NONE;
-	mAddress.sectorIndex = 0;
+	error_t result;
+
+	if(extent)
+		next = extent->cluster + (index + 1 - extent->index);
+	else
+	{
+		result = readFat(cluster);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		next = calculateNextCluster();
+		if(next == 0x0FFFFFF7)
+			return error_t::BAD_SECTOR;
+	}
 
-	if(mAddress.cluster == cluster)
-		goto skip;
+	mCursor->address.cluster = cluster;
+	mCursor->address.next = next;
+	mCursor->address.index = index;
+	addExtent(index, cluster);
 
-	save();
-	mAddress.cluster = cluster;
+	return error_t::ERROR_NONE;
+}
+
+// 체인의 구간 정보에 새로 지나간 클러스터를 추가한다.
+// 앞의 구간과 이어지면 구간을 늘리고 아니면 새 구간을 만든다.
+void Fat32Cluster::addExtent(uint32_t index, uint32_t cluster)
+{
+	Extent *last = &mCursor->extent[mCursor->extentCount - 1];
+
+	if(mCursor->extentStart != mCursor->address.start || index != last->index + last->count)
+		return;
 
-	result = readFat(mAddress.cluster);
+	if(cluster == last->cluster + last->count)
+		last->count++;
+	else if(mCursor->extentCount < FAT32_EXTENT_COUNT)
+	{
+		last++;
+		last->index = index;
+		last->cluster = cluster;
+		last->count = 1;
+		mCursor->extentCount++;
+	}
+}
+
+// 체인의 index 번째 클러스터가 포함된 구간을 찾는다.
+// 반환 : 구간 정보에 없으면 0을 반환한다.
+Fat32Cluster::Extent* Fat32Cluster::findExtent(uint32_t index)
+{
+	uint32_t low = 0, high = mCursor->extentCount, mid;
+
+	if(mCursor->extentStart != mCursor->address.start)
+		return 0;
+
+	while(low < high)
+	{
+		mid = (low + high) / 2;
+		if(mCursor->extent[mid].index + mCursor->extent[mid].count <= index)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	if(low < mCursor->extentCount && mCursor->extent[low].index <= index)
+		return &mCursor->extent[low];
+	else
+		return 0;
+}
+
+error_t Fat32Cluster::moveToSector(uint32_t sector)
+{
+	uint32_t index = sector / mSectorPerCluster, last;
+	Extent *extent;
+	error_t result = error_t::ERROR_NONE;
+
+	if(mCursor->extentStart != mCursor->address.start)
+	{
+		result = moveToStart();
+		if(result != error_t::ERROR_NONE)
+			return result;
+	}
+
+	// 구간 정보에 있으면 바로 이동
+	extent = findExtent(index);
+	if(extent)
+		result = setAddress(index, extent->cluster + (index - extent->index));
+	else
+	{
+		// 구간 정보의 끝과 현재 위치 중 가까운 곳에서부터 체인을 따라감
+		extent = &mCursor->extent[mCursor->extentCount - 1];
+		last = extent->index + extent->count - 1;
+		if(mCursor->address.index < last || mCursor->address.index > index)
+			result = setAddress(last, extent->cluster + extent->count - 1);
+	}
 	if(result != error_t::ERROR_NONE)
 		return result;
 
-skip:
-	next = calculateNextCluster();
-	if(next == 0x0FFFFFF7)
-		return error_t::BAD_SECTOR;
-	
-	mAddress.next = next;
-	return result;
+	while(mCursor->address.index < index)
+	{
+		result = moveToNextCluster();
+		if(result != error_t::ERROR_NONE)
+			return result;
+	}
+
+	mCursor->address.sectorIndex = sector % mSectorPerCluster;
+
+	return error_t::ERROR_NONE;
 }
 
-error_t Fat32Cluster::increaseDataSectorIndex(void)
+uint32_t Fat32Cluster::getContiguousSectorCount(uint32_t max)
 {
-	error_t result = error_t::ERROR_NONE;
+	Extent *extent = findExtent(mCursor->address.index);
+	uint32_t count, cluster;
+
+	if(extent == 0)
+		return mSectorPerCluster - mCursor->address.sectorIndex;
+
+	count = (extent->index + extent->count - mCursor->address.index) * mSectorPerCluster - mCursor->address.sectorIndex;
+
+	// 마지막 구간이면 다음 클러스터가 이어지는 동안 FAT를 미리 읽어 구간을 늘림
+	while(count < max && extent == &mCursor->extent[mCursor->extentCount - 1])
+	{
+		cluster = extent->cluster + extent->count - 1;
+		if(loadFat(cluster / 128) != error_t::ERROR_NONE)
+			break;
+
+		if((mFatTableBuffer[cluster % 128] & 0x0FFFFFFF) != cluster + 1)
+			break;
+
+		addExtent(extent->index + extent->count, cluster + 1);
+		count += mSectorPerCluster;
+	}
+
+	return count;
+}
 
-	mAddress.sectorIndex++;
-	if(mAddress.sectorIndex >= mSectorPerCluster)
+error_t Fat32Cluster::increaseDataSectorIndex(uint32_t count)
+{
+	uint32_t index = mCursor->address.sectorIndex + count;
+	error_t result;
+
+	while(index >= mSectorPerCluster)
 	{
-		mAddress.sectorIndex = 0;
+		index -= mSectorPerCluster;
 		result = moveToNextCluster();
+		if(result != error_t::ERROR_NONE)
+		{
+			mCursor->address.sectorIndex = 0;
+			return result;
+		}
 	}
 
-	return result;
+	mCursor->address.sectorIndex = index;
+
+	return error_t::ERROR_NONE;
 }
 
 error_t Fat32Cluster::setRootCluster(uint32_t cluster)
 {
 	mRoot = cluster;
-	mAddress.start =cluster;
+	mCursor->address.start =cluster;
 	return moveToRoot();
 }
 
 error_t Fat32Cluster::setCluster(uint32_t cluster)
 {
-	mAddress.start =cluster;
+	mCursor->address.start =cluster;
 	return moveToStart();
 }
 
@@ -156,180 +458,489 @@ uint32_t Fat32Cluster::getRootCluster(void)
 
 uint32_t Fat32Cluster::getStartCluster(void)
 {
-	return mAddress.start;
+	return mCursor->address.start;
 }
 
 uint32_t Fat32Cluster::getCurrentCluster(void)
 {
-	return mAddress.cluster;
+	return mCursor->address.cluster;
 }
 
 error_t Fat32Cluster::moveToNextCluster(void)
 {
-	error_t result;
-	uint32_t next;
-
-	if(mAddress.next == 0x0FFFFFF7)
+	if(mCursor->address.next == 0x0FFFFFF7)
 		return error_t::BAD_SECTOR;
-	else if(mAddress.next < 2 || mAddress.next > 0x0FFFFFEF)
+	else if(mCursor->address.next < 2 || mCursor->address.next > 0x0FFFFFEF)
 		return error_t::NO_DATA;
 	
-	result = readFat(mAddress.next);
+	return setAddress(mCursor->address.index + 1, mCursor->address.next);
+}
+
+uint32_t Fat32Cluster::getNextCluster(void)
+{
+	return mCursor->address.next;
+}
+
+error_t Fat32Cluster::save(void)
+{
+	error_t result;
+
+	for(uint32_t i=0;i<FAT32_FAT_CACHE_COUNT;i++)
+	{
+		if(mFatCache[i].dirty)
+		{
+			result = writeFat(&mFatCache[i]);
+			if(result != error_t::ERROR_NONE)
+				return result;
+		}
+	}
+
+	return saveFsInfo();
+}
+
+error_t Fat32Cluster::saveFsInfo(void)
+{
+	FatCache *cache;
+	uint8_t *buffer;
+	error_t result;
+
+	if(!mFsInfoUpdateFlag || mFsInfoSector == 0)
+		return error_t::ERROR_NONE;
+
+	// 가장 오래 사용되지 않은 FAT 캐시를 FSInfo 섹터의 버퍼로 빌려 씀
+	cache = findOldestFat();
+	if(cache->dirty)
+	{
+		result = writeFat(cache);
+		if(result != error_t::ERROR_NONE)
+			return result;
+	}
+
+	cache->table = 0xFFFFFFFF;
+	cache->lastUsed = 0;
+	if(cache == mCurrentFat)
+		mLastReadFatTable = 0xFFFFFFFF;
+
+	buffer = (uint8_t*)cache->buffer;
+	mStorage->lock();
+	result = mStorage->read(mFsInfoSector, buffer);
+	if(result == error_t::ERROR_NONE)
+	{
+		*(uint32_t*)&buffer[0x1E8] = mFreeCount;
+		*(uint32_t*)&buffer[0x1EC] = mNextFree;
+		result = mStorage->write(mFsInfoSector, buffer);
+	}
+	mStorage->unlock();
+
+	if(result == error_t::ERROR_NONE)
+		mFsInfoUpdateFlag = false;
+
+	return result;
+}
+
+error_t Fat32Cluster::append(bool clear)
+{
+	error_t result;
+
+	uint32_t cluster = allocate(clear);
+	if(cluster == 0)
+		return error_t::NO_FREE_DATA;
+	
+	// 현재 클러스터에 새 클러스터를 연결
+	result = setFatEntry(mCursor->address.cluster, cluster);
 	if(result != error_t::ERROR_NONE)
 		return result;
 
-	next = calculateNextCluster();
-	if(next == 0x0FFFFFF7)
-		return error_t::BAD_SECTOR;
-	
-	mAddress.cluster = mAddress.next;
-	mAddress.next = next;
-	return result;
+	// 새 클러스터로 이동
+	return setAddress(mCursor->address.index + 1, cluster);
 }
 
-uint32_t Fat32Cluster::getNextCluster(void)
+uint32_t Fat32Cluster::getSectorSize(void)
 {
-	return mAddress.next;
+	return mSectorSize;
 }
 
-error_t Fat32Cluster::save(void)
+uint32_t Fat32Cluster::getSectorIndex(void)
+{
+	return mCursor->address.index * mSectorPerCluster + mCursor->address.sectorIndex;
+}
+
+uint32_t Fat32Cluster::allocate(bool clear)
+{
+	uint32_t cluster;
+
+	cluster = findFree(mNextFree);
+	if(cluster == 0)
+		return 0;
+
+	// clear 플래그가 세트되어 있을 경우, 새로 할당 받은 클러스터의 데이터를 0으로 초기화
+	if(clear && clearCluster(cluster) != error_t::ERROR_NONE)
+		return 0;
+
+	// 할당 완료
+	// 변경된 FAT 섹터는 캐시에서 교체되거나 save()가 호출될 때 두 FAT에 함께 저장됨
+	if(setFatEntry(cluster, 0x0FFFFFFF) != error_t::ERROR_NONE)
+		return 0;
+
+	return cluster;
+}
+
+error_t Fat32Cluster::clearCluster(uint32_t cluster)
 {
 	error_t result = error_t::ERROR_NONE;
 
-	if(mUpdateFlag)
+	for(int32_t  j=0;j<mSectorPerCluster;j++)
 	{
 		mStorage->lock();
-		mUpdateFlag = false;
-		result = mStorage->write(mFatSector + mLastReadFatTable, mFatTableBuffer);
-		result = mStorage->write(mFatBackupSector + mLastReadFatTable, mFatTableBuffer);
+		for(int32_t  k=0;k<10;k++)
+		{
+			result = mStorage->write(mDataStartSector + (cluster - 2) * mSectorPerCluster + j, (void*)gClearBuffer);
+			if(result == error_t::ERROR_NONE)
+				break;
+		}
 		mStorage->unlock();
+		if(result != error_t::ERROR_NONE)
+			return result;
 	}
 
 	return result;
 }
 
-error_t Fat32Cluster::append(bool clear)
+error_t Fat32Cluster::reserve(uint32_t count, bool clear)
 {
-	(void)clear;
+	uint32_t length = mCursor->address.index + 1, last = mCursor->address.cluster, next = mCursor->address.next, cluster;
+	error_t result;
+
+	// 첫 클러스터가 없는 체인은 이어 붙일 곳이 없으므로 먼저 할당하여 디렉토리 엔트리에 저장해야 함
+	if(last < 2)
+		return error_t::WRONG_INDEX;
+
+	// 체인의 마지막 클러스터와 체인의 길이를 찾음
+	while(next >= 2 && next <= 0x0FFFFFEF)
+	{
+		last = next;
+		length++;
+
+		result = loadFat(last / 128);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		next = mFatTableBuffer[last % 128] & 0x0FFFFFFF;
+	}
+
+	if(length >= count)
+		return error_t::ERROR_NONE;
+	count -= length;
+
+	// 체인의 끝 바로 뒤부터 연속으로 비어 있는 구간을 찾아 하나씩 연결
+	cluster = findFreeRun(last + 1, count);
+	while(true)
+	{
+		if(cluster == 0)
+			return error_t::NO_FREE_DATA;
+
+		if(clear)
+		{
+			result = clearCluster(cluster);
+			if(result != error_t::ERROR_NONE)
+				return result;
+		}
+
+		result = setFatEntry(cluster, 0x0FFFFFFF);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		result = setFatEntry(last, cluster);
+		if(result != error_t::ERROR_NONE)
+			return result;
+
+		if(last == mCursor->address.cluster)
+			mCursor->address.next = cluster;
+		last = cluster;
+
+		if(--count == 0)
+			return error_t::ERROR_NONE;
+
+		if(isFree(last + 1))
+			cluster = last + 1;
+		else
+			cluster = findFree(last + 1);
+	}
+}
 
+error_t Fat32Cluster::truncate(uint32_t count)
+{
+	uint32_t cluster, next;
+	Extent *extent;
 	error_t result;
 
-	uint32_t cluster = allocate();
-	if(cluster == 0)
-		return error_t::NO_FREE_DATA;
-	
-	if(mAddress.cluster / 128 != cluster / 128)
+	if(count == 0)
+		count = 1;
+
+	// 체인이 count보다 짧으면 해제할 클러스터가 없음
+	result = moveToSector((count - 1) * mSectorPerCluster);
+	if(result == error_t::NO_DATA)
+		return error_t::ERROR_NONE;
+	else if(result != error_t::ERROR_NONE)
+		return result;
+
+	next = mCursor->address.next;
+	if(next < 2 || next > 0x0FFFFFEF)
+		return error_t::ERROR_NONE;
+
+	result = setFatEntry(mCursor->address.cluster, 0x0FFFFFFF);
+	if(result != error_t::ERROR_NONE)
+		return result;
+	mCursor->address.next = 0x0FFFFFFF;
+
+	// 남은 체인을 따라가며 해제
+	while(next >= 2 && next <= 0x0FFFFFEF)
 	{
-		result = readFat(mAddress.cluster);
+		cluster = next;
+
+		result = loadFat(cluster / 128);
 		if(result != error_t::ERROR_NONE)
 			return result;
 
-//#error_t "추가된 클러스터 정보를 테이블에 넣고 새 클러스터로 이동해서 마무리 하도록 수정해야 함"
-		mFatTableBuffer[mAddress.tableIndex] = cluster;
-		mUpdateFlag = true;
-		save();
-	
-		mAddress.cluster = cluster;
-		readFat(cluster);
+		next = mFatTableBuffer[cluster % 128] & 0x0FFFFFFF;
+
+		result = setFatEntry(cluster, 0);
+		if(result != error_t::ERROR_NONE)
+			return result;
 	}
-	else
+
+	// 해제된 클러스터를 구간 정보에서 지움
+	while(mCursor->extentCount > 1 && mCursor->extent[mCursor->extentCount - 1].index >= count)
+		mCursor->extentCount--;
+
+	extent = &mCursor->extent[mCursor->extentCount - 1];
+	if(extent->index + extent->count > count)
+		extent->count = count - extent->index;
+
+	return error_t::ERROR_NONE;
+}
+
+// cluster가 포함된 FAT 섹터부터 FAT32_FREE_MAP_SIZE * 8개의 클러스터에 대한 빈 클러스터 비트맵을 만든다.
+error_t Fat32Cluster::buildFreeMap(uint32_t cluster)
+{
+	uint32_t start = cluster & ~0x7F, end = start + FAT32_FREE_MAP_SIZE * 8;
+	error_t result;
+
+	if(end > mClusterCount)
+		end = mClusterCount;
+
+	memset(mFreeMap, 0, sizeof(mFreeMap));
+	mFreeMapCount = 0;
+
+	for(uint32_t i=start;i<end;i++)
 	{
-		mFatTableBuffer[mAddress.tableIndex] = cluster;
-		mAddress.tableIndex = cluster % 128;
-		mAddress.cluster = cluster;
-		mUpdateFlag = true;
+		if((i & 0x7F) == 0)
+		{
+			result = loadFat(i / 128);
+			if(result != error_t::ERROR_NONE)
+				return result;
+		}
+
+		if(i >= 2 && (mFatTableBuffer[i & 0x7F] & 0x0FFFFFFF) == 0)
+			mFreeMap[(i - start) / 32] |= 1 << ((i - start) % 32);
 	}
 
+	mFreeMapStart = start;
+	mFreeMapCount = end - start;
+
 	return error_t::ERROR_NONE;
 }
 
-uint32_t Fat32Cluster::getSectorSize(void)
+bool Fat32Cluster::isFree(uint32_t cluster)
 {
-	return mSectorSize;
+	uint32_t bit;
+
+	if(cluster < 2 || cluster >= mClusterCount)
+		return false;
+
+	if(cluster < mFreeMapStart || cluster >= mFreeMapStart + mFreeMapCount)
+	{
+		if(buildFreeMap(cluster) != error_t::ERROR_NONE)
+			return false;
+	}
+
+	bit = cluster - mFreeMapStart;
+	return (mFreeMap[bit / 32] >> (bit % 32)) & 0x01;
 }
 
-uint32_t Fat32Cluster::allocate(bool clear)
+// cluster부터 빈 클러스터를 찾는다. FAT의 끝에 도달하면 처음부터 다시 찾는다.
+// 반환 : 빈 클러스터가 없으면 0을 반환한다.
+uint32_t Fat32Cluster::findFree(uint32_t cluster)
 {
-	uint32_t fatTable = mLastReadFatTable, cluster;
-	error_t result;
-	bool overFlowFlag = false;
+	uint32_t checked = 0, bit, word, step;
 
-	while(1)
+	if(cluster < 2 || cluster >= mClusterCount)
+		cluster = 2;
+
+	while(checked < mClusterCount + 32)
 	{
-		for(uint32_t i=0;i<128;i++)
+		if(cluster < mFreeMapStart || cluster >= mFreeMapStart + mFreeMapCount)
 		{
-			// 비워진 클러스터인지 확인
-			if((mFatTableBuffer[i] & 0x0FFFFFFF) == 0)
-			{
-				cluster = fatTable * 128 + i;
-				
-				// clear 플래그가 세트되어 있을 경우, 새로 할당 받은 클러스터의 데이터를 0으로 초기화
-				if(clear)
-				{
-					for(int32_t  j=0;j<mSectorPerCluster;j++)
-					{
-						for(int32_t  k=0;k<10;k++)
-						{
-							result = mStorage->write(mDataStartSector + (cluster - 2) * mSectorPerCluster + j, (void*)gClearBuffer);
-							if(result == error_t::ERROR_NONE)
-								break;
-						}
-						if(result != error_t::ERROR_NONE)
-							return 0;
-					}
-				}
-
-				// 할당 완료
-				mFatTableBuffer[i] = 0x0FFFFFFF;
-				mStorage->lock();
-				result = mStorage->write(mFatSector + fatTable, mFatTableBuffer);
-				mStorage->unlock();
-
-				return cluster;
-			}
+			if(buildFreeMap(cluster) != error_t::ERROR_NONE)
+				return 0;
+		}
+
+		bit = cluster - mFreeMapStart;
+		word = mFreeMap[bit / 32] >> (bit % 32);
+		if(word & 0x01)
+			return cluster;
+
+		// 워드에 남은 빈 클러스터가 없으면 다음 워드로 건너 뜀
+		if(word)
+			step = 1;
+		else
+			step = 32 - bit % 32;
+
+		cluster += step;
+		checked += step;
+
+		if(cluster >= mClusterCount)
+			cluster = 2;
+	}
+
+	return 0;
+}
+
+// cluster부터 FAT32_FREE_RUN_SEARCH_SIZE개의 클러스터 안에서 count개의 클러스터가 연속으로 비어 있는 곳을 찾는다.
+// 찾지 못한 범위와 크기를 기억해 두고, 클러스터가 해제되기 전까지 그 범위에서 같은 크기 이상은 다시 찾지 않는다.
+// 반환 : 찾지 못하면 가장 길게 비어 있는 곳의 첫 클러스터를 반환한다.
+uint32_t Fat32Cluster::findFreeRun(uint32_t cluster, uint32_t count)
+{
+	uint32_t start, next, run, best, bestRun = 0, checked = 0, offset, limit = FAT32_FREE_RUN_SEARCH_SIZE;
+
+	if(cluster < 2 || cluster >= mClusterCount)
+		cluster = 2;
+
+	if(mFailedRunCount && count >= mFailedRunCount)
+	{
+		if(cluster >= mFailedRunStart)
+			offset = cluster - mFailedRunStart;
+		else
+			offset = cluster + mClusterCount - mFailedRunStart;
+
+		if(offset < mFailedRunRange)
+			return findFree(cluster);
+	}
+
+	if(limit > mClusterCount)
+		limit = mClusterCount;
+
+	start = findFree(cluster);
+	best = start;
+
+	while(start)
+	{
+		run = 1;
+		while(run < count && isFree(start + run))
+			run++;
+
+		if(run == count)
+			return start;
+
+		if(run > bestRun)
+		{
+			best = start;
+			bestRun = run;
 		}
-		
-		fatTable++;
 
-		// FAT 테이블 끝에 도달해서 다시 시작 했는가?
-		if(overFlowFlag == false) // 아직 FAT 테이블 끝까지 도착 안함
+		next = findFree(start + run);
+		if(next > start)
+			checked += next - start;
+		else
+			checked += next + mClusterCount - start;
+
+		if(next == 0 || checked >= limit)
+			break;
+
+		start = next;
+	}
+
+	mFailedRunStart = cluster;
+	mFailedRunRange = checked;
+	mFailedRunCount = count;
+
+	return best;
+}
+
+// FAT의 항목을 변경한다.
+// 빈 클러스터를 사용하면 비트맵과 FSInfo의 정보도 갱신한다.
+error_t Fat32Cluster::setFatEntry(uint32_t cluster, uint32_t value)
+{
+	uint32_t *entry, bit;
+	error_t result;
+
+	// 0과 1은 예약된 항목이므로 체인에 사용할 수 없음
+	if(cluster < 2 || cluster >= mClusterCount)
+		return error_t::WRONG_INDEX;
+
+	result = loadFat(cluster / 128);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	entry = &mFatTableBuffer[cluster % 128];
+	if((*entry & 0x0FFFFFFF) == 0 && value != 0)
+	{
+		if(cluster >= mFreeMapStart && cluster < mFreeMapStart + mFreeMapCount)
 		{
-			// FAT 테이블의 끝까지 갔는가?
-			if(fatTable >= mFatLength)
-			{
-				overFlowFlag = true;
-				fatTable = 0;
-			}
+			bit = cluster - mFreeMapStart;
+			mFreeMap[bit / 32] &= ~(1 << (bit % 32));
 		}
-		else	// FAT 테이블 끝까지 도착하고 처음부터 다시 시작함
+
+		if(mFreeCount != 0xFFFFFFFF && mFreeCount > 0)
+			mFreeCount--;
+
+		mNextFree = cluster + 1;
+		if(mNextFree >= mClusterCount)
+			mNextFree = 2;
+
+		mFsInfoUpdateFlag = true;
+	}
+	else if((*entry & 0x0FFFFFFF) != 0 && value == 0)
+	{
+		if(cluster >= mFreeMapStart && cluster < mFreeMapStart + mFreeMapCount)
 		{
-			if(fatTable == mLastReadFatTable)
-				return error_t::NO_FREE_DATA;
+			bit = cluster - mFreeMapStart;
+			mFreeMap[bit / 32] |= 1 << (bit % 32);
 		}
-		
-		// 현재 FAT 섹터를 저장
-		result = save();
-		if(result != error_t::ERROR_NONE)
-			return result;
-		
-		// 다음 FAT 섹터를 읽어옴
-		mStorage->lock();
-		result = mStorage->read(mFatSector + fatTable, mFatTableBuffer);
-		mStorage->unlock();
-		
-		if(result != error_t::ERROR_NONE)
-			return result;
 
+		if(mFreeCount != 0xFFFFFFFF)
+			mFreeCount++;
+
+		// 해제된 클러스터로 연속된 구간이 생길 수 있으므로 다시 찾도록 함
+		mFailedRunCount = 0;
+		mFsInfoUpdateFlag = true;
 	}
+
+	*entry = (*entry & 0xF0000000) | (value & 0x0FFFFFFF);
+	mCurrentFat->dirty = true;
+
+	return error_t::ERROR_NONE;
+}
+
+void Fat32Cluster::setCursor(Cursor *cursor)
+{
+	mCursor = cursor ? cursor : &mDefaultCursor;
+}
+
+void Fat32Cluster::clearCursor(Cursor &cursor)
+{
+	memset(&cursor.address, 0, sizeof(Address));
+	cursor.extentStart = 0;
+	cursor.extentCount = 0;
 }
 
 void Fat32Cluster::backup(void)
 {
-	mBackupAddress = mAddress;
+	mBackupAddress = mCursor->address;
 }
 
 void Fat32Cluster::restore(void)
 {
-	mAddress = mBackupAddress;
+	mCursor->address = mBackupAddress;
 }
 
@@ -24,6 +24,8 @@ Fat32DirectoryEntry::Fat32DirectoryEntry(void)
 	mCluster = 0;
 	mSectorSize = 0;
 	mEntryBuffer = 0;
+	mItemPosition = 0;
+	invalidateCache();
 }
 
 void Fat32DirectoryEntry::initialize(Fat32Cluster &cluster, void* sectorBuffer)
@@ -31,6 +33,7 @@ void Fat32DirectoryEntry::initialize(Fat32Cluster &cluster, void* sectorBuffer)
 	mCluster = &cluster;
 	mEntryBuffer = (DirectoryEntry*)sectorBuffer;
 	mSectorSize = cluster.getSectorSize();
+	invalidateCache();
 }
 
 error_t Fat32DirectoryEntry::moveToNext(void)
@@ -72,6 +75,7 @@ error_t Fat32DirectoryEntry::moveToNext(void)
 			if(lfn->order & 0x40)
 			{
 				mLfnCount = lfn->order & 0x3F;
+				mItemPosition = getPosition();
 			}
 			
 			if(mLfnCount)
@@ -89,6 +93,8 @@ error_t Fat32DirectoryEntry::moveToNext(void)
 		}
 		else
 		{
+			if(mLfnCount == 0)
+				mItemPosition = getPosition();
 			return error_t::ERROR_NONE;
 		}
 	}
@@ -408,8 +414,8 @@ uint32_t Fat32DirectoryEntry::getTargetCluster(void)
 
 bool Fat32DirectoryEntry::comapreTargetName(const char *utf8)
 {
-	char *csrc = (char*)utf8;
-	char *utf16;
+	const char *csrc = utf8;
+	char *utf16, c;
 	uint32_t ch;
 
 	// 긴 파일 이름인지 점검
@@ -427,20 +433,21 @@ bool Fat32DirectoryEntry::comapreTargetName(const char *utf8)
 
 			if(ch == 0)
 			{
-				if(*csrc == 0)
+				if(isNameEnd(*csrc))
 					return false;
 				else
 					return true;
 			}
 			else if(ch < 0x80) // 아스키 코드
 			{
-				if('a' <= *csrc && *csrc <= 'z')
-					*csrc &= ~(0x20);
+				c = *csrc++;
+				if('a' <= c && c <= 'z')
+					c &= ~(0x20);
 				
 				if('a' <= ch && ch <= 'z')
 					ch &= ~(0x20);
 
-				if(*csrc++ != (int8_t)ch)
+				if(c != (int8_t)ch)
 					return true;
 			}
 			else // 유니코드
@@ -462,20 +469,21 @@ bool Fat32DirectoryEntry::comapreTargetName(const char *utf8)
 
 			if(ch == 0)
 			{
-				if(*csrc == 0)
+				if(isNameEnd(*csrc))
 					return false;
 				else
 					return true;
 			}
 			else if(ch < 0x80) // 아스키 코드
 			{
-				if('a' <= *csrc && *csrc <= 'z')
-					*csrc &= ~(0x20);
+				c = *csrc++;
+				if('a' <= c && c <= 'z')
+					c &= ~(0x20);
 
 				if('a' <= ch && ch <= 'z')
 					ch &= ~(0x20);
 
-				if(*csrc++ != (int8_t)ch)
+				if(c != (int8_t)ch)
 					return true;
 			}
 			else // 유니코드
@@ -497,20 +505,21 @@ bool Fat32DirectoryEntry::comapreTargetName(const char *utf8)
 
 			if(ch == 0)
 			{
-				if(*csrc == 0)
+				if(isNameEnd(*csrc))
 					return false;
 				else
 					return true;
 			}
 			else if(ch < 0x80) // 아스키 코드
 			{
-				if('a' <= *csrc && *csrc <= 'z')
-					*csrc &= ~(0x20);
+				c = *csrc++;
+				if('a' <= c && c <= 'z')
+					c &= ~(0x20);
 
 				if('a' <= ch && ch <= 'z')
 					ch &= ~(0x20);
 
-				if(*csrc++ != (int8_t)ch)
+				if(c != (int8_t)ch)
 					return true;
 			}
 			else // 유니코드
@@ -524,23 +533,24 @@ bool Fat32DirectoryEntry::comapreTargetName(const char *utf8)
 			}
 		}
 
-		if(*csrc == 0)
+		if(isNameEnd(*csrc))
 			return false;
 	}
 
 extractShortName :
-	csrc = (char*)utf8;
+	csrc = utf8;
 	char *cmp = mEntryBuffer[mIndex].name;
 	
 	// 파일명 검사
-	for(int32_t i = 0; i < 8 && *csrc && *cmp; i++)
+	for(int32_t i = 0; i < 8 && !isNameEnd(*csrc) && *cmp; i++)
 	{
 		// 소문자의 겨우 대문자로 변경
-		if('a' <= *csrc && *csrc <= 'z')
-			*csrc &= ~(0x20);
+		c = *csrc++;
+		if('a' <= c && c <= 'z')
+			c &= ~(0x20);
 		
 		// 같은 문자가 아니면 나가기
-		if(*cmp++ != *csrc++)
+		if(*cmp++ != c)
 			return true;
 		
 		// 확장자 검사로 넘어가기전에 나머지 파일명이 공백인지 확인
@@ -559,20 +569,173 @@ extractShortName :
 	}
 	
 	// 확장자 검사	
-	for(int32_t i = 0; i < 3 && *csrc && *cmp; i++)
+	for(int32_t i = 0; i < 3 && !isNameEnd(*csrc) && *cmp; i++)
 	{
 		// 소문자의 겨우 대문자로 변경
-		if('a' <= *csrc && *csrc <= 'z')
-			*csrc &= ~(0x20);
+		c = *csrc++;
+		if('a' <= c && c <= 'z')
+			c &= ~(0x20);
 		
 		// 같은 문자가 아니면 나가기
-		if(*cmp++ != *csrc++)
+		if(*cmp++ != c)
 			return true;
 	}
 
 	return false;
 }
 
+error_t Fat32DirectoryEntry::moveToName(const char *utf8)
+{
+	uint32_t cluster = mCluster->getStartCluster(), hash = calculateNameHash(utf8);
+	DirectoryCache *cache = &mCache[(hash ^ cluster) % FAT32_DIRECTORY_CACHE_COUNT];
+	error_t result;
+
+	// 캐시에 있으면 기억된 위치로 이동해서 이름을 다시 확인
+	if(cache->cluster == cluster && cache->hash == hash)
+	{
+		result = moveToPosition(cache->position);
+		if(result == error_t::ERROR_NONE && !comapreTargetName(utf8))
+			return error_t::ERROR_NONE;
+
+		cache->cluster = 0;
+	}
+
+	// 처음부터 찾으며 지나가는 항목들을 캐시에 기억
+	result = moveToStart();
+	while(result == error_t::ERROR_NONE)
+	{
+		addCache(cluster);
+		if(!comapreTargetName(utf8))
+			return error_t::ERROR_NONE;
+
+		result = moveToNext();
+	}
+
+	if(result == error_t::INDEX_OVER || result == error_t::NO_DATA)
+		return error_t::NOT_EXIST_NAME;
+	
+	return result;
+}
+
+void Fat32DirectoryEntry::invalidateCache(uint32_t cluster)
+{
+	for(uint32_t i = 0; i < FAT32_DIRECTORY_CACHE_COUNT; i++)
+	{
+		if(cluster == 0 || mCache[i].cluster == cluster)
+			mCache[i].cluster = 0;
+	}
+}
+
+uint32_t Fat32DirectoryEntry::getPosition(void)
+{
+	return mCluster->getSectorIndex() << 4 | mIndex;
+}
+
+// 항목의 첫 엔트리(긴 파일 이름 엔트리 포함)의 위치로 이동해서 항목을 다시 읽는다.
+error_t Fat32DirectoryEntry::moveToPosition(uint32_t position)
+{
+	error_t result;
+
+	result = mCluster->moveToSector(position >> 4);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	result = mCluster->readDataSector(mEntryBuffer);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
+	// moveToNext()에서 증가되므로 하나 앞의 엔트리로 설정
+	mIndex = (position & 0x0F) - 1;
+
+	return moveToNext();
+}
+
+// 대소문자를 구분하지 않는 FNV-1a 해시를 계산한다.
+// comapreTargetName()과 같이 UTF-16을 변환한 UTF-8의 바이트들로 계산한다.
+uint32_t Fat32DirectoryEntry::calculateNameHash(const char *utf8)
+{
+	uint32_t hash = 2166136261;
+	char c;
+
+	while(!isNameEnd(*utf8))
+	{
+		c = *utf8++;
+		if('a' <= c && c <= 'z')
+			c &= ~(0x20);
+
+		hash = (hash ^ (uint8_t)c) * 16777619;
+	}
+
+	return hash;
+}
+
+uint32_t Fat32DirectoryEntry::calculateTargetNameHash(void)
+{
+	uint32_t hash = 2166136261, ch;
+	char *utf16;
+	DirectoryEntry *entry;
+
+	if(mLfnCount)
+	{
+		for(int32_t  j=0;j<mLfnCount;j++)
+		{
+			// name1, name2, name3은 각각 5, 6, 2 글자
+			for(int32_t  i=0;i<13;i++)
+			{
+				if(i < 5)
+					utf16 = &mLfn[j].name1[i * 2];
+				else if(i < 11)
+					utf16 = &mLfn[j].name2[(i - 5) * 2];
+				else
+					utf16 = &mLfn[j].name3[(i - 11) * 2];
+
+				ch = translateUtf16ToUtf8(utf16);
+				if(ch == 0)
+					return hash;
+				else if(ch < 0x80) // 아스키 코드
+				{
+					if('a' <= ch && ch <= 'z')
+						ch &= ~(0x20);
+
+					hash = (hash ^ ch) * 16777619;
+				}
+				else // 유니코드
+				{
+					hash = (hash ^ ((ch >> 16) & 0xFF)) * 16777619;
+					hash = (hash ^ ((ch >> 8) & 0xFF)) * 16777619;
+					hash = (hash ^ (ch & 0xFF)) * 16777619;
+				}
+			}
+		}
+
+		return hash;
+	}
+
+	// 짧은 파일 이름은 공백을 뺀 "이름.확장자"
+	entry = &mEntryBuffer[mIndex];
+	for(int32_t i = 0; i < 8 && entry->name[i] != ' '; i++)
+		hash = (hash ^ (uint8_t)entry->name[i]) * 16777619;
+	
+	if(entry->extention[0] != ' ')
+	{
+		hash = (hash ^ '.') * 16777619;
+		for(int32_t i = 0; i < 3 && entry->extention[i] != ' '; i++)
+			hash = (hash ^ (uint8_t)entry->extention[i]) * 16777619;
+	}
+
+	return hash;
+}
+
+void Fat32DirectoryEntry::addCache(uint32_t cluster)
+{
+	uint32_t hash = calculateTargetNameHash();
+	DirectoryCache *cache = &mCache[(hash ^ cluster) % FAT32_DIRECTORY_CACHE_COUNT];
+
+	cache->cluster = cluster;
+	cache->hash = hash;
+	cache->position = mItemPosition;
+}
+
 int32_t  Fat32DirectoryEntry::strlen(const char *src)
 {
 	int32_t  count = 0;
@@ -675,6 +838,16 @@ error_t Fat32DirectoryEntry::prepareInsert(uint32_t &cluster, DirectoryEntry &sf
 	uint8_t checksum;
 	int32_t  lfnLen = (len + 11) / 12;
 
+	// 항목이 추가되는 디렉토리의 캐시를 지움
+	invalidateCache(mCluster->getStartCluster());
+
+	// 디렉토리에서 사용되지 않는 짧은 이름을 정함
+	// 디렉토리를 끝까지 읽으므로 현재 엔트리는 디렉토리의 마지막이 된다.
+	setShortName(sfn.name, name);
+	result = selectShortNameTail(sfn.name);
+	if(result != error_t::ERROR_NONE)
+		return result;
+
 #if defined(SD_DEBUG)
 	debug_printf("call %d\n", __LINE__);
 #endif
@@ -728,7 +901,6 @@ error_t Fat32DirectoryEntry::prepareInsert(uint32_t &cluster, DirectoryEntry &sf
 	debug_printf("call %d\n", __LINE__);
 #endif
 
-	setShortName(sfn.name, name);
 	sfn.attr = attribute;
 	sfn.extention[0] = sfn.extention[1] = sfn.extention[2] = ' ';
 	sfn.startingClusterLow = cluster & 0xFFFF;
@@ -746,7 +918,7 @@ error_t Fat32DirectoryEntry::prepareInsert(uint32_t &cluster, DirectoryEntry &sf
 		mLfn[i].order = lfnLen - i;
 		mLfn[i].type = 0;
 		mLfn[i].checksum = checksum;
-		*(uint16_t*)&mLfn[0].zero = 0;
+		*(uint16_t*)&mLfn[i].zero = 0;
 	}
 	mLfn[0].order |= 0x40;
 
@@ -764,7 +936,7 @@ error_t Fat32DirectoryEntry::makeDirectory(const char *name)
 	debug_printf("enter\n");
 #endif
 
-	DirectoryEntry *entry, sfn, parent;
+	DirectoryEntry *entry, sfn;
 	error_t result;
 	uint32_t  len = strlen(name), tmp;
 	int32_t  lfnLen = (len + 11) / 12;
@@ -780,8 +952,6 @@ error_t Fat32DirectoryEntry::makeDirectory(const char *name)
 #if defined(SD_DEBUG)
 	debug_printf("call %d\n", __LINE__);
 #endif
-	parent = getCurrentDirectoryEntry();
-	
 	// 생성된 디렉토리 내의 '.', '..' 폴더 기입용 메모리 할당
 	sectorBuffer = new uint8_t[512];
 	if(sectorBuffer == 0)
@@ -806,7 +976,7 @@ error_t Fat32DirectoryEntry::makeDirectory(const char *name)
 
 	// '..' 폴더 설정
 	entry = (DirectoryEntry*)&sectorBuffer[sizeof(DirectoryEntry)];
-	*entry = parent;
+	*entry = sfn;
 #if defined(SD_DEBUG)
 	debug_printf("call %d\n", __LINE__);
 #endif
@@ -922,42 +1092,67 @@ error_t Fat32DirectoryEntry::makeFile(const char *name)
 	return result;
 }
 
+// 짧은 파일 이름은 긴 파일 이름의 앞 두 글자, 이름의 해시 4자리, "~1"로 만든다. (예 : "DA3F1C~1")
+// 디렉토리를 다시 읽지 않고도 같은 디렉토리의 짧은 이름이 겹치지 않도록 해시를 사용한다.
 void Fat32DirectoryEntry::setShortName(void *des, const char *src)
 {
-	int8_t *cdes = (int8_t*)des;
-	uint8_t len = 8;
-	uint16_t utf16;
+	const char *hex = "0123456789ABCDEF";
+	char *cdes = (char*)des, c;
+	uint32_t hash = calculateNameHash(src);
+	uint8_t len = 0;
 
-	while(*src)
+	hash ^= hash >> 16;
+
+	// 짧은 이름에 사용 가능한 아스키 문자만 사용
+	while(*src && len < 2)
 	{
-		if(*src <= 0x7F) // 아스키 코드
-		{
-			if(*src >= 'a' && *src <= 'z')
-				*cdes++ = *src++ - 0x20;
-			else
-				*cdes++ = *src++;
-			
-			src++;
-			len--;
-		}
-		else
-		{
-			utf16 = translateUtf8ToUtf16(src);
-			*cdes++ = utf16 >> 8;
-			*cdes++ = utf16;
-			src += 3;
-			len -= 2;
-		}
+		c = *src++;
+		if('a' <= c && c <= 'z')
+			c &= ~(0x20);
+
+		if(('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '_' || c == '-')
+			cdes[len++] = c;
+	}
+
+	while(len < 2)
+		cdes[len++] = '_';
+
+	for(int32_t i = 12; i >= 0; i -= 4)
+		cdes[len++] = hex[(hash >> i) & 0x0F];
+
+	cdes[6] = '~';
+	cdes[7] = '1';
+}
+
+error_t Fat32DirectoryEntry::selectShortNameTail(char *name)
+{
+	error_t result;
+	DirectoryEntry *entry;
+	uint16_t used = 0;
+
+	result = moveToStart();
+	while(result == error_t::ERROR_NONE)
+	{
+		entry = &mEntryBuffer[mIndex];
+		if(memcmp(entry->name, name, 6) == 0 && entry->name[6] == '~' && '1' <= entry->name[7] && entry->name[7] <= '9')
+			used |= 1 << (entry->name[7] - '0');
+
+		result = moveToNext();
+	}
+
+	if(result != error_t::INDEX_OVER && result != error_t::NO_DATA)
+		return result;
 
-		if(len <= 3)
+	for(uint8_t i = 1; i <= 9; i++)
+	{
+		if((used & (1 << i)) == 0)
 		{
-			*cdes++ = '~';
-			*cdes++ = '1';
-			return;
+			name[7] = '0' + i;
+			return error_t::ERROR_NONE;
 		}
 	}
 
-	*cdes = 0;
+	return error_t::SAME_FILE_NAME_EXIST;
 }
 
 // 함수 코드의 출처
@@ -1076,3 +1271,65 @@ error_t Fat32DirectoryEntry::saveEntry(void)
 	return mCluster->writeDataSector(mEntryBuffer);
 }
 
+uint32_t Fat32DirectoryEntry::getTargetPosition(void)
+{
+	return getPosition();
+}
+
+error_t Fat32DirectoryEntry::saveFileSize(uint32_t cluster, uint32_t position, uint32_t size)
+{
+	error_t result;
+
+	mCluster->backup();
+
+	result = mCluster->setCluster(cluster);
+	if(result == error_t::ERROR_NONE)
+		result = mCluster->moveToSector(position >> 4);
+	if(result == error_t::ERROR_NONE)
+		result = mCluster->readDataSector(mEntryBuffer);
+	if(result == error_t::ERROR_NONE)
+	{
+		mEntryBuffer[position & 0x0F].fileSize = size;
+		result = mCluster->writeDataSector(mEntryBuffer);
+	}
+
+	// 원래의 위치로 돌아가 엔트리 버퍼를 다시 읽음
+	mCluster->restore();
+	if(result == error_t::ERROR_NONE)
+		result = mCluster->readDataSector(mEntryBuffer);
+	else
+		mCluster->readDataSector(mEntryBuffer);
+
+	return result;
+}
+
+error_t Fat32DirectoryEntry::saveFileCluster(uint32_t cluster, uint32_t position, uint32_t fileCluster)
+{
+	DirectoryEntry *entry;
+	error_t result;
+
+	mCluster->backup();
+
+	result = mCluster->setCluster(cluster);
+	if(result == error_t::ERROR_NONE)
+		result = mCluster->moveToSector(position >> 4);
+	if(result == error_t::ERROR_NONE)
+		result = mCluster->readDataSector(mEntryBuffer);
+	if(result == error_t::ERROR_NONE)
+	{
+		entry = &mEntryBuffer[position & 0x0F];
+		entry->startingClusterLow = fileCluster & 0xFFFF;
+		entry->startingClusterHigh = (fileCluster >> 16) & 0xFFFF;
+		result = mCluster->writeDataSector(mEntryBuffer);
+	}
+
+	// 원래의 위치로 돌아가 엔트리 버퍼를 다시 읽음
+	mCluster->restore();
+	if(result == error_t::ERROR_NONE)
+		result = mCluster->readDataSector(mEntryBuffer);
+	else
+		mCluster->readDataSector(mEntryBuffer);
+
+	return result;
+}
+
@@ -12,20 +12,36 @@ File::File(FileSystem &fileSystem)
 {
 	mFileSystem = &fileSystem;
 	mOpenFlag = false;
-	mBuffer = (uint8_t*)mFileSystem->getSectorBuffer();
+	mBuffer = 0;
+	mHandle = -1;
 	mFileSize = 0;
 	mOpenMode = READ_ONLY;
 	mBufferCount = 0;
+	mReserveSize = FILE_LOG_RESERVE_SIZE;
+	mSyncSize = FILE_LOG_SYNC_SIZE;
+	mReservedSize = 0;
+	mSyncedSize = 0;
 }
 
 File::File(FileSystem *fileSystem)
 {
 	mFileSystem = fileSystem;
 	mOpenFlag = false;
-	mBuffer = (uint8_t*)mFileSystem->getSectorBuffer();
+	mBuffer = 0;
+	mHandle = -1;
 	mFileSize = 0;
 	mOpenMode = READ_ONLY;
 	mBufferCount = 0;
+	mReserveSize = FILE_LOG_RESERVE_SIZE;
+	mSyncSize = FILE_LOG_SYNC_SIZE;
+	mReservedSize = 0;
+	mSyncedSize = 0;
+}
+
+File::~File(void)
+{
+	if(mOpenFlag)
+		close();
 }
 
 // 새로운 SD 메모리가 장착되면 init()을 먼저 호출해줘야 한다.
@@ -61,20 +77,20 @@ error_t File::open(const char *fileName, uint8_t mode)
 		mFileSize = 0;
 		break;
 	case READ_ONLY :
+	case APPEND_LOG :
 		break;
 	default :
 		return error_t::UNSUPPORTED_MODE;
 	} 
 
-	const char *src = fileName;
+	const char *src = fileName, *next;
 	mOpenMode = mode;
 
 	if(checkFileName(fileName) == false)
 		return error_t::WRONG_FILE_NAME;
 
 	error_t result;
-	thread::protect();
-	char *name = new char[256];
+	mFileSystem->lock();
 	
 	if(*src == '/')
 	{
@@ -84,23 +100,28 @@ error_t File::open(const char *fileName, uint8_t mode)
 
 	while(*src != 0)
 	{
-		if(bringOneName(name, &src))
+		// 이름은 '/'나 0에서 끝나므로 경로에서 바로 찾음
+		next = strchr(src, '/');
+		if(next)
 		{
-			result = enterDirectory(name);
-			if(result == error_t::INDEX_OVER)
+			if(next != src)
 			{
-				return error_t::WRONG_DIRECTORY_NAME;
-			}
-			else if(result != error_t::ERROR_NONE)
-			{
-				goto error_handler;
+				result = enterDirectory(src);
+				if(result == error_t::NOT_EXIST_NAME)
+				{
+					result = error_t::WRONG_DIRECTORY_NAME;
+					goto error_handler;
+				}
+				else if(result != error_t::ERROR_NONE)
+				{
+					goto error_handler;
+				}
 			}
-			if(*src != '/')
-				break;
+			src = next;
 		}
 		else
 		{
-			result = findFile(name);
+			result = findFile(src);
 			
 			switch(mOpenMode)
 			{
@@ -116,6 +137,7 @@ error_t File::open(const char *fileName, uint8_t mode)
 				break;
 
 			case WRITE_ONLY :
+			case APPEND_LOG :
 				if(result == error_t::ERROR_NONE)
 				{
 					result = mFileSystem->open();
@@ -124,11 +146,11 @@ error_t File::open(const char *fileName, uint8_t mode)
 				}
 				else if(result == error_t::NOT_EXIST_NAME)
 				{
-					result = mFileSystem->makeFile(name);
+					result = mFileSystem->makeFile(src);
 					if(result != error_t::ERROR_NONE)
 						goto error_handler;
 
-					result = findFile(name);
+					result = findFile(src);
 					if(result != error_t::ERROR_NONE)
 						goto error_handler;
 
@@ -141,6 +163,26 @@ error_t File::open(const char *fileName, uint8_t mode)
 
 				
 			}
+
+			// 열린 파일의 핸들과 섹터 버퍼를 받음
+			if(mOpenFlag)
+			{
+				mHandle = mFileSystem->getHandle();
+				mBuffer = (uint8_t*)mFileSystem->getHandleBuffer();
+
+				if(mOpenMode == APPEND_LOG)
+				{
+					result = openLog();
+					if(result != error_t::ERROR_NONE)
+					{
+						// openLog()가 이미 예약한 클러스터를 파일 크기까지 되돌림
+						mFileSystem->close(mFileSize);
+						mOpenFlag = false;
+						mHandle = -1;
+						mBuffer = 0;
+					}
+				}
+			}
 			
 			// 정상 종료지만 코드 재활용을 위해 error_handler 호출
 			goto error_handler;
@@ -152,7 +194,7 @@ error_t File::open(const char *fileName, uint8_t mode)
 	result = error_t::INDEX_OVER;
 
 error_handler:
-	thread::unprotect();
+	mFileSystem->unlock();
 	return result;
 }
 
@@ -166,7 +208,13 @@ error_handler:
 //		디렉토리에 할당된 clsuter 번호를 지정한다.
 error_t File::setPath(uint32_t cluster)
 {
-	return mFileSystem->moveToCluster(cluster);
+	error_t result;
+
+	mFileSystem->lock();
+	result = mFileSystem->moveToCluster(cluster);
+	mFileSystem->unlock();
+
+	return result;
 }
 
 bool File::checkFileName(const char *fileName)
@@ -191,17 +239,7 @@ bool File::checkFileName(const char *fileName)
 	return true;
 }
 
-bool File::bringOneName(char *des, const char **src)
-{
-	while(**src != 0 && **src != '/')
-	{
-		*des++ = *(*src)++;
-	}
-	
-	*des++ = 0;
-	return *(*src) == '/';
-}
-
+// 이름은 '/'나 0에서 끝난다.
 error_t File::enterDirectory(const char *name)
 {
 	error_t result;
@@ -209,66 +247,46 @@ error_t File::enterDirectory(const char *name)
 	if(mOpenFlag)
 		return error_t::BUSY;
 
-	result = mFileSystem->moveToStart();
+	result = mFileSystem->moveToName(name);
 	if(result != error_t::ERROR_NONE)
 		return result;
 	
 	if(mFileSystem->isDirectory() == false)
-		result = mFileSystem->moveToNextDirectory();
-	if(result != error_t::ERROR_NONE)
-		return result;
-
-	while(1)
-	{
-		if(mFileSystem->compareName(name) == false)
-		{
-			result = mFileSystem->enterDirectory();
-			if(result != error_t::ERROR_NONE)
-				return result;
-
-			return error_t::ERROR_NONE;
-		}
+		return error_t::NOT_EXIST_NAME;
 
-		result = mFileSystem->moveToNextDirectory();
-		if(result != error_t::ERROR_NONE)
-			return result;
-	}
-	
-	return error_t::NOT_EXIST_NAME;
+	return mFileSystem->enterDirectory();
 }
 
 error_t File::findFile(const char *name)
 {
 	error_t result;
 
-	result = mFileSystem->moveToStart();
+	result = mFileSystem->moveToName(name);
 	if(result != error_t::ERROR_NONE)
 		return result;
 	
 	if(mFileSystem->isFile() == false)
-		result = mFileSystem->moveToNextFile();
-	if(result == error_t::INDEX_OVER)
 		return error_t::NOT_EXIST_NAME;
-	else if(result != error_t::ERROR_NONE)
-		return result;
 
-	while(1)
-	{
-		if(mFileSystem->compareName(name) == false)
-			return error_t::ERROR_NONE;
+	return error_t::ERROR_NONE;
+}
 
-		result = mFileSystem->moveToNextFile();
-		if(result == error_t::INDEX_OVER)
-			return error_t::NOT_EXIST_NAME;
-		else if(result != error_t::ERROR_NONE)
-			return result;
-	}
-	
-	return error_t::NOT_EXIST_NAME;
+// 파일 시스템을 잠그고 이 파일의 핸들을 선택한다.
+void File::lock(void)
+{
+	mFileSystem->lock();
+	mFileSystem->selectHandle(mHandle);
+}
+
+void File::unlock(void)
+{
+	mFileSystem->unlock();
 }
 
 uint32_t File::read(void *des, uint32_t size)
 {
+	uint32_t len;
+
 	if(!mOpenFlag)
 		return 0;
 	
@@ -280,8 +298,17 @@ uint32_t File::read(void *des, uint32_t size)
 		return 0;
 	}
 
+	lock();
+	len = readData(des, size);
+	unlock();
+
+	return len;
+}
+
+uint32_t File::readData(void *des, uint32_t size)
+{
 	int8_t *src, *cDes = (int8_t*)des;
-	uint32_t tmp, len = 0;
+	uint32_t tmp, count, len = 0;
 	error_t result;
 
 	while(size)
@@ -308,26 +335,28 @@ uint32_t File::read(void *des, uint32_t size)
 			cDes += tmp;
 		}
 		
+		if(size == 0)
+			return len;
+
 		if(size >= 512)
 		{
-			result = mFileSystem->read(cDes);
-			cDes += 512;
-			size -= 512;
-			len += 512;
-		}
-		else
-		{
-			result = mFileSystem->read(mBuffer);
-			mBufferCount = 512;
-		}
+			// 섹터 단위의 영역은 버퍼를 거치지 않고 사용자의 메모리로 바로 읽음
+			count = size / 512;
+			tmp = mFileSystem->read(cDes, count) * 512;
+			cDes += tmp;
+			size -= tmp;
+			len += tmp;
 
-		if(size == 0 || result == error_t::INDEX_OVER)
-			return len;
+			if(tmp < count * 512)
+				return len;
+			continue;
+		}
 
-		if(result == error_t::NO_DATA)
-			;
-		else if(result != error_t::ERROR_NONE)
+		// 읽지 못한 버퍼의 내용을 다음에 돌려주지 않도록 읽은 뒤에 개수를 설정
+		result = mFileSystem->read(mBuffer);
+		if(result != error_t::ERROR_NONE && result != error_t::NO_DATA)
 			return len;
+		mBufferCount = 512;
 	}
 	
 	return len;
@@ -335,23 +364,53 @@ uint32_t File::read(void *des, uint32_t size)
 
 uint32_t File::write(void *src, uint32_t size)
 {
+	uint32_t len;
+
 	if(!mOpenFlag)
 		return 0;
 	
 	switch(mOpenMode)
 	{
 	case WRITE_ONLY :
+		lock();
+		len = writeData(src, size);
+		unlock();
+		break;
+	case APPEND_LOG :
+		lock();
+		len = writeLog(src, size);
+		unlock();
 		break;
 	default :
 		return 0;
 	}
 
+	return len;
+}
+
+uint32_t File::writeData(void *src, uint32_t size)
+{
 	int8_t *des, *cSrc = (int8_t*)src;
-	uint32_t tmp, len = 0;
+	uint32_t tmp, count, len = 0;
 	error_t result;
 
 	while(size)
 	{
+		// 버퍼가 비어 있으면 섹터 단위의 영역은 버퍼를 거치지 않고 사용자의 메모리에서 바로 씀
+		if(mBufferCount == 0 && size >= 512)
+		{
+			count = size / 512;
+			tmp = mFileSystem->write(cSrc, count) * 512;
+			if(tmp < count * 512)
+				return 0;
+
+			len += tmp;
+			cSrc += tmp;
+			size -= tmp;
+			mFileSize += tmp;
+			continue;
+		}
+
 		des = (int8_t*)&mBuffer[mBufferCount];
 
 		if(size >= (512-mBufferCount))
@@ -384,6 +443,112 @@ uint32_t File::write(void *src, uint32_t size)
 	return len;
 }
 
+// 미리 할당한 영역을 넘어서면 다음 영역을 할당하고 저장 간격마다 섹터 단위까지의 크기를 저장한다.
+// 버퍼에 남은 데이터는 저장되지 않았으므로 크기에 포함하지 않는다.
+uint32_t File::writeLog(void *src, uint32_t size)
+{
+	uint32_t len;
+
+	if(mFileSize + size > mReservedSize)
+	{
+		if(mFileSystem->reserve(mFileSize + size + mReserveSize, true) != error_t::ERROR_NONE)
+			return 0;
+		mReservedSize = mFileSize + size + mReserveSize;
+	}
+
+	len = writeData(src, size);
+	if(len < size)
+		return len;
+
+	if(mFileSize - mBufferCount >= mSyncedSize + mSyncSize)
+	{
+		if(mFileSystem->sync(mFileSize - mBufferCount) != error_t::ERROR_NONE)
+			return 0;
+		mSyncedSize = mFileSize - mBufferCount;
+	}
+
+	return len;
+}
+
+// 버퍼에서 데이터가 없는 뒷부분을 0으로 지운다.
+// 섹터의 일부만 쓸 때 이전에 버퍼를 거친 데이터가 파일 끝 뒤에 남으면 openLog()가 파일의 일부로 복구하게 된다.
+void File::clearBufferTail(void)
+{
+	memset(&mBuffer[mBufferCount], 0, 512 - mBufferCount);
+}
+
+// APPEND_LOG 모드로 열린 파일의 실제 크기를 찾고 파일의 끝으로 이동한다.
+// 저장된 크기 뒤의 영역은 미리 할당할 때 0으로 지워지므로 0이 아닌 마지막 바이트까지를 파일로 본다.
+error_t File::openLog(void)
+{
+	uint32_t sector, offset, size;
+	int32_t i;
+	error_t result;
+
+	mFileSize = mFileSystem->getFileSize();
+	mSyncedSize = mFileSize;
+	sector = mFileSize / 512;
+	offset = mFileSize % 512;
+	size = mFileSize;
+
+	// 저장된 크기가 체인의 끝이면 뒤에 복구할 데이터가 없음
+	if(mFileSystem->moveToSector(sector) == error_t::ERROR_NONE)
+	{
+		while(true)
+		{
+			result = mFileSystem->read(mBuffer);
+			if(result != error_t::ERROR_NONE && result != error_t::NO_DATA)
+				return result;
+
+			for(i = 511; i >= (int32_t)offset; i--)
+			{
+				if(mBuffer[i])
+					break;
+			}
+
+			if(i >= (int32_t)offset)
+				size = sector * 512 + i + 1;
+
+			// 섹터의 끝까지 쓰여 있지 않거나 체인의 끝이면 탐색 종료
+			if(i < 511 || result == error_t::NO_DATA)
+				break;
+
+			sector++;
+			offset = 0;
+		}
+	}
+	mFileSize = size;
+
+	result = mFileSystem->reserve(mFileSize + mReserveSize, true);
+	if(result != error_t::ERROR_NONE)
+		return result;
+	mReservedSize = mFileSize + mReserveSize;
+
+	// 마지막 섹터에 쓰여 있는 데이터를 버퍼로 읽고 다시 그 섹터에 쓰도록 되돌아감
+	result = mFileSystem->moveToSector(mFileSize / 512);
+	mBufferCount = mFileSize % 512;
+	if(result == error_t::ERROR_NONE && mBufferCount)
+	{
+		result = mFileSystem->read(mBuffer);
+		if(result == error_t::ERROR_NONE || result == error_t::NO_DATA)
+			result = mFileSystem->moveToSector(mFileSize / 512);
+	}
+	if(result != error_t::ERROR_NONE)
+		return result;
+	clearBufferTail();
+
+	// 복구한 크기를 바로 저장
+	if(mFileSize != mSyncedSize)
+	{
+		result = mFileSystem->sync(mFileSize);
+		if(result != error_t::ERROR_NONE)
+			return result;
+		mSyncedSize = mFileSize;
+	}
+
+	return error_t::ERROR_NONE;
+}
+
 uint32_t File::getSize(void)
 {
 	if(!mOpenFlag)
@@ -399,7 +564,9 @@ error_t File::moveToStart(void)
 	if(!mOpenFlag)
 		return error_t::FILE_NOT_OPENED;
 	
+	lock();
 	result = mFileSystem->moveToFileStart();
+	unlock();
 	mBufferCount = 0;
 
 	return result;
@@ -407,20 +574,16 @@ error_t File::moveToStart(void)
 
 error_t File::moveToEnd(void)
 {
-	uint32_t movingSector = mFileSize / 512;
 	error_t result;
 
 	if(!mOpenFlag)
 		return error_t::FILE_NOT_OPENED;
 
-	moveToStart();
-	
-	for(uint32_t i=0;i<movingSector;i++)
-	{
-		result = mFileSystem->moveToNextSector();
-		if(result != error_t::ERROR_NONE)
-			return result;
-	}
+	lock();
+	result = mFileSystem->moveToSector(mFileSize / 512);
+	unlock();
+	if(result != error_t::ERROR_NONE)
+		return result;
 
 	mBufferCount = mFileSize % 512;
 
@@ -430,7 +593,6 @@ error_t File::moveToEnd(void)
 error_t File::moveTo(uint32_t position)
 {
 	error_t result;
-	uint32_t movingSector;
 
 	if(!mOpenFlag)
 		return error_t::FILE_NOT_OPENED;
@@ -438,18 +600,14 @@ error_t File::moveTo(uint32_t position)
 	if(position > mFileSize)
 		return moveToEnd();
 	
-	movingSector = position / 512;
-
-	moveToStart();
-	
-	for(uint32_t i=0;i<movingSector;i++)
-	{
-		result = mFileSystem->moveToNextSector();
-		if(result != error_t::ERROR_NONE)
-			return result;
-	}
+	lock();
+	result = mFileSystem->moveToSector(position / 512);
+	if(result == error_t::ERROR_NONE)
+		result = mFileSystem->read(mBuffer);
+	unlock();
+	if(result != error_t::ERROR_NONE && result != error_t::NO_DATA)
+		return result;
 
-	result = mFileSystem->read(mBuffer);
 	mBufferCount = 512 - position % 512;
 
 	return error_t::ERROR_NONE;
@@ -462,15 +620,68 @@ error_t File::makeFile(const char *fileName)
 	if(mOpenFlag)
 		return error_t::BUSY;
 
+	mFileSystem->lock();
 	result = findFile(fileName);
 	if(result == error_t::NOT_EXIST_NAME)
-	{
 		result = mFileSystem->makeFile(fileName);
-		if(result != error_t::ERROR_NONE)
-			return result;
+	else
+		result = error_t::ERROR_NONE;
+	mFileSystem->unlock();
+
+	return result;
+}
+
+error_t File::reserve(uint32_t size)
+{
+	error_t result;
+
+	if(!mOpenFlag)
+		return error_t::FILE_NOT_OPENED;
+
+	if(mOpenMode != WRITE_ONLY)
+		return error_t::UNSUPPORTED_MODE;
+
+	lock();
+	result = mFileSystem->reserve(size);
+	unlock();
+
+	return result;
+}
+
+void File::setLogOption(uint32_t reserveSize, uint32_t syncSize)
+{
+	mReserveSize = reserveSize;
+	mSyncSize = syncSize;
+}
+
+error_t File::sync(void)
+{
+	error_t result = error_t::ERROR_NONE;
+
+	if(!mOpenFlag)
+		return error_t::FILE_NOT_OPENED;
+
+	if(mOpenMode != APPEND_LOG)
+		return error_t::UNSUPPORTED_MODE;
+
+	lock();
+	// 버퍼에 남은 데이터도 저장하고 다음 쓰기에서 같은 섹터를 다시 쓰도록 되돌아감
+	if(mBufferCount)
+	{
+		clearBufferTail();
+		result = mFileSystem->write(mBuffer);
+		if(result == error_t::ERROR_NONE)
+			result = mFileSystem->moveToSector(mFileSize / 512);
 	}
 
-	return error_t::ERROR_NONE;
+	if(result == error_t::ERROR_NONE)
+		result = mFileSystem->sync(mFileSize);
+	unlock();
+
+	if(result == error_t::ERROR_NONE)
+		mSyncedSize = mFileSize;
+
+	return result;
 }
 
 error_t File::close(void)
@@ -478,29 +689,39 @@ error_t File::close(void)
 	if(!mOpenFlag)
 		return error_t::FILE_NOT_OPENED;
 
-	error_t result;
+	error_t result = error_t::ERROR_NONE;
 	mOpenFlag = false;
 
+	lock();
 	switch(mOpenMode)
 	{
 	case WRITE_ONLY :
+	case APPEND_LOG :
 		if(mBufferCount)
 		{
+			clearBufferTail();
 			result = mFileSystem->write(mBuffer);
-			if(result != error_t::ERROR_NONE)
-				return result;
 			mBufferCount = 0;
-			result = mFileSystem->close(mFileSize);
-			if(result != error_t::ERROR_NONE)
-				return result;
 		}
+
+		// 파일 크기를 저장하고 변경된 FAT를 저장 장치에 저장
+		// 남은 데이터를 쓰지 못했어도 핸들은 반환해야 하므로 close()는 호출
+		if(result == error_t::ERROR_NONE)
+			result = mFileSystem->close(mFileSize);
+		else
+			mFileSystem->close(mFileSize);
 		break;
 	case READ_ONLY :
 		mFileSystem->close();
 		break;
 	default :
-		return error_t::UNSUPPORTED_MODE;
+		result = error_t::UNSUPPORTED_MODE;
+		break;
 	}
+	unlock();
 
-	return error_t::ERROR_NONE;
+	mHandle = -1;
+	mBuffer = 0;
+
+	return result;
 }
@@ -6,35 +6,141 @@
  */
 
 #include <yss/PointerEvent.h>
+#include <yss/event.h>
 
-PointerEvent::PointerEvent(uint32_t bufferSize) : mFifo(bufferSize * sizeof(PointerEvent::PointerEventData))
+PointerEvent::PointerEvent(uint32_t bufferSize)
 {
-	
+	mSize = bufferSize;
+	mData = new PointerEventData[bufferSize];
+	mHead = 0;
+	mTail = 0;
+	mCount = 0;
+	mDroppedCount = 0;
+	mCoalescedCount = 0;
+}
+
+PointerEvent::~PointerEvent(void)
+{
+	delete[] mData;
 }
 
 void PointerEvent::push(PointerEventData &data)
 {
+	PointerEventData *last;
+
 	mMutex.lock();
-	mFifo.push(&data, sizeof(data));
+
+	// 마지막 이벤트도 끌기이면 좌표만 갱신
+	if(data.event == event::TOUCH_DRAG && mCount)
+	{
+		last = &mData[(mHead + mSize - 1) % mSize];
+		if(last->event == event::TOUCH_DRAG)
+		{
+			last->x = data.x;
+			last->y = data.y;
+			mCoalescedCount++;
+			mMutex.unlock();
+			return;
+		}
+	}
+
+	if(mCount >= mSize)
+	{
+		// 누름과 뗌 이벤트는 보관된 끌기 이벤트를 버리고 넣음
+		if(data.event == event::TOUCH_DRAG || !removeLastDrag())
+		{
+			mDroppedCount++;
+			mMutex.unlock();
+			return;
+		}
+		mDroppedCount++;
+	}
+
+	mData[mHead] = data;
+	mHead = (mHead + 1) % mSize;
+	mCount++;
+
 	mMutex.unlock();
 }
 
+bool PointerEvent::removeLastDrag(void)
+{
+	uint32_t index = mHead, next;
+
+	for(uint32_t i = 0; i < mCount; i++)
+	{
+		index = (index + mSize - 1) % mSize;
+		if(mData[index].event == event::TOUCH_DRAG)
+		{
+			// 뒤의 이벤트들을 한 칸씩 앞으로 당김
+			next = (index + 1) % mSize;
+			while(next != mHead)
+			{
+				mData[index] = mData[next];
+				index = next;
+				next = (next + 1) % mSize;
+			}
+			mHead = index;
+			mCount--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 uint32_t PointerEvent::getMessageCount(void)
 {
-	return mFifo.getStoredSize() / sizeof(PointerEventData);
+	return mCount;
 }
 
 PointerEvent::PointerEventData PointerEvent::pop(void)
 {
-	PointerEventData data;
+	PointerEventData data = {0, 0, event::TOUCH_UP};
+
 	mMutex.lock();
-	mFifo.pop(&data, sizeof(data));
+	if(mCount)
+	{
+		data = mData[mTail];
+		mTail = (mTail + 1) % mSize;
+		mCount--;
+	}
 	mMutex.unlock();
+
 	return data;
 }
 
+bool PointerEvent::popDrag(PointerEventData &data)
+{
+	bool rt = false;
+
+	mMutex.lock();
+	if(mCount && mData[mTail].event == event::TOUCH_DRAG)
+	{
+		data = mData[mTail];
+		mTail = (mTail + 1) % mSize;
+		mCount--;
+		mCoalescedCount++;
+		rt = true;
+	}
+	mMutex.unlock();
+
+	return rt;
+}
+
 void PointerEvent::flush(void)
 {
-	mFifo.flush();
+	mMutex.lock();
+	mHead = mTail = mCount = 0;
+	mMutex.unlock();
 }
 
+uint32_t PointerEvent::getDroppedCount(void)
+{
+	return mDroppedCount;
+}
+
+uint32_t PointerEvent::getCoalescedCount(void)
+{
+	return mCoalescedCount;
+}
@@ -8,18 +8,26 @@
 #include <config.h>
 #include <std_ext/malloc.h>
 #include <yss/PointerEvent.h>
+#include <yss/event.h>
 #include <sac/Rtouch.h>
 #include <yss.h>
 #include <yss/debug.h>
+#include <util/runtime.h>
 
 #if USE_EVENT
 
+// 끌기 이벤트를 전달하는 최소 간격 (ms), 화면 갱신 주기에 맞춰 설정
+#if !defined(TOUCH_EVENT_DRAG_INTERVAL)
+#define TOUCH_EVENT_DRAG_INTERVAL	16
+#endif
+
 namespace event
 {
 	void trigger_handleEvent(void);
 
 	PointerEvent gPointerEvent(TOUCH_EVENT_MEMORY_DEPTH);
 	static triggerId_t gTriggerId;
+	static uint64_t gLastDragTime;
 
 	void init(void)
 	{
@@ -29,9 +37,23 @@ namespace event
 	void trigger_handleEvent(void)
 	{
 		PointerEvent::PointerEventData data;
+		uint64_t elapsed;
+
 		while(gPointerEvent.getMessageCount())
 		{
 			data = gPointerEvent.pop();
+
+			// 끌기 이벤트는 간격이 지날 때까지 기다렸다가 그 동안 들어온 마지막 좌표로 전달
+			if(data.event == TOUCH_DRAG)
+			{
+				elapsed = runtime::getMsec() - gLastDragTime;
+				if(elapsed < TOUCH_EVENT_DRAG_INTERVAL)
+					thread::delay(TOUCH_EVENT_DRAG_INTERVAL - elapsed);
+
+				while(gPointerEvent.popDrag(data));
+				gLastDragTime = runtime::getMsec();
+			}
+
 			setEvent(Position_t{(int16_t)data.x, (int16_t)data.y}, data.event);
 		}
 	}
@@ -40,5 +62,15 @@ namespace event
 	{
 		dev.setInterface(gPointerEvent, gTriggerId);
 	}
+
+	uint32_t getDroppedCount(void)
+	{
+		return gPointerEvent.getDroppedCount();
+	}
+
+	uint32_t getCoalescedCount(void)
+	{
+		return gPointerEvent.getCoalescedCount();
+	}
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+// yss OS의 Bitmap_t, BitmapFile_t용 압축 비트맵 데이터를 생성하는 리눅스용 명령행 비트맵 컴파일러 입니다.
+// 24/32비트 BMP 또는 PPM(P6) 이미지를 RGB565로 변환한 뒤 RLE565, INDEX8, INDEX4 중 하나로 압축하여
+// C++ 소스 또는 BitmapFile_t 형식의 바이너리 파일로 출력합니다. (gui/BitmapDecoder.h 참고)
+//
+// This is a Linux command-line bitmap compiler that generates compressed bitmaps for the yss OS Brush classes.
+//
+// 빌드 (Build)
+//		g++ -O2 -o bmpc bmpc.cpp
+//
+// 사용법 (Usage)
+//		bmpc [options] <image.bmp | image.ppm>
+//		-o <file>		출력 파일 (기본값 : stdout)
+//		-n <name>		생성할 Bitmap_t 변수의 이름 (기본값 : bitmap)
+//		-f <format>		raw, rle, index8, index4, auto 중 하나 (기본값 : auto, 가장 작은 형식)
+//		-s				RGB565 점의 상위와 하위 바이트를 바꿈 (LCD로 바로 전송하는 경우)
+//		-r				R과 B의 위치를 바꿈
+//		-b				C++ 소스 대신 BitmapFile_t 형식의 바이너리 파일로 출력
+//
+// 변환이 끝나면 stderr로 각 형식의 크기와 호스트에서 측정한 디코딩 속도를 출력합니다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <map>
+#include <vector>
+
+enum
+{
+	TYPE_RGB565 = 0,
+	TYPE_RGB888,
+	TYPE_ARGB1555,
+	TYPE_RLE565,
+	TYPE_INDEX8,
+	TYPE_INDEX4,
+};
+
+struct Image
+{
+	int width, height;
+	std::vector<uint16_t> dot;	// RGB565
+};
+
+static uint32_t readLe(const uint8_t *data, int size)
+{
+	uint32_t value = 0;
+
+	for(int i = size - 1; i >= 0; i--)
+		value = value << 8 | data[i];
+
+	return value;
+}
+
+static uint16_t convertToRgb565(uint8_t red, uint8_t green, uint8_t blue, bool reverse)
+{
+	if(reverse)
+		return (blue & 0xF8) << 8 | (green & 0xFC) << 3 | red >> 3;
+	else
+		return (red & 0xF8) << 8 | (green & 0xFC) << 3 | blue >> 3;
+}
+
+static bool loadBmp(const std::vector<uint8_t> &file, Image &image, bool reverse)
+{
+	if(file.size() < 54 || file[0] != 'B' || file[1] != 'M')
+		return false;
+
+	uint32_t offset = readLe(&file[10], 4);
+	int32_t width = (int32_t)readLe(&file[18], 4), height = (int32_t)readLe(&file[22], 4);
+	uint16_t bpp = readLe(&file[28], 2);
+	uint32_t compression = readLe(&file[30], 4);
+	bool bottomUp = height > 0;
+
+	// 비압축 24비트와 32비트만 지원
+	if((bpp != 24 && bpp != 32) || (compression != 0 && compression != 3))
+		return false;
+
+	if(height < 0)
+		height = -height;
+
+	uint32_t stride = ((width * bpp / 8) + 3) & ~0x03;
+	if(offset + stride * height > file.size())
+		return false;
+
+	image.width = width;
+	image.height = height;
+	image.dot.resize(width * height);
+
+	for(int y = 0; y < height; y++)
+	{
+		const uint8_t *src = &file[offset + stride * (bottomUp ? height - 1 - y : y)];
+		for(int x = 0; x < width; x++)
+		{
+			image.dot[y * width + x] = convertToRgb565(src[2], src[1], src[0], reverse);
+			src += bpp / 8;
+		}
+	}
+
+	return true;
+}
+
+static bool loadPpm(const std::vector<uint8_t> &file, Image &image, bool reverse)
+{
+	size_t pos = 2;
+	int value[3];
+
+	if(file.size() < 3 || file[0] != 'P' || file[1] != '6')
+		return false;
+
+	// 폭, 높이, 최대값을 읽음 (주석 포함)
+	for(int i = 0; i < 3; i++)
+	{
+		while(pos < file.size() && (file[pos] == ' ' || file[pos] == '\t' || file[pos] == '\r' || file[pos] == '\n' || file[pos] == '#'))
+		{
+			if(file[pos] == '#')
+			{
+				while(pos < file.size() && file[pos] != '\n')
+					pos++;
+			}
+			else
+				pos++;
+		}
+
+		value[i] = 0;
+		while(pos < file.size() && file[pos] >= '0' && file[pos] <= '9')
+			value[i] = value[i] * 10 + file[pos++] - '0';
+	}
+	pos++;
+
+	if(value[2] != 255 || pos + value[0] * value[1] * 3 > file.size())
+		return false;
+
+	image.width = value[0];
+	image.height = value[1];
+	image.dot.resize(value[0] * value[1]);
+
+	for(size_t i = 0; i < image.dot.size(); i++)
+	{
+		image.dot[i] = convertToRgb565(file[pos], file[pos + 1], file[pos + 2], reverse);
+		pos += 3;
+	}
+
+	return true;
+}
+
+static void pushDot(std::vector<uint8_t> &data, uint16_t dot, bool swap)
+{
+	if(swap)
+	{
+		data.push_back(dot >> 8);
+		data.push_back(dot);
+	}
+	else
+	{
+		data.push_back(dot);
+		data.push_back(dot >> 8);
+	}
+}
+
+static void encodeRaw(const Image &image, std::vector<uint8_t> &data, bool swap)
+{
+	for(size_t i = 0; i < image.dot.size(); i++)
+		pushDot(data, image.dot[i], swap);
+}
+
+static void encodeRle(const Image &image, std::vector<uint8_t> &data, bool swap)
+{
+	const std::vector<uint16_t> &dot = image.dot;
+	size_t i = 0, literal;
+
+	while(i < dot.size())
+	{
+		size_t run = 1;
+		while(i + run < dot.size() && run < 128 && dot[i + run] == dot[i])
+			run++;
+
+		// 두 점 이상 반복되면 반복 토큰 (3바이트로 4바이트 이상을 표현)
+		if(run >= 2)
+		{
+			data.push_back(0x80 | (run - 1));
+			pushDot(data, dot[i], swap);
+			i += run;
+			continue;
+		}
+
+		// 다음 반복이 시작되기 전까지 압축되지 않은 점
+		literal = 1;
+		while(i + literal < dot.size() && literal < 128)
+		{
+			if(i + literal + 1 < dot.size() && dot[i + literal] == dot[i + literal + 1])
+				break;
+			literal++;
+		}
+
+		data.push_back(literal - 1);
+		for(size_t j = 0; j < literal; j++)
+			pushDot(data, dot[i + j], swap);
+		i += literal;
+	}
+}
+
+static bool encodeIndex(const Image &image, std::vector<uint8_t> &data, bool swap, int bpp)
+{
+	std::map<uint16_t, int> palette;
+	int maxColor = 1 << bpp;
+
+	for(size_t i = 0; i < image.dot.size(); i++)
+	{
+		if(palette.find(image.dot[i]) == palette.end())
+		{
+			if((int)palette.size() == maxColor)
+				return false;
+			palette[image.dot[i]] = 0;
+		}
+	}
+
+	int num = 0;
+	data.push_back(palette.size() - 1);
+	for(std::map<uint16_t, int>::iterator it = palette.begin(); it != palette.end(); it++)
+	{
+		it->second = num++;
+		pushDot(data, it->first, swap);
+	}
+
+	for(int y = 0; y < image.height; y++)
+	{
+		for(int x = 0; x < image.width; x++)
+		{
+			int index = palette[image.dot[y * image.width + x]];
+
+			if(bpp == 8)
+				data.push_back(index);
+			else if(x & 0x01)
+				data.back() |= index << 4;
+			else
+				data.push_back(index);
+		}
+	}
+
+	return true;
+}
+
+// gui/BitmapDecoder와 같은 방식으로 풀어 결과를 검증하고 속도를 측정한다.
+static void decode(const std::vector<uint8_t> &data, int type, int width, uint32_t count, uint8_t *des)
+{
+	const uint8_t *src = &data[0], *palette = &data[1];
+
+	switch(type)
+	{
+	case TYPE_RGB565 :
+		memcpy(des, src, count * 2);
+		break;
+
+	case TYPE_RLE565 :
+		while(count)
+		{
+			uint8_t token = *src++;
+			uint32_t num = (token & 0x7F) + 1;
+
+			if(token & 0x80)
+			{
+				for(uint32_t i = 0; i < num; i++)
+				{
+					*des++ = src[0];
+					*des++ = src[1];
+				}
+				src += 2;
+			}
+			else
+			{
+				memcpy(des, src, num * 2);
+				des += num * 2;
+				src += num * 2;
+			}
+			count -= num;
+		}
+		break;
+
+	case TYPE_INDEX8 :
+		src += 1 + (data[0] + 1) * 2;
+		while(count--)
+		{
+			const uint8_t *color = &palette[*src++ * 2];
+			*des++ = color[0];
+			*des++ = color[1];
+		}
+		break;
+
+	case TYPE_INDEX4 :
+		src += 1 + (data[0] + 1) * 2;
+		for(uint32_t i = 0, x = 0; i < count; i++)
+		{
+			const uint8_t *color = &palette[((x & 0x01) ? *src >> 4 : *src & 0x0F) * 2];
+			*des++ = color[0];
+			*des++ = color[1];
+
+			x++;
+			if((x & 0x01) == 0 || x == (uint32_t)width)
+				src++;
+			if(x == (uint32_t)width)
+				x = 0;
+		}
+		break;
+	}
+}
+
+static void printUsage(void)
+{
+	fprintf(stderr, "usage : bmpc [-o file] [-n name] [-f raw|rle|index8|index4|auto] [-s] [-r] [-b] <image.bmp | image.ppm>\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *outPath = 0, *name = "bitmap", *inPath = 0, *format = "auto";
+	bool swap = false, reverse = false, binary = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(argv[i][0] != '-')
+		{
+			inPath = argv[i];
+			continue;
+		}
+
+		switch(argv[i][1])
+		{
+		case 's' :
+			swap = true;
+			continue;
+		case 'r' :
+			reverse = true;
+			continue;
+		case 'b' :
+			binary = true;
+			continue;
+		}
+
+		if(i + 1 >= argc)
+		{
+			printUsage();
+			return 1;
+		}
+
+		switch(argv[i][1])
+		{
+		case 'o' :
+			outPath = argv[++i];
+			break;
+		case 'n' :
+			name = argv[++i];
+			break;
+		case 'f' :
+			format = argv[++i];
+			break;
+		default :
+			printUsage();
+			return 1;
+		}
+	}
+
+	if(inPath == 0)
+	{
+		printUsage();
+		return 1;
+	}
+
+	FILE *in = fopen(inPath, "rb");
+	if(in == 0)
+	{
+		fprintf(stderr, "error : can't open \"%s\"\n", inPath);
+		return 1;
+	}
+
+	std::vector<uint8_t> file;
+	uint8_t buf[4096];
+	size_t len;
+	while((len = fread(buf, 1, sizeof(buf), in)) > 0)
+		file.insert(file.end(), buf, buf + len);
+	fclose(in);
+
+	Image image;
+	if(!loadBmp(file, image, reverse) && !loadPpm(file, image, reverse))
+	{
+		fprintf(stderr, "error : \"%s\" is not a 24/32 bit BMP or PPM(P6) image\n", inPath);
+		return 1;
+	}
+
+	if(image.width > 0xFFFF || image.height > 0xFFFF || image.width == 0 || image.height == 0)
+	{
+		fprintf(stderr, "error : wrong image size\n");
+		return 1;
+	}
+
+	// 모든 형식으로 압축해 보고 지정된 형식 또는 가장 작은 형식을 선택
+	static const char *typeName[] = {"RGB565", "RGB888", "ARGB1555", "RLE565", "INDEX8", "INDEX4"};
+	std::vector<uint8_t> data[6];
+	bool valid[6] = {true, false, false, true, false, false};
+	int type = -1;
+
+	encodeRaw(image, data[TYPE_RGB565], swap);
+	encodeRle(image, data[TYPE_RLE565], swap);
+	valid[TYPE_INDEX8] = encodeIndex(image, data[TYPE_INDEX8], swap, 8);
+	valid[TYPE_INDEX4] = encodeIndex(image, data[TYPE_INDEX4], swap, 4);
+
+	if(strcmp(format, "raw") == 0)
+		type = TYPE_RGB565;
+	else if(strcmp(format, "rle") == 0)
+		type = TYPE_RLE565;
+	else if(strcmp(format, "index8") == 0)
+		type = TYPE_INDEX8;
+	else if(strcmp(format, "index4") == 0)
+		type = TYPE_INDEX4;
+	else if(strcmp(format, "auto") == 0)
+	{
+		type = TYPE_RGB565;
+		for(int i = TYPE_RLE565; i <= TYPE_INDEX4; i++)
+		{
+			if(valid[i] && data[i].size() < data[type].size())
+				type = i;
+		}
+	}
+	else
+	{
+		printUsage();
+		return 1;
+	}
+
+	if(!valid[type])
+	{
+		fprintf(stderr, "error : the image has too many colors for %s\n", typeName[type]);
+		return 1;
+	}
+
+	// 디코딩 결과 검증
+	uint32_t count = image.width * image.height;
+	std::vector<uint8_t> decoded(count * 2);
+	decode(data[type], type, image.width, count, &decoded[0]);
+	if(memcmp(&decoded[0], &data[TYPE_RGB565][0], count * 2))
+	{
+		fprintf(stderr, "error : verification failed\n");
+		return 1;
+	}
+
+	FILE *out = outPath ? fopen(outPath, binary ? "wb" : "w") : stdout;
+	if(out == 0)
+	{
+		fprintf(stderr, "error : can't create \"%s\"\n", outPath);
+		return 1;
+	}
+
+	std::vector<uint8_t> &result = data[type];
+
+	if(binary)
+	{
+		// BitmapFile_t의 헤더 (width, height, type, reserved[3]) 다음에 데이터
+		uint8_t header[8] = {(uint8_t)image.width, (uint8_t)(image.width >> 8), (uint8_t)image.height, (uint8_t)(image.height >> 8), (uint8_t)type, 0, 0, 0};
+		fwrite(header, 1, sizeof(header), out);
+		fwrite(&result[0], 1, result.size(), out);
+	}
+	else
+	{
+		fprintf(out, "// bmpc로 생성된 파일입니다. 직접 수정하지 마세요.\n");
+		fprintf(out, "// source : %s, %d x %d, type : %s\n\n", inPath, image.width, image.height, typeName[type]);
+		fprintf(out, "#include <gui/util.h>\n\n");
+
+		fprintf(out, "static const uint8_t %s_data[%u] = {", name, (uint32_t)result.size());
+		for(size_t i = 0; i < result.size(); i++)
+			fprintf(out, "%s0x%02X", i % 16 ? ", " : (i ? ",\n\t" : "\n\t"), result[i]);
+		fprintf(out, "\n};\n\n");
+
+		fprintf(out, "extern const Bitmap_t %s;\n\n", name);
+		fprintf(out, "const Bitmap_t %s =\n{\n", name);
+		fprintf(out, "\t%d,\t\t\t// width\n", image.width);
+		fprintf(out, "\t%d,\t\t\t// height\n", image.height);
+		fprintf(out, "\t%d,\t\t\t// type (%s)\n", type, typeName[type]);
+		fprintf(out, "\t(uint8_t*)%s_data\n", name);
+		fprintf(out, "};\n\n");
+	}
+
+	if(outPath)
+		fclose(out);
+
+	// 결과 보고
+	clock_t begin = clock();
+	uint32_t repeat = 0;
+
+	do
+	{
+		decode(result, type, image.width, count, &decoded[0]);
+		repeat++;
+	}while(clock() - begin < CLOCKS_PER_SEC / 2);
+
+	double sec = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+	fprintf(stderr, "image          : %d x %d\n", image.width, image.height);
+	for(int i = 0; i < 6; i++)
+	{
+		if(i == TYPE_RGB565 || i >= TYPE_RLE565)
+		{
+			if(valid[i])
+				fprintf(stderr, "%-8s       : %u bytes%s\n", typeName[i], (uint32_t)data[i].size(), i == type ? " (selected)" : "");
+			else
+				fprintf(stderr, "%-8s       : too many colors\n", typeName[i]);
+		}
+	}
+	fprintf(stderr, "flash saved    : %d bytes (%.1f%%)\n", (int)(data[TYPE_RGB565].size() - result.size()), 100.0 * ((double)data[TYPE_RGB565].size() - result.size()) / data[TYPE_RGB565].size());
+	fprintf(stderr, "decode speed   : %.1f Mdot/s (host)\n", (double)count * repeat / sec / 1e6);
+
+	return 0;
+}
+
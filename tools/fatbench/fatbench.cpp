@@ -0,0 +1,1702 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+// yss OS의 FAT32 파일 시스템(Fat32, Fat32Cluster, Fat32DirectoryEntry, File)을 SD 메모리 없이 리눅스에서 실행하는 벤치마크 입니다.
+// 이미지 파일을 mmap으로 연결한 MassStorage에 FAT32 볼륨을 만들고
+// 순차 쓰기/읽기, 임의 위치 이동, 클러스터를 할당하며 덧붙이기, 디렉토리 검색의 시간과 저장 장치의 명령 수를 출력합니다.
+// 저장 장치의 명령당, 블록당 지연 시간을 설정하면 SD 메모리처럼 명령의 수가 성능에 주는 영향을 볼 수 있고,
+// 빈 공간을 일정한 간격으로 막아 조각난 볼륨에서의 할당 성능을 측정할 수 있습니다.
+// BlockCache를 저장 장치 앞에 두면 캐시가 줄이는 명령의 수를 볼 수 있습니다.
+// 테스트가 끝나면 이미지를 fsck.fat과 같은 기준으로 검사하고, 요청하면 fsck.fat -n으로도 검사합니다.
+//
+// This is a Linux benchmark and consistency checker for the yss FAT32 file system on an mmap-backed image.
+//
+// 빌드 (Build)
+//		Y=../../targets/M2xx/Source/yss
+//		g++ -O2 -I host -I $Y/inc -o fatbench fatbench.cpp $Y/src/system/yss_{BlockCache,Directory,Fat32,Fat32Cluster,Fat32DirectoryEntry,File}.cpp $Y/src/sac/sac_{FileSystem,MassStorage}.cpp $Y/src/mod/sdram/mod_VirtualMassStorage.cpp
+//
+// 사용법 (Usage)
+//		fatbench [options] [test ...]
+//		-i <file>			이미지 파일 (기본값 : fatbench.img)
+//		-u					이미지를 새로 만들지 않고 있는 이미지를 사용
+//		-s <MB>				새로 만들 이미지의 크기 (기본값 : 512)
+//		-c <sectors>		클러스터당 섹터의 수 (기본값 : 8)
+//		-F <clusters>		빈 클러스터 <clusters>개마다 한 클러스터를 사용 중으로 막아 빈 공간을 조각냄 (기본값 : 0, 조각내지 않음)
+//		-S <KB>				순차 쓰기/읽기, 덧붙이기 파일의 크기 (기본값 : 4096)
+//		-b <bytes>			순차 쓰기/읽기 단위 (기본값 : 4096)
+//		-n <count>			디렉토리 검색에 사용할 파일의 수 (기본값 : 256)
+//		-l <us>,<us>		저장 장치의 명령당, 블록당 지연 시간 (기본값 : 0,0)
+//		-r					지연 시간을 계산만 하지 않고 실제로 대기
+//		-C <sets>,<ways>[,<blocks>]
+//							세트의 수, 세트당 블록의 수, 미리 읽기 블록의 수로 BlockCache를 저장 장치 앞에 둠 (기본값 : 사용 안함)
+//		-k					검사가 끝나면 fsck.fat -n으로 이미지를 한번 더 검사
+//		-v					검사한 모든 파일의 크기와 조각의 수를 출력
+//
+// 테스트 (Test)
+//		write		순차 쓰기			read		순차 읽기 및 내용 확인
+//		seek		임의 위치 이동		append		64 바이트씩 덧붙이기
+//		reserve		File::reserve() 후 덧붙이기
+//		multi		두 파일을 동시에 열고 읽기와 쓰기를 번갈아 하기
+//		lookup		한 디렉토리에 파일들을 만들고 경로로 임의의 순서로 열기
+//		browse		파일을 열어 쓰면서 Directory로 파일의 이름을 임의의 순서로 얻기
+//		empty		시작 클러스터가 0인 빈 파일에 쓰기, 덧붙이기, 예약하기
+//		virtual		VirtualMassStorage로 만든 드라이브의 파일을 Fat32로 읽고 새 파일을 써서 다시 읽기
+//		log			APPEND_LOG 모드로 기록하다가 전원이 꺼진 것처럼 버리고 다시 열어 복구하기,
+//					일부만 채운 섹터로 여러 번 닫고 다시 열기
+//
+// 테스트 이름을 지정하지 않으면 모든 테스트를 실행합니다.
+// 읽은 내용이 다르거나 이미지 검사에서 오류가 있으면 종료 코드 1을 반환합니다.
+
+#include <config.h>
+#include <yss/Fat32.h>
+#include <yss/File.h>
+#include <yss/Directory.h>
+#include <mod/sdram/VirtualMassStorage.h>
+#include <yss/BlockCache.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <set>
+#include <vector>
+
+// 이미지 파일의 메모리를 블록 단위로 읽고 쓰는 저장 장치
+// 명령과 블록의 수를 세고, 설정된 지연 시간을 더하거나 실제로 대기한다.
+class ImageStorage : public MassStorage
+{
+public :
+	struct Count
+	{
+		uint64_t readCommand, readBlock, writeCommand, writeBlock;
+		double deviceUsec;
+	};
+
+	Count count;
+
+	ImageStorage(uint8_t *data, uint32_t numOfBlock)
+	{
+		mData = data;
+		mNumOfBlock = numOfBlock;
+		mCommandUsec = 0;
+		mBlockUsec = 0;
+		mRealFlag = false;
+		reset();
+	}
+
+	void setLatency(double commandUsec, double blockUsec, bool realFlag)
+	{
+		mCommandUsec = commandUsec;
+		mBlockUsec = blockUsec;
+		mRealFlag = realFlag;
+	}
+
+	void reset(void)
+	{
+		memset(&count, 0, sizeof(count));
+	}
+
+	virtual uint32_t getBlockSize(void)
+	{
+		return 512;
+	}
+
+	virtual uint32_t getNumOfBlock(void)
+	{
+		return mNumOfBlock;
+	}
+
+	virtual error_t write(uint32_t block, void *src)
+	{
+		return writeBlocks(block, 1, src);
+	}
+
+	virtual error_t read(uint32_t block, void *des)
+	{
+		return readBlocks(block, 1, des);
+	}
+
+	virtual error_t writeBlocks(uint32_t block, uint32_t num, void *src)
+	{
+		if(block + num > mNumOfBlock)
+			return error_t::INDEX_OVER;
+
+		memcpy(&mData[(uint64_t)block * 512], src, num * 512);
+		count.writeCommand++;
+		count.writeBlock += num;
+		wait(num);
+
+		return error_t::ERROR_NONE;
+	}
+
+	virtual error_t readBlocks(uint32_t block, uint32_t num, void *des)
+	{
+		if(block + num > mNumOfBlock)
+			return error_t::INDEX_OVER;
+
+		memcpy(des, &mData[(uint64_t)block * 512], num * 512);
+		count.readCommand++;
+		count.readBlock += num;
+		wait(num);
+
+		return error_t::ERROR_NONE;
+	}
+
+	virtual bool isConnected(void)
+	{
+		return true;
+	}
+
+private :
+	uint8_t *mData;
+	uint32_t mNumOfBlock;
+	double mCommandUsec, mBlockUsec;
+	bool mRealFlag;
+
+	void wait(uint32_t num)
+	{
+		double usec = mCommandUsec + mBlockUsec * num;
+
+		count.deviceUsec += usec;
+		if(mRealFlag && usec > 0)
+			usleep((useconds_t)usec);
+	}
+};
+
+// 이미지의 구성
+// MBR(파티션 유형 0x0C) 뒤 PARTITION_START 섹터부터 FAT32 볼륨을 만든다.
+#define PARTITION_START		2048
+#define RESERVED_SECTOR		32
+#define NUM_OF_FAT			2
+
+static inline uint16_t get16(const uint8_t *src)
+{
+	return src[0] | src[1] << 8;
+}
+
+static inline uint32_t get32(const uint8_t *src)
+{
+	return src[0] | src[1] << 8 | src[2] << 16 | (uint32_t)src[3] << 24;
+}
+
+static inline void set16(uint8_t *des, uint16_t value)
+{
+	des[0] = value;
+	des[1] = value >> 8;
+}
+
+static inline void set32(uint8_t *des, uint32_t value)
+{
+	des[0] = value;
+	des[1] = value >> 8;
+	des[2] = value >> 16;
+	des[3] = value >> 24;
+}
+
+// 0으로 채워진 이미지에 FAT32 볼륨을 만든다.
+// hole이 0이 아니면 빈 클러스터 hole개마다 한 클러스터를 JUNK.BIN 파일의 체인으로 사용해 빈 공간을 조각낸다.
+// 다른 기기에서 만든 것처럼 시작 클러스터가 0인 빈 파일 EMPTY.BIN, EMPTY.LOG, EMPTY.RES를 루트 디렉토리에 둔다.
+// 반환 : 볼륨의 클러스터 수를 반환한다. 만들 수 없으면 0을 반환한다.
+static uint32_t formatImage(uint8_t *img, uint64_t size, uint8_t sectorPerCluster, uint32_t hole)
+{
+	uint32_t numOfSector = size / 512 - PARTITION_START, fatSize = 1, numOfCluster, need;
+	uint8_t *mbr = img, *bs = &img[PARTITION_START * 512], *fsInfo = bs + 512, *fat, *root, *entry;
+	std::vector<uint32_t> junk;
+
+	if(size / 512 <= PARTITION_START + RESERVED_SECTOR + 64 || size / 512 > 0xFFFFFFFF)
+		return 0;
+
+	// FAT의 크기와 클러스터의 수를 함께 결정
+	while(true)
+	{
+		numOfCluster = (numOfSector - RESERVED_SECTOR - NUM_OF_FAT * fatSize) / sectorPerCluster;
+		need = ((numOfCluster + 2) * 4 + 511) / 512;
+		if(need <= fatSize)
+			break;
+		fatSize = need;
+	}
+
+	mbr[0x1BE + 4] = 0x0C;
+	set32(&mbr[0x1BE + 8], PARTITION_START);
+	set32(&mbr[0x1BE + 12], numOfSector);
+	set16(&mbr[0x1FE], 0xAA55);
+
+	memcpy(bs, "\xEB\x58\x90MSWIN4.1", 11);
+	set16(&bs[0x0B], 512);
+	bs[0x0D] = sectorPerCluster;
+	set16(&bs[0x0E], RESERVED_SECTOR);
+	bs[0x10] = NUM_OF_FAT;
+	bs[0x15] = 0xF8;
+	set16(&bs[0x18], 63);
+	set16(&bs[0x1A], 255);
+	set32(&bs[0x1C], PARTITION_START);
+	set32(&bs[0x20], numOfSector);
+	set32(&bs[0x24], fatSize);
+	set32(&bs[0x2C], 2);
+	set16(&bs[0x30], 1);
+	set16(&bs[0x32], 6);
+	bs[0x40] = 0x80;
+	bs[0x42] = 0x29;
+	set32(&bs[0x43], 0x20150000);
+	memcpy(&bs[0x47], "NO NAME    FAT32   ", 19);
+	set16(&bs[0x1FE], 0xAA55);
+	memcpy(bs + 6 * 512, bs, 512);
+
+	set32(&fsInfo[0x000], 0x41615252);
+	set32(&fsInfo[0x1E4], 0x61417272);
+	set16(&fsInfo[0x1FE], 0xAA55);
+
+	// 루트 디렉토리(클러스터 2)와 조각내기용 체인
+	if(hole)
+	{
+		for(uint32_t cluster = 2 + hole; cluster < numOfCluster + 2; cluster += hole + 1)
+			junk.push_back(cluster);
+
+		if((uint64_t)junk.size() * sectorPerCluster * 512 > 0xFFFFFFFF)
+			return 0;
+	}
+
+	for(uint32_t i = 0; i < NUM_OF_FAT; i++)
+	{
+		fat = bs + (RESERVED_SECTOR + i * fatSize) * 512;
+		set32(&fat[0], 0x0FFFFFF8);
+		set32(&fat[4], 0x0FFFFFFF);
+		set32(&fat[8], 0x0FFFFFFF);
+		for(uint32_t j = 0; j < junk.size(); j++)
+			set32(&fat[junk[j] * 4], j + 1 < junk.size() ? junk[j + 1] : 0x0FFFFFFF);
+	}
+
+	set32(&fsInfo[0x1E8], numOfCluster - 1 - junk.size());
+	set32(&fsInfo[0x1EC], 3);
+
+	root = bs + (RESERVED_SECTOR + NUM_OF_FAT * fatSize) * 512;
+	memcpy(&root[0], "FATBENCH   ", 11);
+	root[11] = 0x08;
+	entry = &root[32];
+	if(hole)
+	{
+		memcpy(entry, "JUNK    BIN", 11);
+		entry[11] = 0x20;
+		set16(&entry[20], junk[0] >> 16);
+		set16(&entry[26], junk[0]);
+		set32(&entry[28], junk.size() * sectorPerCluster * 512);
+		entry += 32;
+	}
+
+	for(const char *name : {"EMPTY   BIN", "EMPTY   LOG", "EMPTY   RES"})
+	{
+		memcpy(entry, name, 11);
+		entry[11] = 0x20;
+		entry += 32;
+	}
+
+	return numOfCluster;
+}
+
+// fsck.fat이 확인하는 항목들로 이미지를 검사한다.
+// 부트 섹터와 백업, 두 FAT의 일치, 디렉토리 엔트리, 체인의 길이와 교차, 잃어버린 클러스터, FSInfo의 빈 클러스터 수를 확인한다.
+class ImageChecker
+{
+public :
+	struct FileInfo
+	{
+		char path[256];
+		uint32_t size, extents;
+	};
+
+	std::vector<FileInfo> file;
+	uint32_t error, numOfDirectory;
+
+	ImageChecker(const uint8_t *img, uint64_t size)
+	{
+		mImg = img;
+		mSize = size;
+		error = 0;
+		numOfDirectory = 0;
+	}
+
+	uint32_t check(void)
+	{
+		const uint8_t *bs;
+		uint32_t numOfSector, free = 0, value;
+
+		if(get16(&mImg[0x1FE]) != 0xAA55 || mImg[0x1BE + 4] != 0x0C)
+			return report("MBR has no FAT32 partition");
+
+		mStart = get32(&mImg[0x1BE + 8]);
+		bs = &mImg[(uint64_t)mStart * 512];
+		if(get16(&bs[0x1FE]) != 0xAA55 || get16(&bs[0x0B]) != 512)
+			return report("bad boot sector");
+
+		if(memcmp(bs, bs + get16(&bs[0x32]) * 512, 512))
+			report("backup boot sector differs from boot sector");
+
+		mSectorPerCluster = bs[0x0D];
+		mClusterSize = mSectorPerCluster * 512;
+		mFatSize = get32(&bs[0x24]);
+		mFat = bs + get16(&bs[0x0E]) * 512;
+		mData = mFat + (uint64_t)bs[0x10] * mFatSize * 512;
+		numOfSector = get32(&bs[0x20]);
+		mNumOfCluster = (numOfSector - get16(&bs[0x0E]) - bs[0x10] * mFatSize) / mSectorPerCluster;
+		mRoot = get32(&bs[0x2C]);
+
+		if((uint64_t)mStart * 512 + (uint64_t)numOfSector * 512 > mSize)
+			return report("volume is larger than the image");
+
+		for(uint32_t i = 1; i < bs[0x10]; i++)
+		{
+			if(memcmp(mFat, mFat + (uint64_t)i * mFatSize * 512, mFatSize * 512))
+				report("FAT %u differs from FAT 0", i);
+		}
+
+		if((getFat(0) & 0xFF) != bs[0x15] || getFat(1) < 0x0FFFFFF8)
+			report("bad reserved FAT entries");
+
+		mOwner.assign(mNumOfCluster + 2, false);
+		checkDirectory(mRoot, 0, "");
+
+		// 잃어버린 클러스터와 빈 클러스터의 수
+		for(uint32_t cluster = 2; cluster < mNumOfCluster + 2; cluster++)
+		{
+			value = getFat(cluster);
+			if(value == 0)
+				free++;
+			else if(value != 0x0FFFFFF7 && !mOwner[cluster])
+			{
+				report("lost cluster %u", cluster);
+				if(error > 100)
+					return error;
+			}
+		}
+
+		const uint8_t *fsInfo = bs + get16(&bs[0x30]) * 512;
+		if(get32(&fsInfo[0]) != 0x41615252 || get32(&fsInfo[0x1E4]) != 0x61417272)
+			report("bad FSInfo signature");
+		else
+		{
+			value = get32(&fsInfo[0x1E8]);
+			if(value != 0xFFFFFFFF && value != free)
+				report("FSInfo free cluster count %u, actual %u", value, free);
+
+			value = get32(&fsInfo[0x1EC]);
+			if(value != 0xFFFFFFFF && (value < 2 || value >= mNumOfCluster + 2))
+				report("FSInfo next free cluster %u out of range", value);
+		}
+
+		mFreeCount = free;
+		return error;
+	}
+
+	uint32_t getFreeCount(void)
+	{
+		return mFreeCount;
+	}
+
+private :
+	const uint8_t *mImg, *mFat, *mData;
+	uint64_t mSize;
+	uint32_t mStart, mSectorPerCluster, mClusterSize, mFatSize, mNumOfCluster, mRoot, mFreeCount;
+	std::vector<bool> mOwner;
+
+	__attribute__((format(printf, 2, 3))) uint32_t report(const char *format, ...)
+	{
+		va_list args;
+
+		if(error < 20)
+		{
+			printf("check : ");
+			va_start(args, format);
+			vprintf(format, args);
+			va_end(args);
+			printf("\n");
+		}
+		else if(error == 20)
+			printf("check : ...\n");
+
+		return ++error;
+	}
+
+	uint32_t getFat(uint32_t cluster)
+	{
+		return get32(&mFat[cluster * 4]) & 0x0FFFFFFF;
+	}
+
+	// 체인을 따라가며 클러스터들을 표시한다. 교차되거나 잘못된 클러스터를 만나면 멈춘다.
+	std::vector<uint32_t> walk(uint32_t cluster, const char *path)
+	{
+		std::vector<uint32_t> chain;
+
+		while(cluster >= 2 && cluster < 0x0FFFFFF8)
+		{
+			if(cluster >= mNumOfCluster + 2)
+			{
+				report("%s : cluster %u out of range", path, cluster);
+				break;
+			}
+
+			if(mOwner[cluster])
+			{
+				report("%s : cluster %u cross-linked", path, cluster);
+				break;
+			}
+
+			if(getFat(cluster) == 0)
+			{
+				report("%s : chain reaches free cluster %u", path, cluster);
+				break;
+			}
+
+			mOwner[cluster] = true;
+			chain.push_back(cluster);
+			cluster = getFat(cluster);
+		}
+
+		return chain;
+	}
+
+	static uint8_t calculateChecksum(const uint8_t *name)
+	{
+		uint8_t sum = 0;
+
+		for(int i = 0; i < 11; i++)
+			sum = ((sum & 1) << 7) + (sum >> 1) + name[i];
+
+		return sum;
+	}
+
+	static bool isValidShortName(const uint8_t *name)
+	{
+		if(name[0] == ' ')
+			return false;
+
+		for(int i = 0; i < 11; i++)
+		{
+			if((name[i] < 0x20 && !(i == 0 && name[i] == 0x05)) || ('a' <= name[i] && name[i] <= 'z') || strchr("\"*+,./:;<=>?[\\]|", name[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	void checkDirectory(uint32_t cluster, uint32_t parent, const char *path)
+	{
+		std::vector<uint32_t> chain = walk(cluster, *path ? path : "/");
+		std::set<std::pair<uint64_t, uint32_t> > shortName;
+		char child[256];
+		uint16_t longName[64 * 13 + 1];
+		const uint8_t *entry;
+		uint32_t index = 0, start, size;
+		uint8_t lfnChecksum = 0, lfnOrder = 0;
+		bool rootFlag = cluster == mRoot, longNameFlag = false;
+
+		numOfDirectory++;
+
+		for(uint32_t c : chain)
+		{
+			for(uint32_t i = 0; i < mClusterSize; i += 32, index++)
+			{
+				entry = &mData[((uint64_t)c - 2) * mClusterSize + i];
+
+				if(entry[0] == 0x00)
+					return;
+
+				if(entry[0] == 0xE5)
+				{
+					lfnOrder = 0;
+					longNameFlag = false;
+					continue;
+				}
+
+				if(entry[11] == 0x0F)
+				{
+					if(get16(&entry[26]))
+						report("%s : long name entry %u has a non-zero cluster", path, index);
+
+					if(entry[0] & 0x40)
+					{
+						lfnOrder = entry[0] & 0x3F;
+						lfnChecksum = entry[13];
+						longName[lfnOrder * 13] = 0;
+					}
+					else if(lfnOrder == 0 || (entry[0] & 0x3F) != lfnOrder - 1 || entry[13] != lfnChecksum)
+					{
+						report("%s : broken long name entry %u", path, index);
+						lfnOrder = 0;
+						continue;
+					}
+					else
+						lfnOrder--;
+
+					if(lfnOrder)
+						copyLongName(&longName[(lfnOrder - 1) * 13], entry);
+					continue;
+				}
+
+				longNameFlag = false;
+				if(lfnOrder)
+				{
+					if(lfnOrder != 1 || calculateChecksum(entry) != lfnChecksum)
+						report("%s : long name of entry %u does not match its short name", path, index);
+					else
+						longNameFlag = true;
+					lfnOrder = 0;
+				}
+
+				if(entry[11] & 0x08)
+					continue;
+
+				start = get16(&entry[20]) << 16 | get16(&entry[26]);
+				size = get32(&entry[28]);
+
+				// 루트가 아닌 디렉토리의 처음 두 엔트리는 '.'과 '..'
+				if(!rootFlag && index < 2)
+				{
+					if(memcmp(entry, index ? "..         " : ".          ", 11) || !(entry[11] & 0x10))
+						report("%s : missing '%s' entry", path, index ? ".." : ".");
+					else if(start != (index ? parent : cluster))
+						report("%s : '%s' points to cluster %u instead of %u", path, index ? ".." : ".", start, index ? parent : cluster);
+					continue;
+				}
+
+				getName(child, path, entry, longNameFlag ? longName : 0);
+
+				if(!isValidShortName(entry))
+					report("%s : invalid short name", child);
+				else if(!shortName.insert(std::make_pair((uint64_t)get32(entry) | (uint64_t)get32(&entry[4]) << 32, get32(&entry[7]))).second)
+					report("%s : duplicate short name \"%.11s\"", child, (const char*)entry);
+
+				if(entry[11] & 0x10)
+				{
+					if(size)
+						report("%s : directory has non-zero size", child);
+
+					checkDirectory(start, rootFlag ? 0 : cluster, child);
+				}
+				else
+					checkFile(child, start, size);
+			}
+		}
+	}
+
+	void checkFile(const char *path, uint32_t start, uint32_t size)
+	{
+		std::vector<uint32_t> chain;
+		uint32_t extents = 0;
+		FileInfo info;
+
+		if(start)
+			chain = walk(start, path);
+
+		// fsck.fat은 파일 크기에 필요한 것보다 길거나 짧은 체인을 오류로 처리
+		if((uint64_t)chain.size() * mClusterSize < size)
+			report("%s : size is %u bytes, chain has only %zu clusters", path, size, chain.size());
+		else if(chain.size() && (uint64_t)(chain.size() - 1) * mClusterSize >= size)
+			report("%s : size is %u bytes, chain is longer (%zu clusters)", path, size, chain.size());
+
+		for(uint32_t i = 0; i < chain.size(); i++)
+		{
+			if(i == 0 || chain[i] != chain[i - 1] + 1)
+				extents++;
+		}
+
+		snprintf(info.path, sizeof(info.path), "%s", path);
+		info.size = size;
+		info.extents = extents;
+		file.push_back(info);
+	}
+
+	// 긴 이름 엔트리의 UCS-2 문자 13개를 복사한다.
+	static void copyLongName(uint16_t *des, const uint8_t *entry)
+	{
+		static const uint8_t offset[13] = {1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30};
+
+		for(int i = 0; i < 13; i++)
+			des[i] = get16(&entry[offset[i]]);
+	}
+
+	// 디렉토리 경로 뒤에 긴 이름을 UTF-8로 붙인다.
+	// 긴 이름이 없으면 짧은 이름을 "이름.확장자"로 붙인다.
+	static void getName(char *des, const char *path, const uint8_t *entry, const uint16_t *longName)
+	{
+		char name[256], *cdes = name;
+		int len;
+
+		if(longName)
+		{
+			for(; *longName && *longName != 0xFFFF && cdes < &name[sizeof(name) - 4]; longName++)
+			{
+				if(*longName < 0x80)
+					*cdes++ = *longName;
+				else if(*longName < 0x800)
+				{
+					*cdes++ = 0xC0 | *longName >> 6;
+					*cdes++ = 0x80 | (*longName & 0x3F);
+				}
+				else
+				{
+					*cdes++ = 0xE0 | *longName >> 12;
+					*cdes++ = 0x80 | (*longName >> 6 & 0x3F);
+					*cdes++ = 0x80 | (*longName & 0x3F);
+				}
+			}
+		}
+		else
+		{
+			for(int i = 0; i < 8 && entry[i] != ' '; i++)
+				*cdes++ = entry[i];
+
+			if(entry[8] != ' ')
+			{
+				*cdes++ = '.';
+				for(int i = 8; i < 11 && entry[i] != ' '; i++)
+					*cdes++ = entry[i];
+			}
+		}
+
+		*cdes = 0;
+		len = snprintf(des, 256, "%s", path);
+		if(len < 255)
+			snprintf(&des[len], 256 - len, "/%s", name);
+	}
+};
+
+// 파일의 내용으로 사용하는 패턴
+static inline uint8_t getPattern(uint32_t position, uint32_t seed)
+{
+	return (position * 7 + (position >> 9) + seed) & 0xFF;
+}
+
+static void fillPattern(uint8_t *des, uint32_t position, uint32_t size, uint32_t seed)
+{
+	for(uint32_t i = 0; i < size; i++)
+		des[i] = getPattern(position + i, seed);
+}
+
+static bool checkPattern(const uint8_t *src, uint32_t position, uint32_t size, uint32_t seed)
+{
+	for(uint32_t i = 0; i < size; i++)
+	{
+		if(src[i] != getPattern(position + i, seed))
+			return false;
+	}
+
+	return true;
+}
+
+static uint32_t gSeed = 1;
+
+static uint32_t getRandom(uint32_t max)
+{
+	gSeed = gSeed * 1103515245 + 12345;
+	return ((gSeed >> 16) | (gSeed << 16)) % max;
+}
+
+static ImageStorage *gStorage;
+static BlockCache *gCache;
+static MassStorage *gDevice;
+static Fat32 *gFs;
+static uint32_t gFileSize = 4096 * 1024, gChunkSize = 4096, gNumOfLookup = 256;
+static bool gRealFlag;
+static struct timespec gBegin;
+
+static void begin(void)
+{
+	gStorage->reset();
+	clock_gettime(CLOCK_MONOTONIC, &gBegin);
+}
+
+// 측정 결과를 한 줄로 출력한다.
+// 지연 시간을 실제로 대기하지 않으면 계산된 저장 장치의 시간을 더한다.
+static void end(const char *name, double amount, const char *unit)
+{
+	struct timespec now;
+	double usec;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	usec = (now.tv_sec - gBegin.tv_sec) * 1e6 + (now.tv_nsec - gBegin.tv_nsec) / 1e3;
+	if(!gRealFlag)
+		usec += gStorage->count.deviceUsec;
+
+	printf("%-8s %10.2f %10.2f %-6s %8llu %8llu %8llu %8llu\n", name, usec / 1000, amount / usec * 1e6, unit,
+		(unsigned long long)gStorage->count.readCommand, (unsigned long long)gStorage->count.readBlock,
+		(unsigned long long)gStorage->count.writeCommand, (unsigned long long)gStorage->count.writeBlock);
+}
+
+static bool fail(const char *test, const char *message, error_t result = error_t::ERROR_NONE)
+{
+	printf("%-8s failed : %s (error %d)\n", test, message, (int)result);
+	return false;
+}
+
+static bool testWrite(void)
+{
+	std::vector<uint8_t> buffer(gChunkSize);
+	File file(gFs);
+	error_t result;
+	uint32_t size;
+
+	begin();
+	result = file.open("/seq.bin", File::WRITE_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail("write", "open", result);
+
+	for(uint32_t position = 0; position < gFileSize; position += size)
+	{
+		size = gFileSize - position < gChunkSize ? gFileSize - position : gChunkSize;
+		fillPattern(buffer.data(), position, size, 0);
+		if(file.write(buffer.data(), size) != size)
+			return fail("write", "write");
+	}
+
+	result = file.close();
+	if(result != error_t::ERROR_NONE)
+		return fail("write", "close", result);
+	end("write", gFileSize / 1048576.0, "MB/s");
+
+	return true;
+}
+
+static bool testRead(void)
+{
+	std::vector<uint8_t> buffer(gChunkSize);
+	File file(gFs);
+	error_t result;
+	uint32_t size;
+
+	begin();
+	result = file.open("/seq.bin", File::READ_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail("read", "open /seq.bin (run write first)", result);
+
+	if(file.getSize() != gFileSize)
+		return fail("read", "file size");
+
+	for(uint32_t position = 0; position < gFileSize; position += size)
+	{
+		size = gFileSize - position < gChunkSize ? gFileSize - position : gChunkSize;
+		if(file.read(buffer.data(), size) != size)
+			return fail("read", "read");
+
+		if(!checkPattern(buffer.data(), position, size, 0))
+			return fail("read", "data mismatch");
+	}
+
+	file.close();
+	end("read", gFileSize / 1048576.0, "MB/s");
+
+	return true;
+}
+
+static bool testSeek(void)
+{
+	const uint32_t count = 2000, size = 32;
+	uint8_t buffer[size];
+	uint32_t position;
+	File file(gFs);
+	error_t result;
+
+	begin();
+	result = file.open("/seq.bin", File::READ_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail("seek", "open /seq.bin (run write first)", result);
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		position = getRandom(file.getSize() - size);
+		result = file.moveTo(position);
+		if(result != error_t::ERROR_NONE)
+			return fail("seek", "moveTo", result);
+
+		if(file.read(buffer, size) != size || !checkPattern(buffer, position, size, 0))
+			return fail("seek", "data mismatch");
+	}
+
+	file.close();
+	end("seek", count, "ops/s");
+
+	return true;
+}
+
+// 기록 장치처럼 작은 단위로 덧붙이며 클러스터를 계속 할당한다.
+static bool testAppend(const char *name, bool reserveFlag)
+{
+	const uint32_t size = 64;
+	uint8_t buffer[size];
+	char path[32];
+	File file(gFs);
+	error_t result;
+
+	snprintf(path, sizeof(path), "/%s.log", name);
+
+	begin();
+	result = file.open(path, File::WRITE_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail(name, "open", result);
+
+	if(reserveFlag)
+	{
+		result = file.reserve(gFileSize);
+		if(result != error_t::ERROR_NONE)
+			return fail(name, "reserve", result);
+	}
+
+	for(uint32_t position = 0; position < gFileSize; position += size)
+	{
+		fillPattern(buffer, position, size, 1);
+		if(file.write(buffer, size) != size)
+			return fail(name, "write");
+	}
+
+	result = file.close();
+	if(result != error_t::ERROR_NONE)
+		return fail(name, "close", result);
+	end(name, gFileSize / 1048576.0, "MB/s");
+
+	return true;
+}
+
+// 설정 파일을 읽으며 로그 파일에 쓰기를 번갈아 한다.
+// 두 파일을 닫지 않고 동시에 열어 두며 중간에 디렉토리도 탐색한다.
+static bool testMulti(void)
+{
+	const uint32_t size = 700;
+	uint8_t buffer[size];
+	File config(gFs), log(gFs), other(gFs);
+	error_t result;
+	uint32_t count = 0;
+
+	result = config.open("/multi.cfg", File::WRITE_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail("multi", "create /multi.cfg", result);
+
+	for(uint32_t position = 0; position < gFileSize; position += size)
+	{
+		fillPattern(buffer, position, size, 2);
+		config.write(buffer, gFileSize - position < size ? gFileSize - position : size);
+	}
+	config.close();
+
+	begin();
+	result = config.open("/multi.cfg", File::READ_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail("multi", "open /multi.cfg", result);
+
+	result = log.open("/multi.csv", File::WRITE_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail("multi", "open /multi.csv", result);
+
+	// 열려 있는 파일은 다시 열 수 없음
+	if(other.open("/multi.cfg", File::READ_ONLY) != error_t::ALREADY_OPENED)
+		return fail("multi", "same file opened twice");
+
+	for(uint32_t position = 0; position < gFileSize; position += count)
+	{
+		count = gFileSize - position < size ? gFileSize - position : size;
+		if(config.read(buffer, count) != count || !checkPattern(buffer, position, count, 2))
+			return fail("multi", "read /multi.cfg");
+
+		fillPattern(buffer, position, count, 3);
+		if(log.write(buffer, count) != count)
+			return fail("multi", "write /multi.csv");
+
+		// 파일이 열려 있어도 디렉토리를 탐색할 수 있음
+		if(position % (size * 256) == 0)
+		{
+			gFs->lock();
+			result = gFs->moveToRootDirectory();
+			if(result == error_t::ERROR_NONE)
+				result = gFs->moveToName("seq.bin");
+			gFs->unlock();
+			if(result != error_t::ERROR_NONE && result != error_t::NOT_EXIST_NAME)
+				return fail("multi", "browse", result);
+		}
+	}
+
+	config.close();
+	result = log.close();
+	if(result != error_t::ERROR_NONE)
+		return fail("multi", "close", result);
+	end("multi", gFileSize * 2 / 1048576.0, "MB/s");
+
+	result = log.open("/multi.csv", File::READ_ONLY);
+	if(result != error_t::ERROR_NONE || log.getSize() != gFileSize)
+		return fail("multi", "reopen /multi.csv", result);
+
+	for(uint32_t position = 0; position < gFileSize; position += count)
+	{
+		count = gFileSize - position < size ? gFileSize - position : size;
+		if(log.read(buffer, count) != count || !checkPattern(buffer, position, count, 3))
+			return fail("multi", "verify /multi.csv");
+	}
+
+	return true;
+}
+
+static bool testLookup(void)
+{
+	uint8_t buffer[16];
+	char path[64];
+	File file(gFs);
+	error_t result;
+	uint32_t index;
+
+	gFs->moveToRootDirectory();
+	if(gFs->moveToName("lookup") != error_t::ERROR_NONE)
+	{
+		result = gFs->makeDirectory("lookup");
+		if(result != error_t::ERROR_NONE)
+			return fail("lookup", "makeDirectory", result);
+	}
+
+	begin();
+	for(uint32_t i = 0; i < gNumOfLookup; i++)
+	{
+		snprintf(path, sizeof(path), "/lookup/file%04u.txt", i);
+		fillPattern(buffer, 0, sizeof(buffer), i);
+
+		result = file.open(path, File::WRITE_ONLY);
+		if(result != error_t::ERROR_NONE)
+			return fail("create", "open", result);
+
+		file.write(buffer, sizeof(buffer));
+		result = file.close();
+		if(result != error_t::ERROR_NONE)
+			return fail("create", "close", result);
+	}
+	end("create", gNumOfLookup, "ops/s");
+
+	begin();
+	for(uint32_t i = 0; i < gNumOfLookup; i++)
+	{
+		index = getRandom(gNumOfLookup);
+		snprintf(path, sizeof(path), "/lookup/FILE%04u.TXT", index);
+
+		result = file.open(path, File::READ_ONLY);
+		if(result != error_t::ERROR_NONE)
+			return fail("lookup", "open", result);
+
+		if(file.getSize() != sizeof(buffer) || file.read(buffer, sizeof(buffer)) != sizeof(buffer) || !checkPattern(buffer, 0, sizeof(buffer), index))
+			return fail("lookup", "data mismatch");
+
+		file.close();
+	}
+	end("lookup", gNumOfLookup, "ops/s");
+
+	return true;
+}
+
+// 한 디렉토리의 파일들을 Directory로 임의의 순서로 읽으며 그 사이에 다른 파일에 쓰고 경로로 파일을 연다.
+// 파일을 열고 쓰며 옮겨진 탐색 위치와 상관없이 모든 이름이 한 번씩 나와야 한다.
+static bool testBrowse(void)
+{
+	const uint32_t size = 64;
+	uint8_t buffer[size];
+	char path[64], name[64];
+	bool *found;
+	Directory dir(gFs);
+	File log(gFs), file(gFs);
+	error_t result;
+	uint32_t count, index;
+
+	gFs->lock();
+	gFs->moveToRootDirectory();
+	result = gFs->moveToName("browse");
+	if(result != error_t::ERROR_NONE)
+		result = gFs->makeDirectory("browse");
+	gFs->unlock();
+	if(result != error_t::ERROR_NONE)
+		return fail("browse", "makeDirectory", result);
+
+	for(uint32_t i = 0; i < gNumOfLookup; i++)
+	{
+		snprintf(path, sizeof(path), "/browse/item%04u.txt", i);
+		fillPattern(buffer, 0, size, i);
+
+		result = file.open(path, File::WRITE_ONLY);
+		if(result != error_t::ERROR_NONE)
+			return fail("browse", "create", result);
+
+		file.write(buffer, size);
+		file.close();
+	}
+
+	result = dir.initialize();
+	if(result == error_t::ERROR_NONE)
+		result = dir.enterDirectory("browse");
+	if(result != error_t::ERROR_NONE)
+		return fail("browse", "enterDirectory", result);
+
+	count = dir.getFileCount();
+	if(count != gNumOfLookup)
+		return fail("browse", "file count");
+
+	// 열려 있는 파일이 있으면 다시 마운트할 수 없음
+	result = log.open("/browse.csv", File::WRITE_ONLY);
+	if(result != error_t::ERROR_NONE)
+		return fail("browse", "open /browse.csv", result);
+
+	if(dir.initialize() != error_t::BUSY)
+		return fail("browse", "initialize while a file is open");
+
+	found = new bool[count];
+	memset(found, 0, count);
+
+	begin();
+	for(uint32_t i = 0; i < count; i++)
+	{
+		// 앞에서부터 반씩 번갈아 읽어 순서대로, 거꾸로 이동하는 경우를 모두 만듦
+		index = i % 2 ? count - 1 - i / 2 : i / 2;
+
+		result = dir.getFileName(index, name, sizeof(name));
+		if(result != error_t::ERROR_NONE)
+		{
+			delete[] found;
+			return fail("browse", "getFileName", result);
+		}
+
+		if(sscanf(name, "item%u.txt", &index) != 1 || index >= count || found[index])
+		{
+			fprintf(stderr, "browse : unexpected name \"%s\"\n", name);
+			delete[] found;
+			return fail("browse", "name");
+		}
+		found[index] = true;
+
+		fillPattern(buffer, i * size, size, 4);
+		if(log.write(buffer, size) != size)
+		{
+			delete[] found;
+			return fail("browse", "write /browse.csv");
+		}
+
+		if(i % 8 == 0)
+		{
+			snprintf(path, sizeof(path), "/browse/item%04u.txt", getRandom(count));
+			result = file.open(path, File::READ_ONLY);
+			if(result != error_t::ERROR_NONE)
+			{
+				delete[] found;
+				return fail("browse", "open", result);
+			}
+			file.close();
+		}
+	}
+	end("browse", count, "ops/s");
+	delete[] found;
+
+	result = log.close();
+	if(result != error_t::ERROR_NONE)
+		return fail("browse", "close", result);
+
+	result = log.open("/browse.csv", File::READ_ONLY);
+	if(result != error_t::ERROR_NONE || log.getSize() != count * size)
+		return fail("browse", "reopen /browse.csv", result);
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		if(log.read(buffer, size) != size || !checkPattern(buffer, i * size, size, 4))
+			return fail("browse", "verify /browse.csv");
+	}
+
+	return true;
+}
+
+// 이미지를 만들 때 둔 시작 클러스터가 0인 빈 파일들에 WRITE_ONLY로 쓰기, APPEND_LOG로 덧붙이기, reserve() 후 쓰기를 한다.
+// 첫 클러스터를 할당하여 디렉토리 엔트리에 저장해야 하며 데이터 영역 앞의 섹터나 FAT의 예약된 항목을 건드리면 이미지 검사에서 드러난다.
+static bool testEmpty(void)
+{
+	const uint32_t size = 3000;
+	const char *path[] = {"/EMPTY.BIN", "/EMPTY.LOG", "/EMPTY.RES"};
+	const uint8_t mode[] = {File::WRITE_ONLY, File::APPEND_LOG, File::WRITE_ONLY};
+	static uint8_t buffer[size];
+	File file(gFs);
+	error_t result;
+
+	begin();
+	for(uint32_t i = 0; i < 3; i++)
+	{
+		result = file.open(path[i], File::READ_ONLY);
+		if(result != error_t::ERROR_NONE)
+			return fail("empty", "open", result);
+
+		// 이미지를 새로 만들었으면 클러스터가 없으므로 읽을 데이터가 없음
+		if(file.getSize() == 0 && file.read(buffer, size) != 0)
+			return fail("empty", "read before write");
+		file.close();
+
+		result = file.open(path[i], mode[i]);
+		if(result != error_t::ERROR_NONE)
+			return fail("empty", "open for write", result);
+
+		if(i == 2)
+		{
+			result = file.reserve(size * 4);
+			if(result != error_t::ERROR_NONE)
+				return fail("empty", "reserve", result);
+		}
+
+		// 처음 기록은 섹터 단위보다 작게 하여 버퍼를 거치는 경로와 바로 쓰는 경로를 모두 사용
+		fillPattern(buffer, 0, size, 5 + i);
+		if(file.write(buffer, 100) != 100 || file.write(&buffer[100], size - 100) != size - 100)
+			return fail("empty", "write");
+
+		result = file.close();
+		if(result != error_t::ERROR_NONE)
+			return fail("empty", "close", result);
+	}
+	end("empty", 3, "ops/s");
+
+	for(uint32_t i = 0; i < 3; i++)
+	{
+		result = file.open(path[i], File::READ_ONLY);
+		if(result != error_t::ERROR_NONE || file.getSize() != size)
+		{
+			fprintf(stderr, "empty : %s is %u bytes instead of %u\n", path[i], file.getSize(), size);
+			return fail("empty", "reopen", result);
+		}
+
+		memset(buffer, 0, size);
+		if(file.read(buffer, size) != size || !checkPattern(buffer, 0, size, 5 + i))
+			return fail("empty", "verify");
+		file.close();
+	}
+
+	return true;
+}
+
+// 파일의 목록으로 VirtualMassStorage의 드라이브를 만들고 다른 Fat32로 마운트하여 파일을 읽는다.
+// 새 파일과 빈 파일에 쓴 내용이 RAM의 덮어쓴 블록으로 남아 다시 마운트해도 읽히는지,
+// 드라이브 전체가 이미지 검사를 통과하는지, discard() 후에는 처음의 이미지로 돌아가는지 확인한다.
+static bool testVirtual(void)
+{
+	typedef mod::sdram::VirtualMassStorage VirtualMassStorage;
+	const uint32_t dataSize = 100000, newSize = 70000, numOfBlock = 80000;
+	static const char readme[] = "yss virtual mass storage\r\n";
+	static uint8_t data[dataSize], buffer[newSize];
+	static const VirtualMassStorage::Entry entry[] =
+	{
+		{"README.TXT", readme, sizeof(readme) - 1},
+		{"DATA.BIN", data, dataSize},
+		{"EMPTY.TXT", 0, 0},
+	};
+	VirtualMassStorage::Config config = {entry, 3, numOfBlock, 1, 1024};
+	VirtualMassStorage storage;
+	std::vector<uint8_t> img;
+	error_t result;
+
+	// 예약 영역과 두 FAT, 65525개의 클러스터가 들어가지 않는 크기는 거부
+	for(uint32_t size : {97u, 1124u, 66644u})
+	{
+		config.numOfBlock = size;
+		if(storage.initialize(config) != error_t::WRONG_SIZE)
+		{
+			fprintf(stderr, "virtual : %u blocks accepted\n", size);
+			return fail("virtual", "minimum size");
+		}
+	}
+	config.numOfBlock = numOfBlock;
+
+	fillPattern(data, 0, dataSize, 6);
+	result = storage.initialize(config);
+	if(result != error_t::ERROR_NONE)
+		return fail("virtual", "initialize", result);
+
+	begin();
+	for(uint32_t pass = 0; pass < 2; pass++)
+	{
+		Fat32 fs(storage);
+		File file(fs);
+
+		result = fs.initialize();
+		if(result != error_t::ERROR_NONE)
+			return fail("virtual", "mount", result);
+
+		result = file.open("/README.TXT", File::READ_ONLY);
+		if(result != error_t::ERROR_NONE || file.getSize() != sizeof(readme) - 1)
+			return fail("virtual", "open /README.TXT", result);
+		if(file.read(buffer, sizeof(readme) - 1) != sizeof(readme) - 1 || memcmp(buffer, readme, sizeof(readme) - 1))
+			return fail("virtual", "verify /README.TXT");
+		file.close();
+
+		result = file.open("/DATA.BIN", File::READ_ONLY);
+		if(result != error_t::ERROR_NONE || file.getSize() != dataSize)
+			return fail("virtual", "open /DATA.BIN", result);
+		for(uint32_t position = 0; position < dataSize; position += newSize)
+		{
+			uint32_t count = dataSize - position < newSize ? dataSize - position : newSize;
+			if(file.read(buffer, count) != count || !checkPattern(buffer, position, count, 6))
+				return fail("virtual", "verify /DATA.BIN");
+		}
+		file.close();
+
+		// 처음에는 새 파일과 빈 파일에 쓰고, 다시 마운트한 뒤에는 쓴 내용을 확인
+		for(const char *path : {"/new.bin", "/EMPTY.TXT"})
+		{
+			uint32_t seed = path[1] == 'n' ? 7 : 8;
+
+			if(pass == 0)
+			{
+				fillPattern(buffer, 0, newSize, seed);
+				result = file.open(path, File::WRITE_ONLY);
+				if(result != error_t::ERROR_NONE)
+					return fail("virtual", "create", result);
+				if(file.write(buffer, 1000) != 1000 || file.write(&buffer[1000], newSize - 1000) != newSize - 1000)
+					return fail("virtual", "write");
+				result = file.close();
+				if(result != error_t::ERROR_NONE)
+					return fail("virtual", "close", result);
+			}
+			else
+			{
+				result = file.open(path, File::READ_ONLY);
+				if(result != error_t::ERROR_NONE || file.getSize() != newSize)
+					return fail("virtual", "reopen", result);
+				if(file.read(buffer, newSize) != newSize || !checkPattern(buffer, 0, newSize, seed))
+					return fail("virtual", "verify written file");
+				file.close();
+			}
+		}
+	}
+	end("virtual", (dataSize * 2 + newSize * 4) / 1048576.0, "MB/s");
+
+	// 덮어쓴 블록을 포함한 드라이브 전체를 검사
+	img.resize((uint64_t)numOfBlock * 512);
+	result = storage.readBlocks(0, numOfBlock, img.data());
+	if(result != error_t::ERROR_NONE)
+		return fail("virtual", "read image", result);
+
+	ImageChecker checker(img.data(), img.size());
+	if(checker.check() || checker.file.size() != 4)
+		return fail("virtual", "image check");
+
+	// 쓴 블록을 버리면 새 파일이 없어지고 빈 파일도 처음으로 돌아감
+	if(storage.getOverlayCount() == 0)
+		return fail("virtual", "no overlay");
+	storage.discard();
+	{
+		Fat32 fs(storage);
+		File file(fs);
+
+		result = fs.initialize();
+		if(result != error_t::ERROR_NONE)
+			return fail("virtual", "remount", result);
+
+		if(file.open("/new.bin", File::READ_ONLY) != error_t::NOT_EXIST_NAME)
+			return fail("virtual", "discarded file still exists");
+
+		result = file.open("/EMPTY.TXT", File::READ_ONLY);
+		if(result != error_t::ERROR_NONE || file.getSize() != 0)
+			return fail("virtual", "discarded write still visible", result);
+	}
+
+	return true;
+}
+
+// 0 바이트가 없고 줄바꿈으로 끝나는 64 바이트 기록을 만든다.
+static void makeRecord(char *des, uint32_t index)
+{
+	char number[12];
+
+	snprintf(number, sizeof(number), "%010u,", index);
+	memset(des, 'a' + index % 26, 63);
+	memcpy(des, number, 11);
+	des[63] = '\n';
+}
+
+// 다른 Fat32로 로그를 기록하다가 파일을 닫지 않고 캐시의 블록도 버려 전원이 꺼진 상황을 만든다.
+// 다시 마운트하여 APPEND_LOG로 열었을 때 마지막으로 저장된 크기 이후의 기록까지 복구되는지 확인하고 나머지를 덧붙인다.
+static bool testLog(void)
+{
+	const uint32_t size = 64, count = gFileSize / size;
+	static uint8_t memory[sizeof(File)];
+	char buffer[size], record[size];
+	Fat32 writer(*gDevice);
+	File *file, reader(gFs);
+	uint32_t recovered;
+	error_t result;
+
+	result = writer.initialize();
+	if(result != error_t::ERROR_NONE)
+		return fail("log", "mount", result);
+
+	// 전원이 꺼진 것처럼 소멸자에서 닫히지 않도록 정적 메모리에 만들고 소멸시키지 않음
+	file = new(memory) File(writer);
+
+	begin();
+	result = file->open("/log.csv", File::APPEND_LOG);
+	if(result != error_t::ERROR_NONE)
+		return fail("log", "open", result);
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		makeRecord(record, i);
+		if(file->write(record, size) != size)
+			return fail("log", "write");
+	}
+	end("log", gFileSize / 1048576.0, "MB/s");
+
+	if(gCache)
+		gCache->invalidate();
+
+	result = gFs->initialize();
+	if(result != error_t::ERROR_NONE)
+		return fail("log", "remount", result);
+
+	begin();
+	result = reader.open("/log.csv", File::APPEND_LOG);
+	if(result != error_t::ERROR_NONE)
+		return fail("log", "recover", result);
+	end("recover", 1, "ops/s");
+
+	// 저장된 크기 뒤에 섹터 단위로 쓰인 기록까지 찾아야 함
+	recovered = reader.getSize();
+	if(recovered % size || recovered > gFileSize || recovered + FILE_LOG_SYNC_SIZE + 512 < gFileSize)
+	{
+		fprintf(stderr, "log : recovered %u of %u bytes\n", recovered, gFileSize);
+		return fail("log", "recovered size");
+	}
+
+	for(uint32_t i = recovered / size; i < count; i++)
+	{
+		makeRecord(record, i);
+		if(reader.write(record, size) != size)
+			return fail("log", "append");
+	}
+
+	result = reader.close();
+	if(result != error_t::ERROR_NONE)
+		return fail("log", "close", result);
+
+	result = reader.open("/log.csv", File::READ_ONLY);
+	if(result != error_t::ERROR_NONE || reader.getSize() != gFileSize)
+		return fail("log", "reopen", result);
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		makeRecord(record, i);
+		if(reader.read(buffer, size) != size || memcmp(buffer, record, size))
+			return fail("log", "verify");
+	}
+	reader.close();
+
+	// 섹터의 일부만 남기고 닫기를 반복해도 버퍼에 남아 있던 이전 데이터가 파일의 끝 뒤에 쓰이지 않아야 함
+	const uint32_t round = 3, length = 600;
+	static char text[round * length];
+
+	for(uint32_t i = 0; i < round; i++)
+	{
+		result = reader.open("/relog.csv", File::APPEND_LOG);
+		if(result != error_t::ERROR_NONE || reader.getSize() != i * length)
+		{
+			fprintf(stderr, "log : reopened at %u bytes instead of %u\n", reader.getSize(), i * length);
+			return fail("log", "reopen /relog.csv", result);
+		}
+
+		memset(&text[i * length], 'A' + i, length);
+		if(reader.write(&text[i * length], length / 2) != length / 2)
+			return fail("log", "write /relog.csv");
+
+		// 중간에 sync()로도 일부만 채운 섹터를 저장
+		result = reader.sync();
+		if(result != error_t::ERROR_NONE)
+			return fail("log", "sync /relog.csv", result);
+
+		if(reader.write(&text[i * length + length / 2], length / 2) != length / 2)
+			return fail("log", "write /relog.csv");
+
+		result = reader.close();
+		if(result != error_t::ERROR_NONE)
+			return fail("log", "close /relog.csv", result);
+	}
+
+	result = reader.open("/relog.csv", File::READ_ONLY);
+	if(result != error_t::ERROR_NONE || reader.getSize() != sizeof(text))
+		return fail("log", "open /relog.csv", result);
+
+	for(uint32_t position = 0; position < sizeof(text); position += size)
+	{
+		uint32_t count = sizeof(text) - position < size ? sizeof(text) - position : size;
+		if(reader.read(buffer, count) != count || memcmp(buffer, &text[position], count))
+			return fail("log", "verify /relog.csv");
+	}
+
+	return true;
+}
+
+static void printUsage(void)
+{
+	fprintf(stderr, "usage : fatbench [-i file] [-u] [-s MB] [-c sectors] [-F clusters] [-S KB] [-b bytes] [-n count] [-l us,us] [-r] [-C sets,ways[,blocks]] [-k] [-v] [test ...]\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = "fatbench.img";
+	const char *testName[] = {"write", "read", "seek", "append", "reserve", "multi", "lookup", "browse", "empty", "virtual", "log"};
+	std::vector<const char*> select;
+	uint64_t size = 512 * 1048576ull;
+	uint32_t sectorPerCluster = 8, hole = 0, cacheSet = 0, cacheWay = 0, readAhead = 0;
+	double commandUsec = 0, blockUsec = 0;
+	bool useFlag = false, fsckFlag = false, verboseFlag = false, failFlag = false;
+	struct stat info;
+	uint8_t *img;
+	int fd;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(argv[i][0] != '-')
+		{
+			select.push_back(argv[i]);
+			continue;
+		}
+
+		switch(argv[i][1])
+		{
+		case 'u' :
+			useFlag = true;
+			continue;
+		case 'r' :
+			gRealFlag = true;
+			continue;
+		case 'k' :
+			fsckFlag = true;
+			continue;
+		case 'v' :
+			verboseFlag = true;
+			continue;
+		}
+
+		if(i + 1 >= argc)
+		{
+			printUsage();
+			return 1;
+		}
+
+		switch(argv[i][1])
+		{
+		case 'i' :
+			path = argv[++i];
+			break;
+		case 's' :
+			size = strtoull(argv[++i], 0, 0) * 1048576;
+			break;
+		case 'c' :
+			sectorPerCluster = atoi(argv[++i]);
+			break;
+		case 'F' :
+			hole = atoi(argv[++i]);
+			break;
+		case 'S' :
+			gFileSize = atoi(argv[++i]) * 1024;
+			break;
+		case 'b' :
+			gChunkSize = atoi(argv[++i]);
+			break;
+		case 'n' :
+			gNumOfLookup = atoi(argv[++i]);
+			break;
+		case 'l' :
+			if(sscanf(argv[++i], "%lf,%lf", &commandUsec, &blockUsec) < 1)
+			{
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'C' :
+			if(sscanf(argv[++i], "%u,%u,%u", &cacheSet, &cacheWay, &readAhead) < 2 || cacheSet == 0 || cacheSet > 65535 || cacheWay == 0 || cacheWay > 255 || readAhead > 255)
+			{
+				printUsage();
+				return 1;
+			}
+			break;
+		default :
+			printUsage();
+			return 1;
+		}
+	}
+
+	if(sectorPerCluster == 0 || (sectorPerCluster & (sectorPerCluster - 1)) || sectorPerCluster > 128 || gChunkSize == 0 || gFileSize < 64 || gNumOfLookup == 0)
+	{
+		printUsage();
+		return 1;
+	}
+
+	for(const char *name : select)
+	{
+		bool found = false;
+
+		for(const char *test : testName)
+			found |= strcmp(name, test) == 0;
+		if(!found)
+		{
+			fprintf(stderr, "error : unknown test \"%s\"\n", name);
+			return 1;
+		}
+	}
+
+	// 이미지 파일을 만들거나 열어서 메모리에 연결
+	fd = open(path, useFlag ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0)
+	{
+		fprintf(stderr, "error : can't open \"%s\"\n", path);
+		return 1;
+	}
+
+	if(useFlag)
+	{
+		fstat(fd, &info);
+		size = info.st_size;
+	}
+	else if(ftruncate(fd, size))
+	{
+		fprintf(stderr, "error : can't resize \"%s\"\n", path);
+		return 1;
+	}
+
+	img = (uint8_t*)mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(img == MAP_FAILED)
+	{
+		fprintf(stderr, "error : can't map \"%s\"\n", path);
+		return 1;
+	}
+
+	if(!useFlag)
+	{
+		uint32_t numOfCluster = formatImage(img, size, sectorPerCluster, hole);
+		if(numOfCluster == 0)
+		{
+			fprintf(stderr, "error : can't format %llu bytes\n", (unsigned long long)size);
+			return 1;
+		}
+
+		printf("image : %s, %llu MB, %u clusters of %u bytes", path, (unsigned long long)(size / 1048576), numOfCluster, sectorPerCluster * 512);
+		if(hole)
+			printf(", 1 of every %u clusters used", hole + 1);
+		if(numOfCluster < 65525)
+			printf(" (fsck.fat expects at least 65525 clusters)");
+		printf("\n");
+	}
+
+	ImageStorage storage(img, size / 512);
+	BlockCache cache;
+	error_t result;
+
+	storage.setLatency(commandUsec, blockUsec, gRealFlag);
+	if(cacheSet)
+	{
+		result = cache.initialize(&storage, cacheSet, cacheWay);
+		if(result == error_t::ERROR_NONE)
+			result = cache.setReadAhead(readAhead);
+		if(result != error_t::ERROR_NONE)
+		{
+			fprintf(stderr, "error : can't initialize the cache (error %d)\n", (int)result);
+			return 1;
+		}
+
+		printf("cache : %u sets x %u ways of 512 bytes, read ahead %u blocks\n", cacheSet, cacheWay, readAhead);
+	}
+
+	Fat32 fs(cacheSet ? (MassStorage&)cache : (MassStorage&)storage);
+
+	gStorage = &storage;
+	gCache = cacheSet ? &cache : 0;
+	gDevice = cacheSet ? (MassStorage*)&cache : (MassStorage*)&storage;
+	gFs = &fs;
+
+	result = fs.initialize();
+	if(result != error_t::ERROR_NONE)
+	{
+		fprintf(stderr, "error : can't mount \"%s\" (error %d)\n", path, (int)result);
+		return 1;
+	}
+
+	printf("%-8s %10s %10s %-6s %8s %8s %8s %8s\n", "test", "ms", "rate", "", "rd cmd", "rd blk", "wr cmd", "wr blk");
+
+	for(const char *name : testName)
+	{
+		bool found = select.empty();
+
+		for(const char *test : select)
+			found |= strcmp(name, test) == 0;
+		if(!found)
+			continue;
+
+		if(!strcmp(name, "write"))
+			failFlag |= !testWrite();
+		else if(!strcmp(name, "read"))
+			failFlag |= !testRead();
+		else if(!strcmp(name, "seek"))
+			failFlag |= !testSeek();
+		else if(!strcmp(name, "append"))
+			failFlag |= !testAppend("append", false);
+		else if(!strcmp(name, "reserve"))
+			failFlag |= !testAppend("reserve", true);
+		else if(!strcmp(name, "multi"))
+			failFlag |= !testMulti();
+		else if(!strcmp(name, "lookup"))
+			failFlag |= !testLookup();
+		else if(!strcmp(name, "browse"))
+			failFlag |= !testBrowse();
+		else if(!strcmp(name, "empty"))
+			failFlag |= !testEmpty();
+		else if(!strcmp(name, "virtual"))
+			failFlag |= !testVirtual();
+		else if(!strcmp(name, "log"))
+			failFlag |= !testLog();
+	}
+
+	fs.sync();
+	msync(img, size, MS_SYNC);
+
+	if(cacheSet)
+		printf("cache : %u hits, %u misses\n", cache.getHitCount(), cache.getMissCount());
+
+	// 이미지 검사
+	ImageChecker checker(img, size);
+	checker.check();
+
+	for(const ImageChecker::FileInfo &info : checker.file)
+	{
+		if(verboseFlag || (strchr(&info.path[1], '/') == 0 && strcmp(info.path, "/JUNK.BIN")))
+			printf("file  : %-24s %10u bytes %6u extents\n", info.path, info.size, info.extents);
+	}
+
+	printf("check : %zu files, %u directories, %u free clusters, %u errors\n", checker.file.size(), checker.numOfDirectory, checker.getFreeCount(), checker.error);
+	if(checker.error)
+		failFlag = true;
+
+	munmap(img, size);
+	close(fd);
+
+	if(fsckFlag)
+	{
+		char command[512];
+		int status;
+
+		snprintf(command, sizeof(command), "fsck.fat -n \"%s\"", path);
+		status = system(command);
+
+		if(status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) == 127)
+		{
+			fprintf(stderr, "error : can't run fsck.fat\n");
+			failFlag = true;
+		}
+		else if(WEXITSTATUS(status))
+		{
+			printf("fsck.fat reported errors (exit code %d)\n", WEXITSTATUS(status));
+			failFlag = true;
+		}
+	}
+
+	return failFlag ? 1 : 0;
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+// fatbench를 리눅스에서 빌드할 때 사용하는 설정 파일 입니다.
+// 파일 시스템 계층만 빌드하므로 GUI와 운영체제 관련 기능은 사용하지 않습니다.
+// FAT32_FAT_CACHE_COUNT 등의 캐시 크기는 -D 옵션으로 바꿔서 비교할 수 있습니다.
+
+#ifndef FATBENCH_HOST_CONFIG__H_
+#define FATBENCH_HOST_CONFIG__H_
+
+#define YSS_L_HEAP_USE		false
+#define USE_GUI				false
+#define USE_EVENT			false
+
+#endif
+
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+// fatbench를 리눅스에서 빌드할 때 yss/thread.h를 대신하는 파일 입니다.
+// 벤치마크는 하나의 쓰레드에서 실행되므로 쓰레드 전환 보호는 아무 동작도 하지 않습니다.
+
+#ifndef YSS_THREAD__H_
+#define YSS_THREAD__H_
+
+#include <yss/Mutex.h>
+
+namespace thread
+{
+	inline void protect(void)
+	{
+	}
+
+	inline void unprotect(void)
+	{
+	}
+
+	inline void yield(void)
+	{
+	}
+}
+
+#endif
+
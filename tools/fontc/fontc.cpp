@@ -0,0 +1,702 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+// yss OS의 PackedFont용 글꼴 데이터를 생성하는 리눅스용 명령행 글꼴 컴파일러 입니다.
+// BDF 또는 TTF/OTF 글꼴에서 지정한 문자만 골라 A4/A2/A1 형식으로 변환하고,
+// 선택적으로 RLE 압축을 적용한 뒤 utf8Code 순으로 정렬된 테이블과 검색용 인덱스를 C++ 소스로 출력합니다.
+//
+// This is a Linux command-line font compiler that generates font data for the yss OS PackedFont class.
+//
+// 빌드 (Build)
+//		g++ -O2 -o fontc fontc.cpp $(pkg-config --cflags --libs freetype2)
+//		g++ -O2 -DFONTC_NO_FREETYPE -o fontc fontc.cpp		(BDF만 지원)
+//
+// 사용법 (Usage)
+//		fontc [options] <font.bdf | font.ttf>
+//		-o <file>		출력 파일 (기본값 : stdout)
+//		-n <name>		생성할 packedFontInfo_t 변수의 이름 (기본값 : font)
+//		-s <pixel>		TTF/OTF 글꼴의 픽셀 크기 (기본값 : 16)
+//		-r <ranges>		포함할 유니코드 범위 (예 : 0x20-0x7E,0xAC00-0xD7A3)
+//		-t <file>		파일에 포함된 UTF-8 문자만 포함
+//		-f <a4|a2|a1>	점당 농도 단계 (기본값 : a4)
+//		-c				RLE 압축 적용
+//		-i <shift>		인덱스 구간의 크기를 2^shift로 설정 (기본값 : 자동)
+//
+// 변환이 끝나면 stderr로 A4 비압축 대비 절약된 플래시 용량과 호스트에서 측정한 글자 디코딩 속도를 출력합니다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#if !defined(FONTC_NO_FREETYPE)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+enum
+{
+	DATA_FORMAT_A4 = 0,
+	DATA_FORMAT_A2,
+	DATA_FORMAT_A1,
+	DATA_FORMAT_RLE,
+};
+
+struct Glyph
+{
+	uint32_t code;		// 유니코드 값
+	uint32_t utf8Code;	// Font::getUtf8()이 반환하는 형태의 UTF-8 코드
+	int width, height, xpos, ypos;
+	std::vector<uint8_t> level;	// 한 점당 0 ~ 255의 농도
+	std::vector<uint8_t> data;	// 변환된 데이터
+};
+
+static uint32_t convertToUtf8Code(uint32_t code)
+{
+	if(code < 0x80)
+		return code;
+	else if(code < 0x800)
+		return (0xC0 | (code >> 6)) << 8 | (0x80 | (code & 0x3F));
+	else
+		return (0xE0 | (code >> 12)) << 16 | (0x80 | ((code >> 6) & 0x3F)) << 8 | (0x80 | (code & 0x3F));
+}
+
+static int getStride(int width, int format)
+{
+	switch(format)
+	{
+	case DATA_FORMAT_A2 :
+		return (width + 3) & ~0x03;
+	case DATA_FORMAT_A1 :
+		return (width + 7) & ~0x07;
+	default :
+		return (width + 1) & ~0x01;
+	}
+}
+
+static bool parseRanges(const char *str, std::set<uint32_t> &codes)
+{
+	std::string text = str;
+	size_t start = 0;
+
+	while(start < text.size())
+	{
+		size_t end = text.find(',', start);
+		if(end == std::string::npos)
+			end = text.size();
+
+		std::string item = text.substr(start, end - start);
+		size_t dash = item.find('-');
+		char *tail;
+		uint32_t from, to;
+
+		from = strtoul(item.c_str(), &tail, 0);
+		if(dash != std::string::npos)
+			to = strtoul(item.c_str() + dash + 1, &tail, 0);
+		else
+			to = from;
+
+		if(*tail != 0 || to < from || to > 0xFFFF)
+			return false;
+
+		for(uint32_t i = from; i <= to; i++)
+			codes.insert(i);
+
+		start = end + 1;
+	}
+
+	return true;
+}
+
+static bool readTextFile(const char *path, std::set<uint32_t> &codes)
+{
+	FILE *fp = fopen(path, "rb");
+	int c;
+
+	if(fp == 0)
+		return false;
+
+	while((c = fgetc(fp)) != EOF)
+	{
+		uint32_t code;
+
+		if(c < 0x80)
+			code = c;
+		else if(c >= 0xE0)
+		{
+			code = (c & 0x0F) << 12;
+			code |= (fgetc(fp) & 0x3F) << 6;
+			code |= fgetc(fp) & 0x3F;
+		}
+		else if(c >= 0xC0)
+		{
+			code = (c & 0x1F) << 6;
+			code |= fgetc(fp) & 0x3F;
+		}
+		else
+			continue;
+
+		if(code >= 0x20)
+			codes.insert(code);
+	}
+
+	fclose(fp);
+	return true;
+}
+
+static bool loadBdf(const char *path, const std::set<uint32_t> &codes, std::vector<Glyph> &glyphs, int &size)
+{
+	FILE *fp = fopen(path, "r");
+	char line[1024];
+	int ascent = 0, descent = 0, encoding = -1;
+	int bbxWidth = 0, bbxHeight = 0, bbxX = 0, bbxY = 0;
+	bool inBitmap = false;
+	Glyph glyph;
+	int row = 0;
+
+	if(fp == 0)
+		return false;
+
+	while(fgets(line, sizeof(line), fp))
+	{
+		if(inBitmap)
+		{
+			if(strncmp(line, "ENDCHAR", 7) == 0)
+			{
+				inBitmap = false;
+				if(encoding >= 0 && codes.count(encoding))
+					glyphs.push_back(glyph);
+				continue;
+			}
+
+			if(row < glyph.height)
+			{
+				for(int x = 0; x < glyph.width; x++)
+				{
+					char hex[2] = {line[x / 4], 0};
+					uint8_t bits = strtoul(hex, 0, 16);
+
+					if(bits & (0x08 >> (x & 3)))
+						glyph.level[row * glyph.width + x] = 0xFF;
+				}
+				row++;
+			}
+		}
+		else if(strncmp(line, "FONT_ASCENT ", 12) == 0)
+			ascent = atoi(line + 12);
+		else if(strncmp(line, "FONT_DESCENT ", 13) == 0)
+			descent = atoi(line + 13);
+		else if(strncmp(line, "ENCODING ", 9) == 0)
+			encoding = atoi(line + 9);
+		else if(strncmp(line, "BBX ", 4) == 0)
+			sscanf(line + 4, "%d %d %d %d", &bbxWidth, &bbxHeight, &bbxX, &bbxY);
+		else if(strncmp(line, "BITMAP", 6) == 0)
+		{
+			glyph.code = encoding;
+			glyph.utf8Code = convertToUtf8Code(encoding);
+			glyph.width = bbxWidth;
+			glyph.height = bbxHeight;
+			glyph.xpos = bbxX < 0 ? 0 : bbxX;
+			glyph.ypos = ascent - (bbxHeight + bbxY);
+			glyph.level.assign(bbxWidth * bbxHeight, 0);
+			row = 0;
+			inBitmap = true;
+		}
+	}
+
+	fclose(fp);
+	size = ascent + descent;
+	return true;
+}
+
+#if !defined(FONTC_NO_FREETYPE)
+static bool loadFreeType(const char *path, int pixelSize, const std::set<uint32_t> &codes, std::vector<Glyph> &glyphs, int &size)
+{
+	FT_Library library;
+	FT_Face face;
+	int ascent;
+
+	if(FT_Init_FreeType(&library))
+		return false;
+
+	if(FT_New_Face(library, path, 0, &face))
+	{
+		FT_Done_FreeType(library);
+		return false;
+	}
+
+	FT_Set_Pixel_Sizes(face, 0, pixelSize);
+	ascent = face->size->metrics.ascender >> 6;
+	size = (face->size->metrics.ascender - face->size->metrics.descender) >> 6;
+
+	for(std::set<uint32_t>::const_iterator it = codes.begin(); it != codes.end(); it++)
+	{
+		FT_UInt index = FT_Get_Char_Index(face, *it);
+		Glyph glyph;
+
+		if(index == 0 || FT_Load_Glyph(face, index, FT_LOAD_RENDER))
+			continue;
+
+		FT_Bitmap &bitmap = face->glyph->bitmap;
+
+		glyph.code = *it;
+		glyph.utf8Code = convertToUtf8Code(*it);
+		glyph.width = bitmap.width;
+		glyph.height = bitmap.rows;
+		glyph.xpos = face->glyph->bitmap_left < 0 ? 0 : face->glyph->bitmap_left;
+		glyph.ypos = ascent - face->glyph->bitmap_top;
+		glyph.level.assign(glyph.width * glyph.height, 0);
+
+		for(int y = 0; y < glyph.height; y++)
+		{
+			for(int x = 0; x < glyph.width; x++)
+			{
+				if(bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+					glyph.level[y * glyph.width + x] = (bitmap.buffer[y * bitmap.pitch + x / 8] & (0x80 >> (x & 7))) ? 0xFF : 0;
+				else
+					glyph.level[y * glyph.width + x] = bitmap.buffer[y * bitmap.pitch + x];
+			}
+		}
+
+		glyphs.push_back(glyph);
+	}
+
+	FT_Done_Face(face);
+	FT_Done_FreeType(library);
+	return true;
+}
+#endif
+
+// 0 ~ 255의 농도를 설정된 형식의 단계로 줄인 후 0 ~ 15 단계로 반환한다.
+static uint8_t quantize(uint8_t level, int bpp)
+{
+	switch(bpp)
+	{
+	case 2 :
+		return ((level * 3 + 127) / 255) * 5;
+	case 1 :
+		return level >= 0x80 ? 15 : 0;
+	default :
+		return (level * 15 + 127) / 255;
+	}
+}
+
+// 지정된 위치부터 농도 0 또는 15가 이어지는 점의 수를 얻는다.
+static size_t getRun(const std::vector<uint8_t> &level, size_t pos)
+{
+	size_t run = 0;
+
+	if(level[pos] != 0 && level[pos] != 15)
+		return 0;
+
+	while(pos + run < level.size() && level[pos + run] == level[pos])
+		run++;
+
+	return run;
+}
+
+static void encode(Glyph &glyph, int bpp, bool rle)
+{
+	int format = rle ? DATA_FORMAT_RLE : (bpp == 4 ? DATA_FORMAT_A4 : bpp == 2 ? DATA_FORMAT_A2 : DATA_FORMAT_A1);
+	int stride = getStride(glyph.width, format);
+	std::vector<uint8_t> level;
+
+	for(int y = 0; y < glyph.height; y++)
+	{
+		for(int x = 0; x < stride; x++)
+			level.push_back(x < glyph.width ? quantize(glyph.level[y * glyph.width + x], bpp) : 0);
+	}
+
+	glyph.data.clear();
+
+	if(rle)
+	{
+		size_t i = 0, run, count;
+
+		while(i < level.size())
+		{
+			run = getRun(level, i);
+
+			if(run >= 3 || (run && i + run == level.size()))
+			{
+				if(run > 64)
+					run = 64;
+
+				glyph.data.push_back((level[i] ? 0x40 : 0x00) | (run - 1));
+				i += run;
+				continue;
+			}
+
+			// 농도 0 또는 15가 3점 이상 이어지기 전까지는 농도를 그대로 저장한다.
+			count = 0;
+			while(i + count < level.size() && count < 128)
+			{
+				if(getRun(level, i + count) >= 3)
+					break;
+				count++;
+			}
+
+			glyph.data.push_back(0x80 | (count - 1));
+			for(size_t j = 0; j < count; j += 2)
+			{
+				uint8_t buf = level[i + j];
+				if(j + 1 < count)
+					buf |= level[i + j + 1] << 4;
+				glyph.data.push_back(buf);
+			}
+			i += count;
+		}
+	}
+	else
+	{
+		int bits = 0;
+		uint8_t buf = 0;
+
+		for(size_t i = 0; i < level.size(); i++)
+		{
+			buf |= (level[i] * ((1 << bpp) - 1) / 15) << bits;
+			bits += bpp;
+
+			if(bits == 8)
+			{
+				glyph.data.push_back(buf);
+				buf = 0;
+				bits = 0;
+			}
+		}
+
+		if(bits)
+			glyph.data.push_back(buf);
+	}
+}
+
+// Font::Decoder와 동일한 방식으로 데이터를 풀어내 디코딩 속도를 측정한다.
+static uint32_t decode(const std::vector<uint8_t> &data, int format, uint32_t count)
+{
+	const uint8_t *src = data.data();
+	uint32_t sum = 0;
+	uint8_t buffer = 0, remain = 0, level = 0;
+	bool odd = false;
+	uint8_t bits = format == DATA_FORMAT_A2 ? 2 : format == DATA_FORMAT_A1 ? 1 : 4;
+	uint8_t mask = (1 << bits) - 1, scale = format == DATA_FORMAT_A2 ? 5 : format == DATA_FORMAT_A1 ? 15 : 1;
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		if(format == DATA_FORMAT_RLE)
+		{
+			if(remain == 0)
+			{
+				uint8_t token = *src++;
+
+				if(token & 0x80)
+				{
+					remain = (token & 0x7F) + 1;
+					level = 0xFF;
+					odd = false;
+				}
+				else
+				{
+					remain = (token & 0x3F) + 1;
+					level = (token & 0x40) ? 15 : 0;
+				}
+			}
+			remain--;
+
+			if(level != 0xFF)
+				sum += level;
+			else if(odd)
+			{
+				sum += buffer >> 4;
+				odd = false;
+			}
+			else
+			{
+				buffer = *src++;
+				sum += buffer & 0x0F;
+				odd = true;
+			}
+		}
+		else
+		{
+			if(remain == 0)
+			{
+				buffer = *src++;
+				remain = 8;
+			}
+			sum += (buffer & mask) * scale;
+			buffer >>= bits;
+			remain -= bits;
+		}
+	}
+
+	return sum;
+}
+
+static void printUsage(void)
+{
+	fprintf(stderr,
+		"usage : fontc [options] <font.bdf | font.ttf>\n"
+		"  -o <file>      output file (default : stdout)\n"
+		"  -n <name>      variable name (default : font)\n"
+		"  -s <pixel>     pixel size for TTF/OTF (default : 16)\n"
+		"  -r <ranges>    unicode ranges (ex : 0x20-0x7E,0xAC00-0xD7A3)\n"
+		"  -t <file>      include the characters used in a UTF-8 text file\n"
+		"  -f <a4|a2|a1>  level depth (default : a4)\n"
+		"  -c             RLE compression\n"
+		"  -i <shift>     index group size is 2^shift (default : auto)\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *outPath = 0, *name = "font", *inPath = 0;
+	int pixelSize = 16, bpp = 4, indexShift = -1, size = 0, format;
+	bool rle = false;
+	std::set<uint32_t> codes;
+	std::vector<Glyph> glyphs;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(argv[i][0] != '-')
+		{
+			inPath = argv[i];
+			continue;
+		}
+
+		if(argv[i][1] == 'c')
+		{
+			rle = true;
+			continue;
+		}
+
+		if(i + 1 >= argc)
+		{
+			printUsage();
+			return 1;
+		}
+
+		switch(argv[i][1])
+		{
+		case 'o' :
+			outPath = argv[++i];
+			break;
+		case 'n' :
+			name = argv[++i];
+			break;
+		case 's' :
+			pixelSize = atoi(argv[++i]);
+			break;
+		case 'r' :
+			if(!parseRanges(argv[++i], codes))
+			{
+				fprintf(stderr, "error : wrong range \"%s\"\n", argv[i]);
+				return 1;
+			}
+			break;
+		case 't' :
+			if(!readTextFile(argv[++i], codes))
+			{
+				fprintf(stderr, "error : can't open \"%s\"\n", argv[i]);
+				return 1;
+			}
+			break;
+		case 'f' :
+			i++;
+			if(strcmp(argv[i], "a4") == 0)
+				bpp = 4;
+			else if(strcmp(argv[i], "a2") == 0)
+				bpp = 2;
+			else if(strcmp(argv[i], "a1") == 0)
+				bpp = 1;
+			else
+			{
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'i' :
+			indexShift = atoi(argv[++i]);
+			break;
+		default :
+			printUsage();
+			return 1;
+		}
+	}
+
+	if(inPath == 0)
+	{
+		printUsage();
+		return 1;
+	}
+
+	// 범위가 지정되지 않으면 ASCII 문자를 기본으로 사용한다.
+	if(codes.empty())
+		parseRanges("0x21-0x7E", codes);
+	codes.erase(' ');	// 공백은 Font::mSpaceWidth로 처리된다.
+
+	size_t length = strlen(inPath);
+	bool loaded;
+
+	if(length > 4 && strcasecmp(inPath + length - 4, ".bdf") == 0)
+		loaded = loadBdf(inPath, codes, glyphs, size);
+	else
+	{
+#if !defined(FONTC_NO_FREETYPE)
+		loaded = loadFreeType(inPath, pixelSize, codes, glyphs, size);
+#else
+		// FreeType 없이 빌드하면 TTF/OTF를 -s 크기로 래스터화할 수 없음
+		fprintf(stderr, "error : built without FreeType, can't rasterize \"%s\" at %d px (BDF only)\n", inPath, pixelSize);
+		return 1;
+#endif
+	}
+
+	if(!loaded || glyphs.empty())
+	{
+		fprintf(stderr, "error : can't load glyphs from \"%s\"\n", inPath);
+		return 1;
+	}
+
+	// glyph 정보 유효성 검사 (fontInfo_t의 각 항목은 8비트)
+	for(size_t i = 0; i < glyphs.size(); i++)
+	{
+		Glyph &glyph = glyphs[i];
+		if(glyph.width > 255 || glyph.height > 255 || glyph.xpos > 127 || glyph.ypos < -128 || glyph.ypos > 127)
+		{
+			fprintf(stderr, "error : glyph U+%04X is too big\n", glyph.code);
+			return 1;
+		}
+	}
+
+	// utf8Code 순으로 정렬 (유니코드 순서와 동일)
+	std::map<uint32_t, Glyph> sorted;
+	for(size_t i = 0; i < glyphs.size(); i++)
+		sorted[glyphs[i].utf8Code] = glyphs[i];
+	glyphs.clear();
+	for(std::map<uint32_t, Glyph>::iterator it = sorted.begin(); it != sorted.end(); it++)
+		glyphs.push_back(it->second);
+
+	format = rle ? DATA_FORMAT_RLE : (bpp == 4 ? DATA_FORMAT_A4 : bpp == 2 ? DATA_FORMAT_A2 : DATA_FORMAT_A1);
+
+	size_t rawSize = 0, dataSize = 0;
+	uint64_t numOfDot = 0;
+	for(size_t i = 0; i < glyphs.size(); i++)
+	{
+		rawSize += (getStride(glyphs[i].width, DATA_FORMAT_A4) * glyphs[i].height + 1) / 2;
+		encode(glyphs[i], bpp, rle);
+		dataSize += glyphs[i].data.size();
+		numOfDot += getStride(glyphs[i].width, format) * glyphs[i].height;
+	}
+
+	// 인덱스 구간 크기 결정 (자동일 경우 구간당 평균 8 문자 이하가 되는 가장 큰 구간)
+	uint32_t firstCode = glyphs.front().code, lastCode = glyphs.back().code;
+	if(indexShift < 0)
+	{
+		for(indexShift = 12; indexShift > 0; indexShift--)
+		{
+			uint32_t groups = ((lastCode - firstCode) >> indexShift) + 1;
+			if(glyphs.size() / groups <= 8)
+				break;
+		}
+	}
+
+	uint32_t numOfIndex = ((lastCode - firstCode) >> indexShift) + 1;
+	std::vector<uint16_t> index(numOfIndex + 1, 0);
+	size_t pos = 0;
+
+	if(glyphs.size() > 0xFFFF)
+	{
+		fprintf(stderr, "error : too many glyphs\n");
+		return 1;
+	}
+
+	for(uint32_t group = 0; group <= numOfIndex; group++)
+	{
+		while(pos < glyphs.size() && ((glyphs[pos].code - firstCode) >> indexShift) < group)
+			pos++;
+		index[group] = pos;
+	}
+
+	FILE *out = outPath ? fopen(outPath, "w") : stdout;
+	if(out == 0)
+	{
+		fprintf(stderr, "error : can't create \"%s\"\n", outPath);
+		return 1;
+	}
+
+	static const char *formatName[] = {"Font::DATA_FORMAT_A4", "Font::DATA_FORMAT_A2", "Font::DATA_FORMAT_A1", "Font::DATA_FORMAT_RLE"};
+
+	fprintf(out, "// fontc로 생성된 파일입니다. 직접 수정하지 마세요.\n");
+	fprintf(out, "// source : %s, glyphs : %u, format : %s\n\n", inPath, (uint32_t)glyphs.size(), formatName[format]);
+	fprintf(out, "#include <gui/PackedFont.h>\n\n");
+
+	for(size_t i = 0; i < glyphs.size(); i++)
+	{
+		fprintf(out, "static const uint8_t %s_%04X[%u] = {", name, glyphs[i].code, (uint32_t)glyphs[i].data.size());
+		for(size_t j = 0; j < glyphs[i].data.size(); j++)
+			fprintf(out, "%s0x%02X", j % 16 ? ", " : (j ? ",\n\t" : "\n\t"), glyphs[i].data[j]);
+		fprintf(out, "\n};\n\n");
+	}
+
+	fprintf(out, "static const Font::fontInfo_t %s_fontInfo[%u] =\n{\n", name, (uint32_t)glyphs.size());
+	for(size_t i = 0; i < glyphs.size(); i++)
+	{
+		Glyph &glyph = glyphs[i];
+		fprintf(out, "\t{0x%06X, %d, %d, %d, (uint8_t)%d, (uint8_t*)%s_%04X},\n", glyph.utf8Code, glyph.width, glyph.height, glyph.xpos, glyph.ypos, name, glyph.code);
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "static const uint16_t %s_index[%u] =\n{", name, numOfIndex + 1);
+	for(size_t i = 0; i < index.size(); i++)
+		fprintf(out, "%s%u", i % 16 ? ", " : (i ? ",\n\t" : "\n\t"), index[i]);
+	fprintf(out, "\n};\n\n");
+
+	fprintf(out, "extern const PackedFont::packedFontInfo_t %s;\n\n", name);
+	fprintf(out, "const PackedFont::packedFontInfo_t %s =\n{\n", name);
+	fprintf(out, "\t%d,\t\t\t\t\t// size\n", size);
+	fprintf(out, "\t%s,\t// dataFormat\n", formatName[format]);
+	fprintf(out, "\t%d,\t\t\t\t\t// indexShift\n", indexShift);
+	fprintf(out, "\t0,\t\t\t\t\t// reserved\n");
+	fprintf(out, "\t%u,\t\t\t\t// numOfChar\n", (uint32_t)glyphs.size());
+	fprintf(out, "\t0x%04X,\t\t\t\t// firstCode\n", firstCode);
+	fprintf(out, "\t%u,\t\t\t\t// numOfIndex\n", numOfIndex);
+	fprintf(out, "\t%s_index,\n", name);
+	fprintf(out, "\t%s_fontInfo\n", name);
+	fprintf(out, "};\n\n");
+
+	if(outPath)
+		fclose(out);
+
+	// 결과 보고
+	size_t tableSize = glyphs.size() * 12 + (numOfIndex + 1) * 2 + 24;
+	size_t totalSize = dataSize + tableSize;
+	size_t rawTotalSize = rawSize + glyphs.size() * 12 + 24;
+	clock_t begin = clock();
+	uint32_t repeat = 0, checksum = 0;
+
+	do
+	{
+		for(size_t i = 0; i < glyphs.size(); i++)
+			checksum += decode(glyphs[i].data, format, getStride(glyphs[i].width, format) * glyphs[i].height);
+		repeat++;
+	}while(clock() - begin < CLOCKS_PER_SEC / 2);
+
+	double sec = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+	fprintf(stderr, "glyphs         : %u\n", (uint32_t)glyphs.size());
+	fprintf(stderr, "index          : %u groups (2^%d)\n", numOfIndex, indexShift);
+	fprintf(stderr, "A4 raw         : %u bytes\n", (uint32_t)rawTotalSize);
+	fprintf(stderr, "output         : %u bytes (data %u, table %u)\n", (uint32_t)totalSize, (uint32_t)dataSize, (uint32_t)tableSize);
+	fprintf(stderr, "flash saved    : %d bytes (%.1f%%)\n", (int)(rawTotalSize - totalSize), 100.0 * ((double)rawTotalSize - totalSize) / rawTotalSize);
+	fprintf(stderr, "decode speed   : %.1f Mdot/s, %.0f glyph/s (host, checksum %08X)\n", numOfDot * repeat / sec / 1e6, glyphs.size() * repeat / sec, checksum);
+
+	return 0;
+}
+
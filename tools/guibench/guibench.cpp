@@ -0,0 +1,660 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+// yss OS의 GUI 그리기 계층(Brush, BrushRgb565, 글꼴, 비트맵, 알파 합성)을 하드웨어 없이 리눅스에서 실행하는 벤치마크 입니다.
+// 메모리 프레임 버퍼(Bmp565Buffer)에 버튼, 슬라이더, 라벨, 한글 문자열, 비트맵 장면을 그리고
+// 장면마다 한 화면을 그리는 시간, 위젯당 그리기 시간, 초당 그린 점의 수를 출력합니다.
+// 그린 화면은 PPM(P6) 이미지로 저장할 수 있으며, 저장해 둔 기준 이미지와 점 단위로 비교하여
+// 그리기 최적화 후에도 결과가 바뀌지 않았는지 확인할 수 있습니다.
+//
+// This is a Linux benchmark that renders the yss GUI Brush layer into memory and compares it against golden images.
+//
+// 빌드 (Build)
+//		Y=../../targets/M2xx/Source/yss
+//		g++ -O2 -I host -I $Y/inc -o guibench guibench.cpp $Y/src/gui/yss_{Brush,BrushRgb565,Bmp565Buffer,IndexBuffer,FrameBuffer,Color,Font,PackedFont,GlyphCache,TextLayout,Blit,Blend,Convert,Fill,BitmapDecoder,Palette}.cpp
+//
+//		문자 장면을 포함하려면 fontc로 만든 글꼴을 함께 빌드합니다.
+//		fontc -s 16 -r 0x20-0x7E,0xAC00-0xD7A3 -c -n benchFont -o font.cpp NanumGothic.ttf
+//		g++ ... -DGUIBENCH_FONT=benchFont font.cpp
+//
+// 사용법 (Usage)
+//		guibench [options] [scene ...]
+//		-s <width>x<height>	화면 크기 (기본값 : 320x240)
+//		-w <dir>			그린 화면을 <dir>/<scene>.ppm으로 저장
+//		-g <dir>			<dir>/<scene>.ppm 기준 이미지와 비교
+//		-t <level>			비교할 때 허용하는 색상 성분의 차이 (기본값 : 0)
+//
+// 장면 이름을 지정하지 않으면 모든 장면을 실행합니다.
+// 장면을 그리기 전에 변환 결과를 Color의 코드와 비교하는 검사를 먼저 실행합니다.
+// 기준 이미지와 다른 점이 있거나 검사가 실패하면 종료 코드 1을 반환합니다.
+
+#include <config.h>
+#include <gui/Bmp565Buffer.h>
+#include <gui/IndexBuffer.h>
+#include <gui/PackedFont.h>
+#include <gui/GlyphCache.h>
+#include <gui/TextLayout.h>
+#include <gui/BitmapDecoder.h>
+#include <gui/Blit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+// 호스트에는 yss_memsethw.s가 없으므로 같은 동작을 하는 함수로 대신함
+extern "C" void *memsethw(void *__s, int32_t __c, uint32_t __n)
+{
+	uint16_t *des = (uint16_t*)__s;
+
+	for(uint32_t i = 0; i < __n / 2; i++)
+		des[i] = (uint16_t)__c;
+
+	return __s;
+}
+
+extern "C" void *memsetw(void *__s, int32_t __c, uint32_t __n)
+{
+	uint32_t *des = (uint32_t*)__s;
+
+	for(uint32_t i = 0; i < __n / 4; i++)
+		des[i] = (uint32_t)__c;
+
+	return __s;
+}
+
+// yss_copyWordPattern.s, yss_copyRgb888DotPattern.s도 같은 동작을 하는 함수로 대신함
+extern "C" void copyWordPattern(void *des, uint32_t pattern0, uint32_t pattern1, uint32_t count)
+{
+	uint32_t *des32 = (uint32_t*)des;
+
+	for(uint32_t i = 0; i < count; i++)
+		des32[i] = i & 1 ? pattern1 : pattern0;
+}
+
+extern "C" void copyRgb888DotPattern(void *des, uint32_t pattern, uint32_t count)
+{
+	uint8_t *des8 = (uint8_t*)des;
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		*des8++ = pattern;
+		*des8++ = pattern >> 8;
+		*des8++ = pattern >> 16;
+	}
+}
+
+#ifdef GUIBENCH_FONT
+extern const PackedFont::packedFontInfo_t GUIBENCH_FONT;
+static PackedFont gPackedFont(&GUIBENCH_FONT);
+static Font *gFont = &gPackedFont;
+#else
+static Font *gFont = 0;
+#endif
+
+static Size_t gScreen = {320, 240};
+static uint32_t gSeed;
+
+static uint32_t getRandom(uint32_t max)
+{
+	gSeed = gSeed * 1103515245 + 12345;
+	return (gSeed >> 16) % max;
+}
+
+static Position_t randomPos(Size_t size)
+{
+	return Position_t{(int16_t)getRandom(gScreen.width - size.width + 1), (int16_t)getRandom(gScreen.height - size.height + 1)};
+}
+
+// 장면에서 사용하는 64x64 RGB565 비트맵과 같은 그림의 INDEX8 비트맵
+static std::vector<uint8_t> gRawData, gIndexData;
+static Bitmap_t gRawBitmap, gIndexBitmap;
+
+static void makeBitmaps(void)
+{
+	const uint16_t size = 64;
+	uint16_t palette[16];
+
+	for(int i = 0; i < 16; i++)
+		palette[i] = Color(i * 17, 255 - i * 12, (i & 0x03) * 80).getRgb565Code();
+
+	gRawData.resize(size * size * 2);
+	gIndexData.resize(1 + 16 * 2 + size * size);
+	gIndexData[0] = 16 - 1;
+	memcpy(&gIndexData[1], palette, sizeof(palette));
+
+	for(int y = 0; y < size; y++)
+	{
+		for(int x = 0; x < size; x++)
+		{
+			int dx = x - size / 2, dy = y - size / 2;
+			uint8_t index = ((dx * dx + dy * dy) / 64 + (x / 16)) & 0x0F;
+
+			memcpy(&gRawData[(y * size + x) * 2], &palette[index], 2);
+			gIndexData[1 + 16 * 2 + y * size + x] = index;
+		}
+	}
+
+	gRawBitmap = Bitmap_t{size, size, BitmapDecoder::TYPE_RGB565, gRawData.data()};
+	gIndexBitmap = Bitmap_t{size, size, BitmapDecoder::TYPE_INDEX8, gIndexData.data()};
+}
+
+// 장면을 그리는 함수들
+// 그린 점의 수를 반환한다. 같은 장면은 항상 같은 화면을 그린다.
+static uint32_t drawFill(Brush &brush)
+{
+	uint32_t dots = 0;
+
+	for(int i = 0; i < 64; i++)
+	{
+		Size_t size = {(uint16_t)(getRandom(gScreen.width) + 1), (uint16_t)(getRandom(gScreen.height) + 1)};
+
+		brush.setBrushColor(getRandom(256), getRandom(256), getRandom(256));
+		brush.fillRect(randomPos(size), size);
+		dots += size.width * size.height;
+	}
+
+	return dots;
+}
+
+static uint32_t drawButton(Brush &brush)
+{
+	const char *label[] = {"OK", "Cancel", "Menu", "Start", "Stop", "Setup"};
+	Size_t size = {96, 40}, text;
+	Position_t pos;
+	uint32_t dots = 0;
+
+	for(int i = 0; i < 12; i++)
+	{
+		pos = Position_t{(int16_t)(8 + (i % 3) * 104), (int16_t)(8 + (i / 3) * 56)};
+
+		brush.setBrushColor(0x40 + i * 8, 0x60, 0xC0 - i * 8);
+		brush.fillRect(pos, size);
+		brush.setBrushColor(0xFF, 0xFF, 0xFF);
+		brush.drawRect(pos, size);
+		dots += size.width * size.height;
+
+		if(gFont)
+		{
+			brush.setBackgroundColor(0x40 + i * 8, 0x60, 0xC0 - i * 8);
+			text = brush.calculateStringSize(label[i % 6]);
+			brush.drawString(Position_t{(int16_t)(pos.x + (size.width - text.width) / 2), (int16_t)(pos.y + (size.height - text.height) / 2)}, label[i % 6]);
+		}
+	}
+
+	return dots;
+}
+
+static uint32_t drawSlider(Brush &brush)
+{
+	Size_t size = {(uint16_t)(gScreen.width - 40), 8};
+	Position_t pos;
+	uint16_t value;
+	uint32_t dots = 0;
+
+	for(int i = 0; i < 6; i++)
+	{
+		pos = Position_t{20, (int16_t)(20 + i * 36)};
+		value = getRandom(size.width);
+
+		brush.setBrushColor(0x30, 0x30, 0x30);
+		brush.fillRect(pos, size);
+		brush.setBrushColor(0x20, 0xA0, 0xFF);
+		brush.fillRect(pos, Size_t{value, size.height});
+		brush.setBrushColor(0xF0, 0xF0, 0xF0);
+		brush.fillCircle(Position_t{(int16_t)(pos.x + value), (int16_t)(pos.y + size.height / 2)}, 10);
+		dots += size.width * size.height + 314;
+	}
+
+	return dots;
+}
+
+static uint32_t drawStrings(Brush &brush, const char **str, int num)
+{
+	Size_t size;
+	Position_t pos = {4, 4};
+	uint32_t dots = 0;
+
+	for(int i = 0; i < num; i++)
+	{
+		size = brush.calculateStringSize(str[i]);
+		brush.drawString(pos, str[i]);
+		dots += size.width * size.height;
+		pos.y += size.height + 4;
+	}
+
+	return dots;
+}
+
+static uint32_t drawLabel(Brush &brush)
+{
+	const char *str[] =
+	{
+		"The quick brown fox jumps",
+		"over the lazy dog 0123456789",
+		"Temperature : 23.5 C",
+		"Voltage : 3.30 V  Current : 0.12 A",
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+		"abcdefghijklmnopqrstuvwxyz",
+	};
+
+	return drawStrings(brush, str, sizeof(str) / sizeof(str[0]));
+}
+
+static uint32_t drawKorean(Brush &brush)
+{
+	const char *str[] =
+	{
+		"다람쥐 헌 쳇바퀴에 타고파",
+		"온도 : 23.5 도, 습도 : 40 %",
+		"설정 메뉴로 이동합니다",
+		"키스의 고유조건은 입술끼리",
+		"만나야 하고 특별한 기술은 필요치 않다",
+	};
+
+	return drawStrings(brush, str, sizeof(str) / sizeof(str[0]));
+}
+
+static uint32_t drawBitmap(Brush &brush)
+{
+	uint32_t dots = 0;
+
+	for(int y = 0; y + 64 <= gScreen.height; y += 64)
+	{
+		for(int x = 0; x + 64 <= gScreen.width; x += 64)
+		{
+			brush.drawBitmap(Position_t{(int16_t)x, (int16_t)y}, ((x + y) / 64) & 0x01 ? gIndexBitmap : gRawBitmap);
+			dots += 64 * 64;
+		}
+	}
+
+	return dots;
+}
+
+static uint32_t drawBlend(Brush &brush)
+{
+	uint32_t dots = drawBitmap(brush);
+
+	for(int i = 0; i < 8; i++)
+	{
+		Size_t size = {(uint16_t)(getRandom(gScreen.width / 2) + 1), (uint16_t)(getRandom(gScreen.height / 2) + 1)};
+
+		brush.blendRect(randomPos(size), size, Color(getRandom(256), getRandom(256), getRandom(256)), getRandom(256));
+		dots += size.width * size.height;
+	}
+
+	return dots;
+}
+
+// 검사 함수들
+// 실패한 항목의 수를 반환한다.
+
+// RGB888 점을 16비트 프레임 버퍼 형식으로 변환한 결과가 Color의 코드와 같은지
+// Color의 R, B 순서와 바이트 순서 설정 네 가지 모두에서 확인한다.
+static uint32_t checkBlit(void)
+{
+	const uint8_t dot[][3] = {{0x12, 0x9A, 0xE7}, {0xFF, 0x00, 0x80}, {0x08, 0xFC, 0x31}, {0xC0, 0x44, 0x0F}};	// B, G, R
+	uint16_t rgb565, argb1555, code;
+	uint32_t error = 0;
+	Color color;
+
+	for(int i = 0; i < 4; i++)
+	{
+		color.setReverseRgbOrder(i & 0x01);
+		color.setLittleEndian(i & 0x02);
+
+		for(const uint8_t *src : dot)
+		{
+			color.setColor(src[2], src[1], src[0]);
+			rgb565 = color.getRgb565Code();
+			argb1555 = color.getArgb1555Code();
+
+			blit::convertLine(&code, FrameBuffer::COLOR_MODE_RGB565, src, BitmapDecoder::TYPE_RGB888, 1);
+			error += code != rgb565;
+			blit::convertLineWithColorKey(&code, FrameBuffer::COLOR_MODE_RGB565, src, BitmapDecoder::TYPE_RGB888, 1, 0);
+			error += code != rgb565;
+			error += blit::convertDot(FrameBuffer::COLOR_MODE_RGB565, src, BitmapDecoder::TYPE_RGB888) != rgb565;
+
+			blit::convertLine(&code, FrameBuffer::COLOR_MODE_ARGB1555, src, BitmapDecoder::TYPE_RGB888, 1);
+			error += code != argb1555;
+			error += blit::convertDot(FrameBuffer::COLOR_MODE_ARGB1555, src, BitmapDecoder::TYPE_RGB888) != argb1555;
+
+			// 16비트 형식 사이의 변환도 같은 형식으로 읽고 씀
+			blit::convertLine(&code, FrameBuffer::COLOR_MODE_ARGB1555, &rgb565, BitmapDecoder::TYPE_RGB565, 1);
+			error += code != argb1555;
+			error += blit::convertDot(FrameBuffer::COLOR_MODE_RGB565, &rgb565, BitmapDecoder::TYPE_RGB565) != rgb565;
+			error += blit::convertDot(FrameBuffer::COLOR_MODE_ARGB1555, &argb1555, BitmapDecoder::TYPE_ARGB1555) != argb1555;
+		}
+	}
+
+	color.setReverseRgbOrder(false);
+	color.setLittleEndian(false);
+
+	if(error)
+		printf("check blit : %u errors\n", error);
+
+	return error;
+}
+
+// 팔레트 방식(IndexBuffer)에서 비트맵과 합성된 문자가 가장 가까운 팔레트 번호로 그려지는지 확인한다.
+static uint32_t checkIndex(void)
+{
+	const uint16_t size = 64;
+	IndexBuffer buffer(size * size, FrameBuffer::COLOR_MODE_INDEX4);
+	Palette *palette = buffer.getPalette();
+	std::vector<uint8_t> plain(size * size);
+	uint32_t error = 0;
+
+	buffer.setSize(size, size);
+
+	// 비트맵의 색상표를 거꾸로 설정하여 팔레트 번호가 바뀌어 그려지는지 확인
+	for(int i = 0; i < 16; i++)
+		palette->setColor(15 - i, Color(i * 17, 255 - i * 12, (i & 0x03) * 80));
+
+	buffer.drawBitmap(Position_t{0, 0}, gIndexBitmap);
+	for(int i = 0; i < size * size; i++)
+		error += buffer.getDot(i % size, i / size) != 15 - gIndexData[1 + 16 * 2 + i];
+
+	buffer.clear();
+	buffer.drawBitmap(Position_t{0, 0}, gRawBitmap);
+	for(int i = 0; i < size * size; i++)
+		error += buffer.getDot(i % size, i / size) != 15 - gIndexData[1 + 16 * 2 + i];
+
+	if(gFont)
+	{
+		Color black(0, 0, 0), white(255, 255, 255);
+
+		// 배경색과 글자색 사이의 16단계를 색상표로 설정
+		for(int i = 0; i < 16; i++)
+			palette->setColor(i, white.calculateFontColorLevel(black, i));
+
+		buffer.setFont(*gFont);
+		buffer.setBackgroundColor(black);
+		buffer.setFontColor(white);
+
+		// 배경 위에 합성한 문자는 배경색으로 그린 문자와 같음
+		buffer.clear();
+		buffer.drawString(Position_t{2, 2}, "Ag8");
+		for(int i = 0; i < size * size; i++)
+			plain[i] = buffer.getDot(i % size, i / size);
+
+		buffer.enableFontBlending(true);
+		buffer.clear();
+		buffer.drawString(Position_t{2, 2}, "Ag8");
+		for(int i = 0; i < size * size; i++)
+			error += buffer.getDot(i % size, i / size) != plain[i];
+
+		// 글자색으로 채운 곳에 합성한 문자는 모든 점이 글자색
+		buffer.setBrushColor(white);
+		buffer.fill();
+		buffer.drawString(Position_t{2, 2}, "Ag8");
+		for(int i = 0; i < size * size; i++)
+			error += buffer.getDot(i % size, i / size) != 15;
+	}
+
+	if(error)
+		printf("check index : %u errors\n", error);
+
+	return error;
+}
+
+struct Check
+{
+	const char *name;
+	uint32_t (*run)(void);
+};
+
+static const Check gCheck[] =
+{
+	{"blit", checkBlit},
+	{"index", checkIndex},
+};
+
+struct Scene
+{
+	const char *name;
+	uint16_t numOfWidget;
+	bool textFlag;
+	uint32_t (*draw)(Brush &brush);
+};
+
+static const Scene gScene[] =
+{
+	{"fill", 64, false, drawFill},
+	{"button", 12, false, drawButton},
+	{"slider", 6, false, drawSlider},
+	{"label", 6, true, drawLabel},
+	{"korean", 5, true, drawKorean},
+	{"bitmap", 0, false, drawBitmap},
+	{"blend", 8, false, drawBlend},
+};
+
+static uint32_t drawScene(Bmp565Buffer &brush, const Scene &scene)
+{
+	gSeed = 1;
+	brush.setBackgroundColor(0x10, 0x10, 0x18);
+	brush.setFontColor(0xFF, 0xFF, 0xFF);
+	brush.clear();
+
+	return scene.draw(brush);
+}
+
+static bool writePpm(const char *path, Bmp565Buffer &brush)
+{
+	FILE *file = fopen(path, "wb");
+	uint16_t *dot = (uint16_t*)brush.getFrameBuffer();
+	uint8_t red, green, blue, alpha;
+	Color color;
+
+	if(file == 0)
+		return false;
+
+	fprintf(file, "P6\n%d %d\n255\n", gScreen.width, gScreen.height);
+	for(uint32_t i = 0; i < (uint32_t)gScreen.width * gScreen.height; i++)
+	{
+		color.setColorCodeRgb565(dot[i]);
+		color.getColor(red, green, blue, alpha);
+		fputc(red, file);
+		fputc(green, file);
+		fputc(blue, file);
+	}
+
+	fclose(file);
+	return true;
+}
+
+static bool readPpm(const char *path, std::vector<uint8_t> &rgb)
+{
+	FILE *file = fopen(path, "rb");
+	int width, height, max;
+
+	if(file == 0)
+		return false;
+
+	if(fscanf(file, "P6 %d %d %d", &width, &height, &max) != 3 || width != gScreen.width || height != gScreen.height || max != 255)
+	{
+		fclose(file);
+		return false;
+	}
+
+	fgetc(file);
+	rgb.resize(width * height * 3);
+	if(fread(rgb.data(), 1, rgb.size(), file) != rgb.size())
+		rgb.clear();
+
+	fclose(file);
+	return !rgb.empty();
+}
+
+// 기준 이미지와 허용 범위를 넘게 다른 점의 수를 얻는다.
+static uint32_t compare(Bmp565Buffer &brush, const std::vector<uint8_t> &golden, uint8_t tolerance)
+{
+	uint16_t *dot = (uint16_t*)brush.getFrameBuffer();
+	uint8_t rgb[4];
+	uint32_t diff = 0;
+	Color color;
+
+	for(uint32_t i = 0; i < (uint32_t)gScreen.width * gScreen.height; i++)
+	{
+		color.setColorCodeRgb565(dot[i]);
+		color.getColor(rgb[0], rgb[1], rgb[2], rgb[3]);
+
+		for(int j = 0; j < 3; j++)
+		{
+			if(abs(rgb[j] - golden[i * 3 + j]) > tolerance)
+			{
+				diff++;
+				break;
+			}
+		}
+	}
+
+	return diff;
+}
+
+static void printUsage(void)
+{
+	fprintf(stderr, "usage : guibench [-s widthxheight] [-w dir] [-g dir] [-t level] [scene ...]\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *writeDir = 0, *goldenDir = 0;
+	std::vector<const char*> select;
+	uint8_t tolerance = 0;
+	int width, height;
+	bool failFlag = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(argv[i][0] != '-')
+		{
+			select.push_back(argv[i]);
+			continue;
+		}
+
+		if(i + 1 >= argc)
+		{
+			printUsage();
+			return 1;
+		}
+
+		switch(argv[i][1])
+		{
+		case 's' :
+			if(sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width < 64 || height < 64)
+			{
+				printUsage();
+				return 1;
+			}
+			gScreen = Size_t{(uint16_t)width, (uint16_t)height};
+			break;
+		case 'w' :
+			writeDir = argv[++i];
+			break;
+		case 'g' :
+			goldenDir = argv[++i];
+			break;
+		case 't' :
+			tolerance = atoi(argv[++i]);
+			break;
+		default :
+			printUsage();
+			return 1;
+		}
+	}
+
+	Bmp565Buffer brush(gScreen.width * gScreen.height);
+	GlyphCache cache(16 * 1024, 128);
+	TextLayout layout(16, 48);
+	std::vector<uint8_t> golden;
+	char path[512];
+
+	brush.setSize(gScreen.width, gScreen.height);
+	if(gFont)
+	{
+		brush.setFont(*gFont);
+		brush.setGlyphCache(&cache);
+		brush.setTextLayout(&layout);
+	}
+	makeBitmaps();
+
+	// 검사에서 바꾼 Color의 설정과 기본 색상이 장면에 영향을 주지 않도록 장면보다 먼저 실행
+	for(const Check &check : gCheck)
+	{
+		if(check.run())
+		{
+			fprintf(stderr, "error : %s check failed\n", check.name);
+			failFlag = true;
+		}
+	}
+
+	printf("%-8s %8s %10s %10s %9s  %s\n", "scene", "widgets", "us/frame", "us/widget", "Mdot/s", "diff");
+
+	for(const Scene &scene : gScene)
+	{
+		bool found = select.empty();
+
+		for(const char *name : select)
+			found |= strcmp(name, scene.name) == 0;
+		if(!found)
+			continue;
+
+		if(scene.textFlag && gFont == 0)
+		{
+			printf("%-8s skipped (built without GUIBENCH_FONT)\n", scene.name);
+			continue;
+		}
+
+		// 비교와 저장은 처음 그린 화면으로 함
+		uint32_t dots = drawScene(brush, scene);
+		char diff[32] = "-";
+
+		if(goldenDir)
+		{
+			snprintf(path, sizeof(path), "%s/%s.ppm", goldenDir, scene.name);
+			if(readPpm(path, golden))
+			{
+				uint32_t count = compare(brush, golden, tolerance);
+				snprintf(diff, sizeof(diff), "%u", count);
+				if(count)
+					failFlag = true;
+			}
+			else
+				snprintf(diff, sizeof(diff), "no golden");
+		}
+
+		if(writeDir)
+		{
+			snprintf(path, sizeof(path), "%s/%s.ppm", writeDir, scene.name);
+			if(!writePpm(path, brush))
+			{
+				fprintf(stderr, "error : can't write \"%s\"\n", path);
+				return 1;
+			}
+		}
+
+		// 0.5초 이상 반복해서 그린 평균 시간을 측정
+		uint32_t frame = 0;
+		clock_t begin = clock();
+		do
+		{
+			drawScene(brush, scene);
+			frame++;
+		}while(clock() - begin < CLOCKS_PER_SEC / 2);
+		double usec = (double)(clock() - begin) * 1000000 / CLOCKS_PER_SEC / frame;
+
+		if(scene.numOfWidget)
+			printf("%-8s %8u %10.1f %10.2f %9.2f  %s\n", scene.name, scene.numOfWidget, usec, usec / scene.numOfWidget, dots / usec, diff);
+		else
+			printf("%-8s %8s %10.1f %10s %9.2f  %s\n", scene.name, "-", usec, "-", dots / usec, diff);
+	}
+
+	return failFlag ? 1 : 0;
+}
+
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2015 Yoon-Ki Hong
+ *
+ * This file is subject to the terms and conditions of the MIT License.
+ * See the file "LICENSE" in the main directory of this archive for more details.
+ */
+
+// guibench를 리눅스에서 빌드할 때 사용하는 설정 파일 입니다.
+// 메모리 프레임 버퍼를 사용하는 Brush 계층만 빌드하므로 GUI만 활성화하고 운영체제 관련 기능은 사용하지 않습니다.
+
+#ifndef GUIBENCH_HOST_CONFIG__H_
+#define GUIBENCH_HOST_CONFIG__H_
+
+#define YSS_L_HEAP_USE		false
+#define USE_GUI				true
+#define USE_EVENT			false
+
+#endif
+